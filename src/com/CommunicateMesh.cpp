@@ -9,7 +9,7 @@
 #include "mesh/Triangle.hpp"
 #include "utils/Globals.hpp"
 #include "utils/Dimensions.hpp"
-#include <map>
+#include <algorithm>
 #include <vector>
 
 namespace precice {
@@ -17,6 +17,16 @@ namespace com {
 
 tarch::logging::Log CommunicateMesh:: _log ( "precice::com::CommunicateMesh" );
 
+namespace {
+
+/// Returns the number of doubles in the payload described by header.
+int payloadSize ( const int* header, int dimensions )
+{
+  return header[0] * dimensions + header[1] * 2 + header[2] * 3;
+}
+
+}
+
 CommunicateMesh:: CommunicateMesh
 (
   com::Communication::SharedPointer communication )
@@ -29,61 +39,13 @@ void CommunicateMesh:: sendMesh
   const mesh::Mesh& mesh,
   int               rankReceiver )
 {
-  preciceTrace2 ( "sendGeometry()", mesh.getName(), rankReceiver );
-  using tarch::la::raw;
-  int dim = mesh.getDimensions();
-
-  int numberOfVertices = mesh.vertices().size();
-  _communication->send ( numberOfVertices, rankReceiver );
-  if(numberOfVertices>0){
-    double itemsToSend[numberOfVertices*dim];
-    for(int i=0;i<numberOfVertices;i++){
-      for(int d=0;d<dim;d++){
-        itemsToSend[i*dim+d] = mesh.vertices()[i].getCoords()[d];
-      }
-    }
-    _communication->send(itemsToSend,numberOfVertices*dim,rankReceiver);
-  }
-
-  int numberOfEdges = mesh.edges().size();
-  _communication->send ( numberOfEdges, rankReceiver );
-  if(numberOfEdges>0){
-    //we need to send the vertexIDs first such that the right edges can be created later
-    //contrary to the normal sendMesh, this variant must also work for adding delta meshes
-    int vertexIDs[numberOfVertices];
-    for(int i=0;i<numberOfVertices;i++){
-      vertexIDs[i] = mesh.vertices()[i].getID();
-    }
-    _communication->send(vertexIDs,numberOfVertices,rankReceiver);
-
-    int edgeIDs[numberOfEdges*2];
-    for(int i=0;i<numberOfEdges;i++){
-      edgeIDs[i*2] = mesh.edges()[i].vertex(0).getID();
-      edgeIDs[i*2+1] = mesh.edges()[i].vertex(1).getID();
-    }
-    _communication->send(edgeIDs,numberOfEdges*2,rankReceiver);
-  }
-
-  if ( dim == 3 ) {
-    int numberOfTriangles = mesh.triangles().size();
-    _communication->send ( numberOfTriangles, rankReceiver );
-    if(numberOfTriangles>0){
-      //we need to send the edgeIDs first such that the right edges can be created later
-      //contrary to the normal sendMesh, this variant must also work for adding delta meshes
-      int edgeIDs[numberOfEdges];
-      for(int i=0;i<numberOfEdges;i++){
-        edgeIDs[i] = mesh.edges()[i].getID();
-      }
-      _communication->send(edgeIDs,numberOfEdges,rankReceiver);
-
-      int triangleIDs[numberOfTriangles*3];
-      for(int i=0;i<numberOfTriangles;i++){
-        triangleIDs[i*3] = mesh.triangles()[i].edge(0).getID();
-        triangleIDs[i*3+1] = mesh.triangles()[i].edge(1).getID();
-        triangleIDs[i*3+2] = mesh.triangles()[i].edge(2).getID();
-      }
-      _communication->send(triangleIDs,numberOfTriangles*3,rankReceiver);
-    }
+  preciceTrace2 ( "sendMesh()", mesh.getName(), rankReceiver );
+  int header[3];
+  std::vector<double> payload;
+  packMesh ( mesh, header, payload );
+  _communication->send ( header, 3, rankReceiver );
+  if ( not payload.empty() ){
+    _communication->send ( payload.data(), (int)payload.size(), rankReceiver );
   }
 }
 
@@ -93,137 +55,26 @@ void CommunicateMesh:: receiveMesh
   int         rankSender )
 {
   preciceTrace2 ( "receiveMesh()", mesh.getName(), rankSender );
-  using tarch::la::raw;
-  int dim = mesh.getDimensions();
-
-  std::vector<mesh::Vertex*> vertices;
-  std::map<int, mesh::Vertex*> vertexMap;
-  int numberOfVertices = 0;
-  _communication->receive ( numberOfVertices, rankSender);
-
-  if(numberOfVertices>0){
-    double vertexCoords[numberOfVertices*dim];
-    _communication->receive(vertexCoords,numberOfVertices*dim,rankSender);
-    for ( int i=0; i < numberOfVertices; i++ ){
-      utils::DynVector coords(dim);
-      for ( int d=0; d < dim; d++){
-        coords[d] = vertexCoords[i*dim+d];
-      }
-      mesh::Vertex& v = mesh.createVertex ( coords );
-      assertion ( v.getID() >= 0, v.getID() );
-      vertices.push_back(&v);
-    }
-  }
-
-  int numberOfEdges = 0;
-  std::vector<mesh::Edge*> edges;
-  _communication->receive ( numberOfEdges, rankSender);
-  if(numberOfEdges>0){
-    int vertexIDs[numberOfVertices];
-    _communication->receive(vertexIDs,numberOfVertices,rankSender);
-    for( int i=0; i < numberOfVertices; i++){
-      vertexMap[vertexIDs[i]] = vertices[i];
-    }
-
-    int edgeIDs[numberOfEdges];
-    _communication->receive(edgeIDs,numberOfEdges*2,rankSender);
-    for( int i=0; i < numberOfEdges; i++){
-      assertion ( vertexMap.find(edgeIDs[i*2]) != vertexMap.end() );
-      assertion ( vertexMap.find(edgeIDs[i*2+1]) != vertexMap.end() );
-      assertion ( edgeIDs[i*2] != edgeIDs[i*2+1] );
-      mesh::Edge& e = mesh.createEdge ( *vertexMap[edgeIDs[i*2]], *vertexMap[edgeIDs[i*2+1]] );
-      edges.push_back(&e);
-    }
-  }
-
-  if ( dim == 3 ){
-    int numberOfTriangles = 0;
-    _communication->receive ( numberOfTriangles, rankSender );
-    if (numberOfTriangles > 0){
-      assertion ( (edges.size() > 0) || (numberOfTriangles == 0) );
-      int edgeIDs[numberOfEdges];
-      _communication->receive(edgeIDs,numberOfEdges,rankSender);
-      std::map<int,mesh::Edge*> edgeMap;
-      for( int i=0; i < numberOfEdges; i++){
-        edgeMap[edgeIDs[i]] = edges[i];
-      }
-
-      int triangleIDs[numberOfTriangles];
-      _communication->receive(triangleIDs,numberOfTriangles*3,rankSender);
-
-      for( int i=0; i < numberOfTriangles; i++){
-        assertion ( edgeMap.find(triangleIDs[i*3]) != edgeMap.end() );
-        assertion ( edgeMap.find(triangleIDs[i*3+1]) != edgeMap.end() );
-        assertion ( edgeMap.find(triangleIDs[i*3+2]) != edgeMap.end() );
-        assertion ( triangleIDs[i*3] != triangleIDs[i*3+1] );
-        assertion ( triangleIDs[i*3+1] != triangleIDs[i*3+2] );
-        assertion ( triangleIDs[i*3+2] != triangleIDs[i*3] );
-        mesh.createTriangle ( *edgeMap[triangleIDs[i*3]], *edgeMap[triangleIDs[i*3+1]], *edgeMap[triangleIDs[i*3+2]] );
-      }
-    }
+  int header[3];
+  _communication->receive ( header, 3, rankSender );
+  std::vector<double> payload ( payloadSize(header, mesh.getDimensions()) );
+  if ( not payload.empty() ){
+    _communication->receive ( payload.data(), (int)payload.size(), rankSender );
   }
+  unpackMesh ( mesh, header, payload );
 }
 
-
 void CommunicateMesh:: broadcastSendMesh
 (
   const mesh::Mesh& mesh )
 {
   preciceTrace1 ( "broadcastSendMesh()", mesh.getName() );
-  using tarch::la::raw;
-  int dim = mesh.getDimensions();
-
-  int numberOfVertices = mesh.vertices().size();
-  _communication->broadcast ( numberOfVertices);
-  if(numberOfVertices>0){
-    double itemsToSend[numberOfVertices*dim];
-    for(int i=0;i<numberOfVertices;i++){
-      for(int d=0;d<dim;d++){
-        itemsToSend[i*dim+d] = mesh.vertices()[i].getCoords()[d];
-      }
-    }
-    _communication->broadcast(itemsToSend,numberOfVertices*dim);
-  }
-
-  int numberOfEdges = mesh.edges().size();
-  _communication->broadcast ( numberOfEdges );
-  if(numberOfEdges>0){
-    //we need to send the vertexIDs first such that the right edges can be created later
-    //contrary to the normal sendMesh, this variant must also work for adding delta meshes
-    int vertexIDs[numberOfVertices];
-    for(int i=0;i<numberOfVertices;i++){
-      vertexIDs[i] = mesh.vertices()[i].getID();
-    }
-    _communication->broadcast(vertexIDs,numberOfVertices);
-
-    int edgeIDs[numberOfEdges*2];
-    for(int i=0;i<numberOfEdges;i++){
-      edgeIDs[i*2] = mesh.edges()[i].vertex(0).getID();
-      edgeIDs[i*2+1] = mesh.edges()[i].vertex(1).getID();
-    }
-    _communication->broadcast(edgeIDs,numberOfEdges*2);
-  }
-
-  if ( dim == 3 ) {
-    int numberOfTriangles = mesh.triangles().size();
-    _communication->broadcast ( numberOfTriangles );
-    if(numberOfTriangles>0){
-      //we need to send the edgeIDs first such that the right edges can be created later
-      //contrary to the normal sendMesh, this variant must also work for adding delta meshes
-      int edgeIDs[numberOfEdges];
-      for(int i=0;i<numberOfEdges;i++){
-        edgeIDs[i] = mesh.edges()[i].getID();
-      }
-      _communication->broadcast(edgeIDs,numberOfEdges);
-
-      int triangleIDs[numberOfTriangles*3];
-      for(int i=0;i<numberOfTriangles;i++){
-        triangleIDs[i*3] = mesh.triangles()[i].edge(0).getID();
-        triangleIDs[i*3+1] = mesh.triangles()[i].edge(1).getID();
-        triangleIDs[i*3+2] = mesh.triangles()[i].edge(2).getID();
-      }
-      _communication->broadcast(triangleIDs,numberOfTriangles*3);
-    }
+  int header[3];
+  std::vector<double> payload;
+  packMesh ( mesh, header, payload );
+  _communication->broadcast ( header, 3 );
+  if ( not payload.empty() ){
+    _communication->broadcast ( payload.data(), (int)payload.size() );
   }
 }
 
@@ -232,76 +83,14 @@ void CommunicateMesh:: broadcastReceiveMesh
   mesh::Mesh& mesh)
 {
   preciceTrace1 ( "broadcastReceiveMesh()", mesh.getName() );
-  using tarch::la::raw;
-  int dim = mesh.getDimensions();
   int rankBroadcaster = 0;
-
-  std::vector<mesh::Vertex*> vertices;
-  std::map<int, mesh::Vertex*> vertexMap;
-  int numberOfVertices = 0;
-  _communication->broadcast ( numberOfVertices, rankBroadcaster);
-
-  if(numberOfVertices>0){
-    double vertexCoords[numberOfVertices*dim];
-    _communication->broadcast(vertexCoords,numberOfVertices*dim,rankBroadcaster);
-    for ( int i=0; i < numberOfVertices; i++ ){
-      utils::DynVector coords(dim);
-      for ( int d=0; d < dim; d++){
-        coords[d] = vertexCoords[i*dim+d];
-      }
-      mesh::Vertex& v = mesh.createVertex ( coords );
-      assertion ( v.getID() >= 0, v.getID() );
-      vertices.push_back(&v);
-    }
-  }
-
-  int numberOfEdges = 0;
-  std::vector<mesh::Edge*> edges;
-  _communication->broadcast ( numberOfEdges, rankBroadcaster);
-  if(numberOfEdges>0){
-    int vertexIDs[numberOfVertices];
-    _communication->broadcast(vertexIDs,numberOfVertices,rankBroadcaster);
-    for( int i=0; i < numberOfVertices; i++){
-      vertexMap[vertexIDs[i]] = vertices[i];
-    }
-
-    int edgeIDs[numberOfEdges];
-    _communication->broadcast(edgeIDs,numberOfEdges*2,rankBroadcaster);
-    for( int i=0; i < numberOfEdges; i++){
-      assertion ( vertexMap.find(edgeIDs[i*2]) != vertexMap.end() );
-      assertion ( vertexMap.find(edgeIDs[i*2+1]) != vertexMap.end() );
-      assertion ( edgeIDs[i*2] != edgeIDs[i*2+1] );
-      mesh::Edge& e = mesh.createEdge ( *vertexMap[edgeIDs[i*2]], *vertexMap[edgeIDs[i*2+1]] );
-      edges.push_back(&e);
-    }
-  }
-
-  if ( dim == 3 ){
-    int numberOfTriangles = 0;
-    _communication->broadcast ( numberOfTriangles, rankBroadcaster );
-    if (numberOfTriangles > 0){
-      assertion ( (edges.size() > 0) || (numberOfTriangles == 0) );
-      int edgeIDs[numberOfEdges];
-      _communication->broadcast(edgeIDs,numberOfEdges,rankBroadcaster);
-      std::map<int,mesh::Edge*> edgeMap;
-      for( int i=0; i < numberOfEdges; i++){
-        edgeMap[edgeIDs[i]] = edges[i];
-      }
-
-      int triangleIDs[numberOfTriangles];
-      _communication->broadcast(triangleIDs,numberOfTriangles*3,rankBroadcaster);
-
-      for( int i=0; i < numberOfTriangles; i++){
-        assertion ( edgeMap.find(triangleIDs[i*3]) != edgeMap.end() );
-        assertion ( edgeMap.find(triangleIDs[i*3+1]) != edgeMap.end() );
-        assertion ( edgeMap.find(triangleIDs[i*3+2]) != edgeMap.end() );
-        assertion ( triangleIDs[i*3] != triangleIDs[i*3+1] );
-        assertion ( triangleIDs[i*3+1] != triangleIDs[i*3+2] );
-        assertion ( triangleIDs[i*3+2] != triangleIDs[i*3] );
-        mesh.createTriangle ( *edgeMap[triangleIDs[i*3]], *edgeMap[triangleIDs[i*3+1]], *edgeMap[triangleIDs[i*3+2]] );
-      }
-    }
+  int header[3];
+  _communication->broadcast ( header, 3, rankBroadcaster );
+  std::vector<double> payload ( payloadSize(header, mesh.getDimensions()) );
+  if ( not payload.empty() ){
+    _communication->broadcast ( payload.data(), (int)payload.size(), rankBroadcaster );
   }
+  unpackMesh ( mesh, header, payload );
 }
 
 void CommunicateMesh:: sendBoundingBox (
@@ -326,4 +115,116 @@ void CommunicateMesh:: receiveBoundingBox (
   }
 }
 
+void CommunicateMesh:: packMesh
+(
+  const mesh::Mesh&    mesh,
+  int*                 header,
+  std::vector<double>& payload )
+{
+  preciceTrace1 ( "packMesh()", mesh.getName() );
+  int dim = mesh.getDimensions();
+  int numberOfVertices = mesh.vertices().size();
+  int numberOfEdges = mesh.edges().size();
+  int numberOfTriangles = mesh.triangles().size();
+  header[0] = numberOfVertices;
+  header[1] = numberOfEdges;
+  header[2] = numberOfTriangles;
+  payload.resize ( payloadSize(header, dim) );
+
+  // Vertex and edge IDs are mapped to positions in the transferred sequence,
+  // IDs are unique per mesh and bounded by the number of created elements.
+  int maxVertexID = -1;
+  for ( int i=0; i < numberOfVertices; i++ ){
+    maxVertexID = std::max ( maxVertexID, mesh.vertices()[i].getID() );
+  }
+  std::vector<int> vertexPositions ( maxVertexID + 1, -1 );
+  double* item = payload.data();
+  for ( int i=0; i < numberOfVertices; i++ ){
+    const mesh::Vertex& vertex = mesh.vertices()[i];
+    vertexPositions[vertex.getID()] = i;
+    for ( int d=0; d < dim; d++ ){
+      *item++ = vertex.getCoords()[d];
+    }
+  }
+
+  int maxEdgeID = -1;
+  for ( int i=0; i < numberOfEdges; i++ ){
+    const mesh::Edge& edge = mesh.edges()[i];
+    maxEdgeID = std::max ( maxEdgeID, edge.getID() );
+    for ( int j=0; j < 2; j++ ){
+      assertion ( vertexPositions[edge.vertex(j).getID()] >= 0, edge.vertex(j).getID() );
+      *item++ = vertexPositions[edge.vertex(j).getID()];
+    }
+  }
+
+  if ( numberOfTriangles > 0 ){
+    std::vector<int> edgePositions ( maxEdgeID + 1, -1 );
+    for ( int i=0; i < numberOfEdges; i++ ){
+      edgePositions[mesh.edges()[i].getID()] = i;
+    }
+    for ( int i=0; i < numberOfTriangles; i++ ){
+      const mesh::Triangle& triangle = mesh.triangles()[i];
+      for ( int j=0; j < 3; j++ ){
+        assertion ( edgePositions[triangle.edge(j).getID()] >= 0, triangle.edge(j).getID() );
+        *item++ = edgePositions[triangle.edge(j).getID()];
+      }
+    }
+  }
+  assertion ( item == payload.data() + payload.size() );
+}
+
+void CommunicateMesh:: unpackMesh
+(
+  mesh::Mesh&                mesh,
+  const int*                 header,
+  const std::vector<double>& payload )
+{
+  preciceTrace1 ( "unpackMesh()", mesh.getName() );
+  int dim = mesh.getDimensions();
+  int numberOfVertices = header[0];
+  int numberOfEdges = header[1];
+  int numberOfTriangles = header[2];
+  assertion ( (int)payload.size() == payloadSize(header, dim),
+               payload.size(), payloadSize(header, dim) );
+
+  mesh.vertices().reserve ( mesh.vertices().size() + numberOfVertices );
+  mesh.edges().reserve ( mesh.edges().size() + numberOfEdges );
+  mesh.triangles().reserve ( mesh.triangles().size() + numberOfTriangles );
+
+  const double* item = payload.data();
+  std::vector<mesh::Vertex*> vertices ( numberOfVertices );
+  utils::DynVector coords ( dim );
+  for ( int i=0; i < numberOfVertices; i++ ){
+    for ( int d=0; d < dim; d++ ){
+      coords[d] = *item++;
+    }
+    vertices[i] = &mesh.createVertex ( coords );
+    assertion ( vertices[i]->getID() >= 0, vertices[i]->getID() );
+  }
+
+  std::vector<mesh::Edge*> edges ( numberOfEdges );
+  for ( int i=0; i < numberOfEdges; i++ ){
+    int first = (int)item[0];
+    int second = (int)item[1];
+    item += 2;
+    assertion ( (first >= 0) && (first < numberOfVertices), first, numberOfVertices );
+    assertion ( (second >= 0) && (second < numberOfVertices), second, numberOfVertices );
+    assertion ( first != second, first );
+    edges[i] = &mesh.createEdge ( *vertices[first], *vertices[second] );
+  }
+
+  for ( int i=0; i < numberOfTriangles; i++ ){
+    int edgeIndices[3];
+    for ( int j=0; j < 3; j++ ){
+      edgeIndices[j] = (int)*item++;
+      assertion ( (edgeIndices[j] >= 0) && (edgeIndices[j] < numberOfEdges),
+                   edgeIndices[j], numberOfEdges );
+    }
+    assertion ( edgeIndices[0] != edgeIndices[1] );
+    assertion ( edgeIndices[1] != edgeIndices[2] );
+    assertion ( edgeIndices[2] != edgeIndices[0] );
+    mesh.createTriangle ( *edges[edgeIndices[0]], *edges[edgeIndices[1]], *edges[edgeIndices[2]] );
+  }
+}
+
 }} // namespace precice, com
@@ -6,6 +6,7 @@
 
 #include "tarch/logging/Log.h"
 #include "mesh/Mesh.hpp"
+#include <vector>
 
 namespace precice {
    namespace mesh {
@@ -20,6 +21,16 @@ namespace com {
 
 /**
  * @brief Copies a Mesh object from a sender to a receiver.
+ *
+ * A mesh is transferred as one header, holding the numbers of vertices, edges
+ * and triangles, followed by one contiguous payload of doubles with the vertex
+ * coordinates, the edges as pairs of vertex positions and the triangles as
+ * triples of edge positions. Positions refer to the order of the transferred
+ * vertices and edges, hence no IDs have to be exchanged and the receiver
+ * creates the mesh elements directly from the payload.
+ *
+ * Meshes are always transferred completely. They are exchanged once during
+ * initialization, so there is no earlier transfer to send a delta against.
  */
 class CommunicateMesh
 {
@@ -40,6 +51,8 @@ public:
 
   /**
    * @brief Copies a CustomGeometry from the sender with given rank.
+   *
+   * The received vertices, edges and triangles are appended to the mesh.
    */
   void receiveMesh (
     mesh::Mesh & mesh,
@@ -67,6 +80,22 @@ private:
 
   // @brief Communication means used for the transfer of the geometry.
   com::Communication::SharedPointer _communication;
+
+  /**
+   * @brief Packs the numbers of elements into header and all elements into payload.
+   */
+  void packMesh (
+    const mesh::Mesh &    mesh,
+    int *                 header,
+    std::vector<double> & payload );
+
+  /**
+   * @brief Creates the mesh elements described by header and payload.
+   */
+  void unpackMesh (
+    mesh::Mesh &                mesh,
+    const int *                 header,
+    const std::vector<double> & payload );
 };
 
 }} // namespace precice, com
@@ -8,68 +8,186 @@
 #include "Request.hpp"
 
 #include "utils/Globals.hpp"
+#include "utils/Parallel.hpp"
+
+#include <algorithm>
+#include <vector>
 
 namespace precice {
 namespace com {
 tarch::logging::Log Communication::_log(
     "precice::com::Communication");
 
+namespace {
+
+/// Receives the items of all slaves at once and sums them up in order of ranks.
+template <typename T>
+void
+reduceFromSlaves(Communication& communication,
+                 T const* itemsToSend,
+                 T* itemsToReceive,
+                 int size,
+                 int rankOffset) {
+  size_t slaves = communication.getRemoteCommunicatorSize();
+  std::vector<T> buffer(slaves * size);
+  std::vector<Request::SharedPointer> requests;
+
+  requests.reserve(slaves);
+
+  for (size_t rank = 0; rank < slaves; ++rank) {
+    requests.push_back(
+        communication.aReceive(&buffer[rank * size], size, rank + rankOffset));
+  }
+
+  std::copy(itemsToSend, itemsToSend + size, itemsToReceive);
 
+  Request::wait(requests);
 
-/**
- * Attention: this method modifies the input buffer.
- */
+  for (size_t rank = 0; rank < slaves; ++rank) {
+    for (int i = 0; i < size; i++) {
+      itemsToReceive[i] += buffer[rank * size + i];
+    }
+  }
+}
+
+template <typename T>
 void
-Communication::reduceSum(double* itemsToSend, double* itemsToReceive, int size) {
-  preciceTrace1("broadcast(double*)", size);
+sendToSlaves(Communication& communication,
+             T* itemsToSend,
+             int size,
+             int rankOffset) {
+  std::vector<Request::SharedPointer> requests;
+
+  requests.reserve(communication.getRemoteCommunicatorSize());
+
+  for (size_t rank = 0; rank < communication.getRemoteCommunicatorSize(); ++rank) {
+    requests.push_back(communication.aSend(itemsToSend, size, rank + rankOffset));
+  }
+
+  Request::wait(requests);
+}
+}
 
-  for(int i = 0; i < size; i++){
-    itemsToReceive[i] = itemsToSend[i];
+bool
+Communication::isIntraCommunicatorShared(int rankMaster) {
+  preciceTrace1("isIntraCommunicatorShared()", rankMaster);
+
+  if (_intraCommunicator != IntraCommunicator::UNKNOWN) {
+    return _intraCommunicator == IntraCommunicator::SHARED;
   }
 
-  // receive local results from slaves
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aReceive(itemsToSend, size, rank + _rankOffset);
-    request->wait();
-    for(int i = 0; i < size; i++){
-      itemsToReceive[i] += itemsToSend[i];
+  _intraCommunicator = IntraCommunicator::NONE;
+
+#ifndef PRECICE_NO_MPI
+  int position[2] = {-1, 0};
+  int isInitialized = 0;
+
+  MPI_Initialized(&isInitialized);
+
+  if (isInitialized) {
+    MPI_Comm_rank(utils::Parallel::getGroupCommunicator(), &position[0]);
+    MPI_Comm_size(utils::Parallel::getGroupCommunicator(), &position[1]);
+  }
+
+  if (rankMaster < 0) {
+    int slaves = getRemoteCommunicatorSize();
+    std::vector<int> positions(2 * slaves);
+    std::vector<Request::SharedPointer> requests;
+
+    for (int rank = 0; rank < slaves; ++rank) {
+      requests.push_back(aReceive(&positions[2 * rank], 2, rank + _rankOffset));
+    }
+    Request::wait(requests);
+
+    // Slaves have to be ordered as in the master-slave communication
+    bool isShared = (position[0] == 0) && (position[1] == slaves + 1);
+    for (int rank = 0; rank < slaves; ++rank) {
+      isShared &= (positions[2 * rank] == rank + 1) &&
+                  (positions[2 * rank + 1] == slaves + 1);
+    }
+
+    int decision = isShared;
+    sendToSlaves(*this, &decision, 1, _rankOffset);
+
+    if (isShared) {
+      _intraCommunicator = IntraCommunicator::SHARED;
+    }
+  } else {
+    send(position, 2, rankMaster + _rankOffset);
+
+    int decision = 0;
+    receive(decision, rankMaster + _rankOffset);
+
+    if (decision) {
+      _intraCommunicator = IntraCommunicator::SHARED;
     }
   }
+
+  preciceDebug("Native MPI collectives: "
+               << (_intraCommunicator == IntraCommunicator::SHARED));
+#endif // not PRECICE_NO_MPI
+
+  return _intraCommunicator == IntraCommunicator::SHARED;
 }
 
+void
+Communication::reduceSum(double* itemsToSend, double* itemsToReceive, int size) {
+  preciceTrace1("reduceSum(double*)", size);
+
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(-1)) {
+    MPI_Reduce(itemsToSend, itemsToReceive, size, MPI_DOUBLE, MPI_SUM,
+               0, utils::Parallel::getGroupCommunicator());
+    return;
+  }
+#endif // not PRECICE_NO_MPI
+
+  reduceFromSlaves(*this, itemsToSend, itemsToReceive, size, _rankOffset);
+}
 
 void
 Communication::reduceSum(double* itemsToSend, double* itemsToReceive, int size, int rankMaster) {
-  preciceTrace1("allreduce(double*)", size);
+  preciceTrace1("reduceSum(double*)", size);
 
-  auto request = aSend(itemsToSend, size, rankMaster);
-  request->wait();
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(rankMaster)) {
+    MPI_Reduce(itemsToSend, itemsToReceive, size, MPI_DOUBLE, MPI_SUM,
+               0, utils::Parallel::getGroupCommunicator());
+    return;
+  }
+#endif // not PRECICE_NO_MPI
+
+  send(itemsToSend, size, rankMaster + _rankOffset);
 }
 
-/**
- * Attention: this method modifies the input buffer.
- */
 void
 Communication::reduceSum(int& itemsToSend, int& itemsToReceive) {
-  preciceTrace("broadcast(int)");
+  preciceTrace("reduceSum(int)");
 
-  itemsToReceive = itemsToSend;
-
-  // receive local results from slaves
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aReceive(&itemsToSend, 1, rank + _rankOffset);
-    request->wait();
-    itemsToReceive += itemsToSend;
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(-1)) {
+    MPI_Reduce(&itemsToSend, &itemsToReceive, 1, MPI_INT, MPI_SUM,
+               0, utils::Parallel::getGroupCommunicator());
+    return;
   }
-}
+#endif // not PRECICE_NO_MPI
 
+  reduceFromSlaves(*this, &itemsToSend, &itemsToReceive, 1, _rankOffset);
+}
 
 void
 Communication::reduceSum(int& itemsToSend, int& itemsToReceive, int rankMaster) {
-  preciceTrace("allreduce(int)");
+  preciceTrace("reduceSum(int)");
 
-  auto request = aSend(&itemsToSend, 1, rankMaster);
-  request->wait();
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(rankMaster)) {
+    MPI_Reduce(&itemsToSend, &itemsToReceive, 1, MPI_INT, MPI_SUM,
+               0, utils::Parallel::getGroupCommunicator());
+    return;
+  }
+#endif // not PRECICE_NO_MPI
+
+  send(itemsToSend, rankMaster + _rankOffset);
 }
 
 void
@@ -77,128 +195,87 @@ Communication::allreduceSum() {
   preciceTrace("allreduceSum()");
 }
 
-/**
- * Attention: this method modifies the input buffer.
- */
 void
 Communication::allreduceSum(double* itemsToSend, double* itemsToReceive, int size) {
-  preciceTrace1("broadcast(double*)", size);
+  preciceTrace1("allreduceSum(double*)", size);
 
-  for(int i = 0; i < size; i++){
-    itemsToReceive[i] = itemsToSend[i];
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(-1)) {
+    MPI_Allreduce(itemsToSend, itemsToReceive, size, MPI_DOUBLE,
+                  MPI_SUM, utils::Parallel::getGroupCommunicator());
+    return;
   }
+#endif // not PRECICE_NO_MPI
 
-  // receive local results from slaves
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aReceive(itemsToSend, size, rank + _rankOffset);
-    request->wait();
-    for(int i = 0; i < size; i++){
-      itemsToReceive[i] += itemsToSend[i];
-    }
-  }
-
-  // send reduced result to all slaves
-  std::vector<Request::SharedPointer> requests;
-  requests.reserve(getRemoteCommunicatorSize());
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aSend(itemsToReceive, size, rank + _rankOffset);
-    requests.push_back(request);
-  }
-  Request::wait(requests);
+  reduceFromSlaves(*this, itemsToSend, itemsToReceive, size, _rankOffset);
+  sendToSlaves(*this, itemsToReceive, size, _rankOffset);
 }
 
-/**
- * Attention: this method modifies the input buffer.
- */
 void
 Communication::allreduceSum(double* itemsToSend, double* itemsToReceive, int size, int rankMaster) {
-  preciceTrace1("allreduce(double*)", size);
+  preciceTrace1("allreduceSum(double*)", size);
+
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(rankMaster)) {
+    MPI_Allreduce(itemsToSend, itemsToReceive, size, MPI_DOUBLE,
+                  MPI_SUM, utils::Parallel::getGroupCommunicator());
+    return;
+  }
+#endif // not PRECICE_NO_MPI
 
-  auto request = aSend(itemsToSend, size, rankMaster);
-  request->wait();
-  // receive reduced data from master
+  send(itemsToSend, size, rankMaster + _rankOffset);
   receive(itemsToReceive, size, rankMaster + _rankOffset);
 }
 
-/**
- * Attention: this method modifies the input buffer.
- */
 void
 Communication::allreduceSum(double& itemsToSend, double& itemsToReceive) {
-  preciceTrace("broadcast(double)");
+  preciceTrace("allreduceSum(double)");
 
-  itemsToReceive = itemsToSend;
-
-  // receive local results from slaves
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aReceive(&itemsToSend, 1, rank + _rankOffset);
-    request->wait();
-    itemsToReceive += itemsToSend;
-  }
-
-  // send reduced result to all slaves
-  std::vector<Request::SharedPointer> requests;
-  requests.reserve(getRemoteCommunicatorSize());
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aSend(&itemsToReceive, 1, rank + _rankOffset);
-    requests.push_back(request);
-  }
-  Request::wait(requests);
+  allreduceSum(&itemsToSend, &itemsToReceive, 1);
 }
 
-/**
- * Attention: this method modifies the input buffer.
- */
 void
 Communication::allreduceSum(double& itemsToSend, double& itemsToReceive, int rankMaster) {
-  preciceTrace("allreduce(double)");
+  preciceTrace("allreduceSum(double)");
 
-  auto request = aSend(&itemsToSend, 1, rankMaster);
-  request->wait();
-  // receive reduced data from master
-  receive(&itemsToReceive, 1, rankMaster + _rankOffset);
+  allreduceSum(&itemsToSend, &itemsToReceive, 1, rankMaster);
 }
 
-/**
- * Attention: this method modifies the input buffer.
- */
 void
 Communication::allreduceSum(int& itemsToSend, int& itemsToReceive) {
-  preciceTrace("broadcast(int)");
+  preciceTrace("allreduceSum(int)");
 
-  itemsToReceive = itemsToSend;
-
-  // receive local results from slaves
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aReceive(&itemsToSend, 1, rank + _rankOffset);
-    request->wait();
-    itemsToReceive += itemsToSend;
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(-1)) {
+    MPI_Allreduce(&itemsToSend, &itemsToReceive, 1, MPI_INT, MPI_SUM,
+                  utils::Parallel::getGroupCommunicator());
+    return;
   }
+#endif // not PRECICE_NO_MPI
 
-  // send reduced result to all slaves
-  std::vector<Request::SharedPointer> requests;
-  requests.reserve(getRemoteCommunicatorSize());
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aSend(&itemsToReceive, 1, rank + _rankOffset);
-    requests.push_back(request);
-  }
-  Request::wait(requests);
+  reduceFromSlaves(*this, &itemsToSend, &itemsToReceive, 1, _rankOffset);
+  sendToSlaves(*this, &itemsToReceive, 1, _rankOffset);
 }
 
-/**
- * Attention: this method modifies the input buffer.
- */
 void
 Communication::allreduceSum(int& itemsToSend, int& itemsToReceive, int rankMaster) {
-  preciceTrace("allreduce(int)");
+  preciceTrace("allreduceSum(int)");
 
-  auto request = aSend(&itemsToSend, 1, rankMaster);
-  request->wait();
-  // receive reduced data from master
-  receive(&itemsToReceive, 1, rankMaster + _rankOffset);
-}
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(rankMaster)) {
+    MPI_Allreduce(&itemsToSend, &itemsToReceive, 1, MPI_INT, MPI_SUM,
+                  utils::Parallel::getGroupCommunicator());
+    return;
+  }
+#endif // not PRECICE_NO_MPI
 
+  send(itemsToSend, rankMaster + _rankOffset);
+  receive(itemsToReceive, rankMaster + _rankOffset);
+}
 
+void
+Communication::flushSendPackage() {
+}
 
 void
 Communication::broadcast() {
@@ -209,23 +286,27 @@ void
 Communication::broadcast(int* itemsToSend, int size) {
   preciceTrace1("broadcast(int*)", size);
 
-  std::vector<Request::SharedPointer> requests;
-
-  requests.reserve(getRemoteCommunicatorSize());
-
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aSend(itemsToSend, size, rank + _rankOffset);
-
-    requests.push_back(request);
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(-1)) {
+    MPI_Bcast(itemsToSend, size, MPI_INT, 0, utils::Parallel::getGroupCommunicator());
+    return;
   }
+#endif // not PRECICE_NO_MPI
 
-  Request::wait(requests);
+  sendToSlaves(*this, itemsToSend, size, _rankOffset);
 }
 
 void
 Communication::broadcast(int* itemsToReceive, int size, int rankBroadcaster) {
   preciceTrace1("broadcast(int*)", size);
 
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(rankBroadcaster)) {
+    MPI_Bcast(itemsToReceive, size, MPI_INT, 0, utils::Parallel::getGroupCommunicator());
+    return;
+  }
+#endif // not PRECICE_NO_MPI
+
   receive(itemsToReceive, size, rankBroadcaster + _rankOffset);
 }
 
@@ -233,41 +314,28 @@ void
 Communication::broadcast(int itemToSend) {
   preciceTrace("broadcast(int)");
 
-  std::vector<Request::SharedPointer> requests;
-
-  requests.reserve(getRemoteCommunicatorSize());
-
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aSend(&itemToSend, rank + _rankOffset);
-
-    requests.push_back(request);
-  }
-
-  Request::wait(requests);
+  broadcast(&itemToSend, 1);
 }
 
 void
 Communication::broadcast(int& itemToReceive, int rankBroadcaster) {
   preciceTrace("broadcast(int&)");
 
-  receive(itemToReceive, rankBroadcaster + _rankOffset);
+  broadcast(&itemToReceive, 1, rankBroadcaster);
 }
 
 void
 Communication::broadcast(double* itemsToSend, int size) {
   preciceTrace1("broadcast(double*)", size);
 
-  std::vector<Request::SharedPointer> requests;
-
-  requests.reserve(getRemoteCommunicatorSize());
-
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aSend(itemsToSend, size, rank + _rankOffset);
-
-    requests.push_back(request);
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(-1)) {
+    MPI_Bcast(itemsToSend, size, MPI_DOUBLE, 0, utils::Parallel::getGroupCommunicator());
+    return;
   }
+#endif // not PRECICE_NO_MPI
 
-  Request::wait(requests);
+  sendToSlaves(*this, itemsToSend, size, _rankOffset);
 }
 
 void
@@ -275,6 +343,14 @@ Communication::broadcast(double* itemsToReceive,
                          int size,
                          int rankBroadcaster) {
   preciceTrace1("broadcast(double*)", size);
+
+#ifndef PRECICE_NO_MPI
+  if (isIntraCommunicatorShared(rankBroadcaster)) {
+    MPI_Bcast(itemsToReceive, size, MPI_DOUBLE, 0, utils::Parallel::getGroupCommunicator());
+    return;
+  }
+#endif // not PRECICE_NO_MPI
+
   receive(itemsToReceive, size, rankBroadcaster + _rankOffset);
 }
 
@@ -282,23 +358,14 @@ void
 Communication::broadcast(double itemToSend) {
   preciceTrace("broadcast(double)");
 
-  std::vector<Request::SharedPointer> requests;
-
-  requests.reserve(getRemoteCommunicatorSize());
-
-  for (size_t rank = 0; rank < getRemoteCommunicatorSize(); ++rank) {
-    auto request = aSend(&itemToSend, rank + _rankOffset);
-
-    requests.push_back(request);
-  }
-
-  Request::wait(requests);
+  broadcast(&itemToSend, 1);
 }
 
 void
 Communication::broadcast(double& itemToReceive, int rankBroadcaster) {
   preciceTrace("broadcast(double&)");
-  receive(itemToReceive, rankBroadcaster + _rankOffset);
+
+  broadcast(&itemToReceive, 1, rankBroadcaster);
 }
 
 void
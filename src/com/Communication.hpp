@@ -48,7 +48,10 @@ public:
 
 public:
 
-  Communication() : _rank(-1), _rankOffset(0) {
+  Communication()
+      : _rank(-1)
+      , _rankOffset(0)
+      , _intraCommunicator(IntraCommunicator::UNKNOWN) {
   }
 
   /**
@@ -112,6 +115,14 @@ public:
 
   virtual void finishSendPackage() = 0;
 
+  /**
+   * @brief Writes sends held back for the current package, the package stays open.
+   *
+   * Has to be called before blocking on another communication, the receiver of
+   * the package may wait for the held back sends before serving that one.
+   */
+  virtual void flushSendPackage();
+
   /**
    * @brief Starts to receive messages from rankSender.
    *
@@ -121,6 +132,16 @@ public:
 
   virtual void finishReceivePackage() = 0;
 
+  /**
+   * @name Collective operations between master and slaves.
+   *
+   * Overloads without rank are called by the master, the ones with rank by
+   * the slaves. If master and slaves share an MPI communicator, in which the
+   * master has rank 0 and the slaves follow in order, the native MPI
+   * collectives are used. Otherwise, the master posts the transfers to all
+   * slaves at once and combines the results in order of ranks.
+   */
+  ///@{
   virtual void reduceSum(double* itemsToSend, double* itemsToReceive, int size, int rankMaster);
 
   virtual void reduceSum(double* itemsToSend, double* itemsToReceive, int size);
@@ -164,6 +185,7 @@ public:
   virtual void broadcast(bool itemToSend);
 
   virtual void broadcast(bool& itemToReceive, int rankBroadcaster);
+  ///@}
 
   /**
    * @brief Sends a std::string to process with given rank.
@@ -194,6 +216,13 @@ public:
                                        int size,
                                        int rankReceiver) = 0;
 
+  /**
+   * @brief Asynchronously sends an array of single precision values.
+   */
+  virtual Request::SharedPointer aSend(float* itemsToSend,
+                                       int size,
+                                       int rankReceiver) = 0;
+
   /**
    * @brief Sends a double to process with given rank.
    */
@@ -254,6 +283,13 @@ public:
                                           int size,
                                           int rankSender) = 0;
 
+  /**
+   * @brief Asynchronously receives an array of single precision values.
+   */
+  virtual Request::SharedPointer aReceive(float* itemsToReceive,
+                                          int size,
+                                          int rankSender) = 0;
+
   /**
    * @brief Receives a double from process with given rank.
    */
@@ -312,6 +348,20 @@ protected:
 private:
   // @brief Logging device.
   static tarch::logging::Log _log;
+
+  enum class IntraCommunicator { UNKNOWN, SHARED, NONE };
+
+  /// Whether master and slaves share an MPI communicator, determined on first use.
+  IntraCommunicator _intraCommunicator;
+
+  /**
+   * @brief Returns true, if collectives can be delegated to MPI.
+   *
+   * Exchanges the MPI ranks once, has to be called by master and slaves.
+   *
+   * @param rankMaster [IN] Rank of the master on slaves, -1 on the master.
+   */
+  bool isIntraCommunicatorShared(int rankMaster);
 };
 }
 } // namespace precice, com
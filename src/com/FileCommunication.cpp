@@ -244,6 +244,11 @@ FileCommunication::aSend(double* itemsToSend, int size, int rankReceiver) {
   preciceError("aSend()", "Not implemented!");
 }
 
+Request::SharedPointer
+FileCommunication::aSend(float* itemsToSend, int size, int rankReceiver) {
+  preciceError("aSend()", "Not implemented!");
+}
+
 void FileCommunication:: send
 (
   double itemToSend,
@@ -356,6 +361,11 @@ FileCommunication::aReceive(double* itemsToReceive, int size, int rankSender) {
   preciceError("aReceive()", "Not implemented!");
 }
 
+Request::SharedPointer
+FileCommunication::aReceive(float* itemsToReceive, int size, int rankSender) {
+  preciceError("aReceive()", "Not implemented!");
+}
+
 void FileCommunication:: receive
 (
    double& itemToReceive,
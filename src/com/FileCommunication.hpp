@@ -125,6 +125,12 @@ public:
   virtual Request::SharedPointer
   aSend(double* itemsToSend, int size, int rankReceiver);
 
+  /**
+   * @brief Asynchronously sends an array of single precision values.
+   */
+  virtual Request::SharedPointer
+  aSend(float* itemsToSend, int size, int rankReceiver);
+
   /**
    * @brief Sends a double to process with given rank.
    */
@@ -187,6 +193,13 @@ public:
                                           int size,
                                           int rankSender);
 
+  /**
+   * @brief Asynchronously receives an array of single precision values.
+   */
+  virtual Request::SharedPointer aReceive(float* itemsToReceive,
+                                          int size,
+                                          int rankSender);
+
   /**
    * @brief Receives a double from process with given rank.
    */
@@ -124,6 +124,24 @@ MPICommunication::aSend(double* itemsToSend, int size, int rankReceiver) {
   return Request::SharedPointer(new MPIRequest(request));
 }
 
+Request::SharedPointer
+MPICommunication::aSend(float* itemsToSend, int size, int rankReceiver) {
+  preciceTrace1("aSend(float*)", size);
+  rankReceiver = rankReceiver - _rankOffset;
+
+  MPI_Request request;
+
+  MPI_Isend(itemsToSend,
+            size,
+            MPI_FLOAT,
+            rank(rankReceiver),
+            0,
+            communicator(rankReceiver),
+            &request);
+
+  return Request::SharedPointer(new MPIRequest(request));
+}
+
 void
 MPICommunication::send(double itemToSend, int rankReceiver) {
   preciceTrace2("send(double)", itemToSend, rankReceiver);
@@ -273,6 +291,24 @@ MPICommunication::aReceive(double* itemsToReceive, int size, int rankSender) {
   return Request::SharedPointer(new MPIRequest(request));
 }
 
+Request::SharedPointer
+MPICommunication::aReceive(float* itemsToReceive, int size, int rankSender) {
+  preciceTrace1("aReceive(float*)", size);
+  rankSender = rankSender - _rankOffset;
+
+  MPI_Request request;
+
+  MPI_Irecv(itemsToReceive,
+            size,
+            MPI_FLOAT,
+            rank(rankSender),
+            0,
+            communicator(rankSender),
+            &request);
+
+  return Request::SharedPointer(new MPIRequest(request));
+}
+
 void
 MPICommunication::receive(double& itemToReceive, int rankSender) {
   preciceTrace1("receive(double)", rankSender);
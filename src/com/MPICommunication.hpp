@@ -88,6 +88,13 @@ public:
                                        int size,
                                        int rankReceiver);
 
+  /**
+   * @brief Asynchronously sends an array of single precision values.
+   */
+  virtual Request::SharedPointer aSend(float* itemsToSend,
+                                       int size,
+                                       int rankReceiver);
+
   /**
    * @brief Sends a double to process with given rank.
    *
@@ -155,6 +162,13 @@ public:
                                           int size,
                                           int rankSender);
 
+  /**
+   * @brief Asynchronously receives an array of single precision values.
+   */
+  virtual Request::SharedPointer aReceive(float* itemsToReceive,
+                                          int size,
+                                          int rankSender);
+
   /**
    * @brief Receives a double from process with given rank.
    *
@@ -0,0 +1,957 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at
+// http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SHARED_MEMORY
+
+#include "SharedMemoryCommunication.hpp"
+
+#include "SharedMemoryRequest.hpp"
+
+#include "utils/Globals.hpp"
+#include "utils/Publisher.hpp"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+
+using precice::utils::Publisher;
+using precice::utils::ScopedPublisher;
+
+namespace precice {
+namespace com {
+
+namespace {
+
+/// Blocking operations sleep at most this long, before checking again.
+const long WAIT_TIMEOUT = 100000000;
+
+/// Checks before sleeping, which saves the system calls on short waits.
+const int SPIN_COUNT = 4000;
+
+void
+futexWait(std::atomic<std::uint32_t>* word, std::uint32_t expected, long timeout) {
+  timespec time = {timeout / 1000000000, timeout % 1000000000};
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT,
+          expected, &time, nullptr, 0);
+}
+
+void
+futexWake(std::atomic<std::uint32_t>* word) {
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE,
+          INT_MAX, nullptr, nullptr, 0);
+}
+
+/// Sequence number, which is increased on every change the peer may wait for.
+struct Signal {
+  std::atomic<std::uint32_t> sequence;
+  std::atomic<std::uint32_t> waiters;
+
+  void
+  notify() {
+    sequence.fetch_add(1);
+    if (waiters.load() > 0) {
+      futexWake(&sequence);
+    }
+  }
+
+  /// Returns when the condition holds, when notified or after the timeout.
+  template <typename Condition>
+  void
+  wait(Condition condition, long timeout) {
+    for (int i = 0; i < SPIN_COUNT; ++i) {
+      if (condition()) {
+        return;
+      }
+    }
+    waiters.fetch_add(1);
+    std::uint32_t current = sequence.load();
+    if (not condition()) {
+      futexWait(&sequence, current, timeout);
+    }
+    waiters.fetch_sub(1);
+  }
+};
+
+/// Ring buffer with one writing and one reading process.
+struct Ring {
+  alignas(64) std::atomic<std::uint64_t> writePosition;
+  alignas(64) std::atomic<std::uint64_t> readPosition;
+  /// Notified after writing.
+  alignas(64) Signal dataSignal;
+  /// Notified after reading.
+  alignas(64) Signal spaceSignal;
+
+  bool
+  hasSpace(size_t capacity) const {
+    return writePosition.load() - readPosition.load() < capacity;
+  }
+
+  bool
+  hasData() const {
+    return readPosition.load() < writePosition.load();
+  }
+
+  /// Copies as many bytes into the buffer as fit, returns their number.
+  size_t
+  write(char* buffer, size_t capacity, char const* data, size_t size) {
+    std::uint64_t position = writePosition.load(std::memory_order_relaxed);
+    std::uint64_t free = capacity - (position - readPosition.load(std::memory_order_acquire));
+    size_t count = std::min<std::uint64_t>(size, free);
+    if (count == 0) {
+      return 0;
+    }
+    size_t offset = position % capacity;
+    size_t first = std::min(count, capacity - offset);
+    std::memcpy(buffer + offset, data, first);
+    std::memcpy(buffer, data + first, count - first);
+    writePosition.store(position + count, std::memory_order_release);
+    dataSignal.notify();
+    return count;
+  }
+
+  /// Copies as many bytes out of the buffer as available, returns their number.
+  size_t
+  read(char const* buffer, size_t capacity, char* data, size_t size) {
+    std::uint64_t position = readPosition.load(std::memory_order_relaxed);
+    std::uint64_t available = writePosition.load(std::memory_order_acquire) - position;
+    size_t count = std::min<std::uint64_t>(size, available);
+    if (count == 0) {
+      return 0;
+    }
+    size_t offset = position % capacity;
+    size_t first = std::min(count, capacity - offset);
+    std::memcpy(data, buffer + offset, first);
+    std::memcpy(data + first, buffer, count - first);
+    readPosition.store(position + count, std::memory_order_release);
+    spaceSignal.notify();
+    return count;
+  }
+};
+
+/// Layout of the segment shared by acceptor and one requester process.
+struct ChannelLayout {
+  std::uint64_t capacity;
+  Ring toAcceptor;
+  Ring toRequester;
+  /// Wakes the helper thread of the requester, notified on every transfer.
+  alignas(64) Signal requesterWakeup;
+
+  char*
+  buffers() {
+    return reinterpret_cast<char*>(this + 1);
+  }
+
+  static size_t
+  segmentSize(size_t capacity) {
+    return sizeof(ChannelLayout) + 2 * capacity;
+  }
+};
+
+/// Layout of the segment requesters announce their channels in.
+struct ControlLayout {
+  std::uint64_t capacity;
+  /// Hands out ranks to requesting clients.
+  std::atomic<std::uint32_t> requests;
+  std::atomic<std::int32_t> requesterCommunicatorSize;
+  std::atomic<std::uint32_t> connectedCount;
+  /// Notified when a requester has created its channel.
+  Signal connected;
+  /// Wakes the helper thread of the acceptor, notified on every transfer.
+  alignas(64) Signal acceptorWakeup;
+};
+
+/// Maps a shared memory segment, returns nullptr and keeps errno on failure.
+void*
+mapSegment(std::string const& name, size_t size, bool create) {
+  int fd = shm_open(name.c_str(), create ? (O_CREAT | O_EXCL | O_RDWR) : O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  if (create && (ftruncate(fd, size) != 0)) {
+    int error = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    errno = error;
+    return nullptr;
+  }
+  void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int error = errno;
+  close(fd);
+  errno = error;
+  return address == MAP_FAILED ? nullptr : address;
+}
+
+std::string
+channelName(std::string const& controlName, int requesterRank) {
+  return controlName + "-" + std::to_string(requesterRank);
+}
+}
+
+struct SharedMemoryCommunication::Channel {
+  ChannelLayout* layout;
+  Ring* out;
+  Ring* in;
+  char* outBuffer;
+  char* inBuffer;
+  size_t capacity;
+  /// Wakeup of the own helper thread, shared by all channels of the communicator.
+  Signal* wakeup;
+  /// Wakeup of the helper thread of the peer.
+  Signal* peerWakeup;
+  /// Number of pending asynchronous sends and receives, guarded by _operationsMutex.
+  int pendingSends;
+  int pendingReceives;
+
+  Channel(ChannelLayout* layout, ControlLayout* control, bool isAcceptor)
+      : layout(layout)
+      , out(isAcceptor ? &layout->toRequester : &layout->toAcceptor)
+      , in(isAcceptor ? &layout->toAcceptor : &layout->toRequester)
+      , outBuffer(layout->buffers() + (isAcceptor ? layout->capacity : 0))
+      , inBuffer(layout->buffers() + (isAcceptor ? 0 : layout->capacity))
+      , capacity(layout->capacity)
+      , wakeup(isAcceptor ? &control->acceptorWakeup : &layout->requesterWakeup)
+      , peerWakeup(isAcceptor ? &layout->requesterWakeup : &control->acceptorWakeup)
+      , pendingSends(0)
+      , pendingReceives(0) {
+  }
+
+  ~Channel() {
+    munmap(layout, ChannelLayout::segmentSize(capacity));
+  }
+
+  size_t
+  send(char const* data, size_t size) {
+    size_t count = out->write(outBuffer, capacity, data, size);
+    if (count > 0) {
+      peerWakeup->notify();
+    }
+    return count;
+  }
+
+  size_t
+  receive(char* data, size_t size) {
+    size_t count = in->read(inBuffer, capacity, data, size);
+    if (count > 0) {
+      peerWakeup->notify();
+    }
+    return count;
+  }
+
+  /// Returns the signal and condition to wait for, until the operation can progress.
+  Signal&
+  signal(bool isSend) {
+    return isSend ? out->spaceSignal : in->dataSignal;
+  }
+
+  bool
+  canProgress(bool isSend) const {
+    return isSend ? out->hasSpace(capacity) : in->hasData();
+  }
+};
+
+tarch::logging::Log SharedMemoryCommunication::_log(
+    "precice::com::SharedMemoryCommunication");
+
+SharedMemoryCommunication::SharedMemoryCommunication(
+    std::string const& addressDirectory, size_t bufferSize)
+    : _addressDirectory(addressDirectory)
+    , _bufferSize(bufferSize)
+    , _isConnected(false)
+    , _remoteCommunicatorSize(0)
+    , _channels()
+    , _controlSegment(nullptr)
+    , _operations()
+    , _stopThread(false)
+    , _thread() {
+  if (_addressDirectory.empty()) {
+    _addressDirectory = ".";
+  }
+  assertion(_bufferSize > 0);
+}
+
+SharedMemoryCommunication::~SharedMemoryCommunication() {
+  preciceTrace1("~SharedMemoryCommunication()", _isConnected);
+
+  closeConnection();
+}
+
+bool
+SharedMemoryCommunication::isConnected() {
+  return _isConnected;
+}
+
+size_t
+SharedMemoryCommunication::getRemoteCommunicatorSize() {
+  preciceTrace("getRemoteCommunicatorSize()");
+
+  assertion(isConnected());
+
+  return _remoteCommunicatorSize;
+}
+
+void
+SharedMemoryCommunication::acceptConnection(std::string const& nameAcceptor,
+                                            std::string const& nameRequester,
+                                            int acceptorProcessRank,
+                                            int acceptorCommunicatorSize) {
+  preciceTrace2("acceptConnection()", nameAcceptor, nameRequester);
+
+  preciceCheck(acceptorCommunicatorSize == 1,
+               "acceptConnection()",
+               "Acceptor of shared memory connection can only have one process!");
+
+  assertion(not isConnected());
+
+  _rank = acceptorProcessRank;
+
+  {
+    std::string addressFileName("." + nameRequester + "-" + nameAcceptor +
+                                ".address");
+    std::string controlName = createControlSegment(nameAcceptor, nameRequester);
+
+    Publisher::ScopedChangePrefixDirectory scpd(_addressDirectory);
+
+    ScopedPublisher p(addressFileName);
+
+    p.write(controlName);
+
+    preciceDebug("Accept connection at " << controlName);
+
+    acceptChannels(controlName, 0);
+  }
+
+  for (int remoteRank = 0; remoteRank < _remoteCommunicatorSize; ++remoteRank) {
+    send(acceptorProcessRank, remoteRank);
+    send(acceptorCommunicatorSize, remoteRank);
+  }
+}
+
+void
+SharedMemoryCommunication::acceptConnectionAsServer(std::string const& nameAcceptor,
+                                                    std::string const& nameRequester,
+                                                    int requesterCommunicatorSize) {
+  preciceTrace2("acceptConnectionAsServer()", nameAcceptor, nameRequester);
+
+  preciceCheck(requesterCommunicatorSize > 0,
+               "acceptConnectionAsServer()",
+               "Requester communicator "
+                   << "size has to be > 0!");
+
+  assertion(not isConnected());
+
+  _rank = 0;
+
+  {
+    std::string addressFileName("." + nameRequester + "-" + nameAcceptor +
+                                ".address");
+    std::string controlName = createControlSegment(nameAcceptor, nameRequester);
+
+    Publisher::ScopedChangePrefixDirectory scpd(_addressDirectory);
+
+    ScopedPublisher p(addressFileName);
+
+    p.write(controlName);
+
+    preciceDebug("Accept connection at " << controlName);
+
+    acceptChannels(controlName, requesterCommunicatorSize);
+  }
+
+  for (int remoteRank = 0; remoteRank < _remoteCommunicatorSize; ++remoteRank) {
+    send(remoteRank, remoteRank);
+
+    send(0, remoteRank);
+    send(1, remoteRank);
+  }
+}
+
+void
+SharedMemoryCommunication::requestConnection(std::string const& nameAcceptor,
+                                             std::string const& nameRequester,
+                                             int requesterProcessRank,
+                                             int requesterCommunicatorSize) {
+  preciceTrace2("requestConnection()", nameAcceptor, nameRequester);
+
+  assertion(not isConnected());
+
+  requestChannel(nameAcceptor, nameRequester, requesterProcessRank,
+                 requesterCommunicatorSize);
+
+  _rank = requesterProcessRank;
+
+  int remoteSize = 0;
+  int remoteRank = -1;
+
+  receive(remoteRank, 0);
+  receive(remoteSize, 0);
+
+  preciceCheck(remoteRank == 0,
+               "requestConnection()",
+               "Acceptor base rank "
+                   << "has to be 0 but is " << remoteRank << "!");
+  preciceCheck(remoteSize == 1,
+               "requestConnection()",
+               "Acceptor communicator "
+                   << "size has to be 1!");
+}
+
+int
+SharedMemoryCommunication::requestConnectionAsClient(
+    std::string const& nameAcceptor, std::string const& nameRequester) {
+  preciceTrace2("requestConnectionAsClient()", nameAcceptor, nameRequester);
+
+  assertion(not isConnected());
+
+  requestChannel(nameAcceptor, nameRequester, -1, 0);
+
+  receive(_rank, 0);
+
+  int remoteSize = 0;
+  int remoteRank = -1;
+
+  receive(remoteRank, 0);
+  receive(remoteSize, 0);
+
+  preciceCheck(remoteRank == 0,
+               "requestConnectionAsClient()",
+               "Acceptor base rank "
+                   << "has to be 0 but is " << remoteRank << "!");
+  preciceCheck(remoteSize == 1,
+               "requestConnectionAsClient()",
+               "Acceptor communicator "
+                   << "size has to be 1!");
+
+  return _rank;
+}
+
+void
+SharedMemoryCommunication::closeConnection() {
+  preciceTrace("closeConnection()");
+
+  if (not isConnected())
+    return;
+
+  if (_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(_operationsMutex);
+      _stopThread = true;
+    }
+    _operationsCondition.notify_one();
+    _channels.front()->wakeup->notify();
+    _thread.join();
+  }
+
+  _operations.clear();
+  _channels.clear();
+
+  munmap(_controlSegment, sizeof(ControlLayout));
+  _controlSegment = nullptr;
+
+  _remoteCommunicatorSize = 0;
+  _isConnected = false;
+}
+
+void
+SharedMemoryCommunication::startSendPackage(int rankReceiver) {
+}
+
+void
+SharedMemoryCommunication::finishSendPackage() {
+}
+
+int
+SharedMemoryCommunication::startReceivePackage(int rankSender) {
+  preciceTrace1("startReceivePackage()", rankSender);
+
+  return rankSender;
+}
+
+void
+SharedMemoryCommunication::finishReceivePackage() {
+}
+
+void
+SharedMemoryCommunication::send(std::string const& itemToSend, int rankReceiver) {
+  preciceTrace2("send(string)", itemToSend, rankReceiver);
+
+  size_t size = itemToSend.size() + 1;
+  write(rankReceiver, &size, sizeof(size_t));
+  write(rankReceiver, itemToSend.c_str(), size);
+}
+
+void
+SharedMemoryCommunication::send(int* itemsToSend, int size, int rankReceiver) {
+  preciceTrace2("send(int*)", size, rankReceiver);
+
+  write(rankReceiver, itemsToSend, size * sizeof(int));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aSend(int* itemsToSend, int size, int rankReceiver) {
+  preciceTrace2("aSend(int*)", size, rankReceiver);
+
+  return post(rankReceiver, true, itemsToSend, size * sizeof(int));
+}
+
+void
+SharedMemoryCommunication::send(double* itemsToSend, int size, int rankReceiver) {
+  preciceTrace2("send(double*)", size, rankReceiver);
+
+  write(rankReceiver, itemsToSend, size * sizeof(double));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aSend(double* itemsToSend, int size, int rankReceiver) {
+  preciceTrace2("aSend(double*)", size, rankReceiver);
+
+  return post(rankReceiver, true, itemsToSend, size * sizeof(double));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aSend(float* itemsToSend, int size, int rankReceiver) {
+  preciceTrace2("aSend(float*)", size, rankReceiver);
+
+  return post(rankReceiver, true, itemsToSend, size * sizeof(float));
+}
+
+void
+SharedMemoryCommunication::send(double itemToSend, int rankReceiver) {
+  preciceTrace2("send(double)", itemToSend, rankReceiver);
+
+  write(rankReceiver, &itemToSend, sizeof(double));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aSend(double* itemToSend, int rankReceiver) {
+  return aSend(itemToSend, 1, rankReceiver);
+}
+
+void
+SharedMemoryCommunication::send(int itemToSend, int rankReceiver) {
+  preciceTrace2("send(int)", itemToSend, rankReceiver);
+
+  write(rankReceiver, &itemToSend, sizeof(int));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aSend(int* itemToSend, int rankReceiver) {
+  return aSend(itemToSend, 1, rankReceiver);
+}
+
+void
+SharedMemoryCommunication::send(bool itemToSend, int rankReceiver) {
+  preciceTrace2("send(bool)", itemToSend, rankReceiver);
+
+  write(rankReceiver, &itemToSend, sizeof(bool));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aSend(bool* itemToSend, int rankReceiver) {
+  preciceTrace1("aSend(bool*)", rankReceiver);
+
+  return post(rankReceiver, true, itemToSend, sizeof(bool));
+}
+
+void
+SharedMemoryCommunication::receive(std::string& itemToReceive, int rankSender) {
+  preciceTrace1("receive(string)", rankSender);
+
+  size_t size = 0;
+  read(rankSender, &size, sizeof(size_t));
+  std::vector<char> msg(size);
+  read(rankSender, msg.data(), size);
+  itemToReceive = msg.data();
+}
+
+void
+SharedMemoryCommunication::receive(int* itemsToReceive, int size, int rankSender) {
+  preciceTrace2("receive(int*)", size, rankSender);
+
+  read(rankSender, itemsToReceive, size * sizeof(int));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aReceive(int* itemsToReceive, int size, int rankSender) {
+  preciceTrace2("aReceive(int*)", size, rankSender);
+
+  return post(rankSender, false, itemsToReceive, size * sizeof(int));
+}
+
+void
+SharedMemoryCommunication::receive(double* itemsToReceive, int size, int rankSender) {
+  preciceTrace2("receive(double*)", size, rankSender);
+
+  read(rankSender, itemsToReceive, size * sizeof(double));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aReceive(double* itemsToReceive,
+                                    int size,
+                                    int rankSender) {
+  preciceTrace2("aReceive(double*)", size, rankSender);
+
+  return post(rankSender, false, itemsToReceive, size * sizeof(double));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aReceive(float* itemsToReceive,
+                                    int size,
+                                    int rankSender) {
+  preciceTrace2("aReceive(float*)", size, rankSender);
+
+  return post(rankSender, false, itemsToReceive, size * sizeof(float));
+}
+
+void
+SharedMemoryCommunication::receive(double& itemToReceive, int rankSender) {
+  preciceTrace1("receive(double)", rankSender);
+
+  read(rankSender, &itemToReceive, sizeof(double));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aReceive(double* itemToReceive, int rankSender) {
+  return aReceive(itemToReceive, 1, rankSender);
+}
+
+void
+SharedMemoryCommunication::receive(int& itemToReceive, int rankSender) {
+  preciceTrace1("receive(int)", rankSender);
+
+  read(rankSender, &itemToReceive, sizeof(int));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aReceive(int* itemToReceive, int rankSender) {
+  return aReceive(itemToReceive, 1, rankSender);
+}
+
+void
+SharedMemoryCommunication::receive(bool& itemToReceive, int rankSender) {
+  preciceTrace1("receive(bool)", rankSender);
+
+  read(rankSender, &itemToReceive, sizeof(bool));
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::aReceive(bool* itemToReceive, int rankSender) {
+  preciceTrace1("aReceive(bool*)", rankSender);
+
+  return post(rankSender, false, itemToReceive, sizeof(bool));
+}
+
+std::string
+SharedMemoryCommunication::createControlSegment(std::string const& nameAcceptor,
+                                                std::string const& nameRequester) {
+  preciceTrace2("createControlSegment()", nameAcceptor, nameRequester);
+
+  // Segment names are unique among all connections accepted on this node
+  static int connectionCount = 0;
+
+  std::string name = "/precice-" + nameRequester + "-" + nameAcceptor + "-" +
+                     std::to_string(getpid()) + "-" +
+                     std::to_string(connectionCount++);
+  std::replace(name.begin() + 1, name.end(), '/', '_');
+
+  void* address = mapSegment(name, sizeof(ControlLayout), true);
+
+  preciceCheck(address != nullptr,
+               "createControlSegment()",
+               "Creating shared memory segment " << name
+                                                 << " failed: " << std::strerror(errno));
+
+  ControlLayout* control = new (address) ControlLayout();
+  control->capacity = _bufferSize;
+
+  munmap(address, sizeof(ControlLayout));
+
+  return name;
+}
+
+void
+SharedMemoryCommunication::acceptChannels(std::string const& controlName,
+                                          int requesterCommunicatorSize) {
+  preciceTrace2("acceptChannels()", controlName, requesterCommunicatorSize);
+
+  void* address = mapSegment(controlName, sizeof(ControlLayout), false);
+
+  preciceCheck(address != nullptr,
+               "acceptConnection()",
+               "Opening shared memory segment " << controlName
+                                                << " failed: " << std::strerror(errno));
+
+  ControlLayout* control = static_cast<ControlLayout*>(address);
+
+  // The size is only known to the requesters, if not given
+  auto remoteSize = [&]() -> int {
+    return requesterCommunicatorSize > 0 ? requesterCommunicatorSize
+                                         : control->requesterCommunicatorSize.load();
+  };
+  auto allConnected = [&]() {
+    return (remoteSize() > 0) && ((int)control->connectedCount.load() >= remoteSize());
+  };
+
+  while (not allConnected()) {
+    control->connected.wait(allConnected, WAIT_TIMEOUT);
+  }
+
+  _remoteCommunicatorSize = remoteSize();
+
+  preciceCheck((int)control->connectedCount.load() == _remoteCommunicatorSize,
+               "acceptConnection()",
+               "Remote communicator sizes are inconsistent!");
+
+  for (int remoteRank = 0; remoteRank < _remoteCommunicatorSize; ++remoteRank) {
+    std::string name = channelName(controlName, remoteRank);
+    void* channelAddress = mapSegment(name, ChannelLayout::segmentSize(_bufferSize), false);
+
+    preciceCheck(channelAddress != nullptr,
+                 "acceptConnection()",
+                 "Opening shared memory segment " << name
+                                                  << " failed: " << std::strerror(errno));
+
+    // Both sides have mapped the channel, it is removed when both unmapped it
+    shm_unlink(name.c_str());
+
+    _channels.emplace_back(new Channel(static_cast<ChannelLayout*>(channelAddress), control, true));
+
+    preciceDebug("Accepted connection at " << name);
+  }
+
+  // Kept mapped for the wakeup of the helper thread
+  _controlSegment = address;
+  shm_unlink(controlName.c_str());
+
+  _isConnected = true;
+
+  startThread();
+}
+
+void
+SharedMemoryCommunication::requestChannel(std::string const& nameAcceptor,
+                                          std::string const& nameRequester,
+                                          int requesterProcessRank,
+                                          int requesterCommunicatorSize) {
+  preciceTrace2("requestChannel()", nameAcceptor, nameRequester);
+
+  std::string controlName;
+  std::string addressFileName("." + nameRequester + "-" + nameAcceptor +
+                              ".address");
+
+  {
+    Publisher::ScopedChangePrefixDirectory scpd(_addressDirectory);
+
+    Publisher p(addressFileName);
+
+    p.read(controlName);
+  }
+
+  preciceDebug("Request connection to " << controlName);
+
+  void* address = mapSegment(controlName, sizeof(ControlLayout), false);
+
+  preciceCheck(address != nullptr,
+               "requestConnection()",
+               "Opening shared memory segment " << controlName
+                                                << " failed: " << std::strerror(errno));
+
+  ControlLayout* control = static_cast<ControlLayout*>(address);
+
+  if (requesterProcessRank < 0) {
+    requesterProcessRank = control->requests.fetch_add(1);
+  }
+
+  size_t capacity = control->capacity;
+  std::string name = channelName(controlName, requesterProcessRank);
+  void* channelAddress = mapSegment(name, ChannelLayout::segmentSize(capacity), true);
+
+  preciceCheck(channelAddress != nullptr,
+               "requestConnection()",
+               "Creating shared memory segment " << name
+                                                 << " failed: " << std::strerror(errno));
+
+  ChannelLayout* layout = new (channelAddress) ChannelLayout();
+  layout->capacity = capacity;
+
+  _channels.emplace_back(new Channel(layout, control, false));
+  _remoteCommunicatorSize = 1;
+  _isConnected = true;
+
+  if (requesterCommunicatorSize > 0) {
+    control->requesterCommunicatorSize.store(requesterCommunicatorSize);
+  }
+  control->connectedCount.fetch_add(1);
+  control->connected.notify();
+
+  // Kept mapped for the wakeup of the acceptor's helper thread
+  _controlSegment = address;
+
+  preciceDebug("Requested connection to " << name);
+
+  startThread();
+}
+
+SharedMemoryCommunication::Channel&
+SharedMemoryCommunication::channel(int rank) {
+  rank = rank - _rankOffset;
+
+  assertion((rank >= 0) && (rank < (int)_channels.size()),
+            rank,
+            _channels.size());
+  assertion(isConnected());
+
+  return *_channels[rank];
+}
+
+void
+SharedMemoryCommunication::write(int rankReceiver, void const* data, size_t size) {
+  Channel& c = channel(rankReceiver);
+
+  {
+    // Messages are kept in order of posting
+    std::unique_lock<std::mutex> lock(_operationsMutex);
+    if (c.pendingSends > 0) {
+      lock.unlock();
+      post(rankReceiver, true, const_cast<void*>(data), size)->wait();
+      return;
+    }
+  }
+
+  char const* bytes = static_cast<char const*>(data);
+  while (size > 0) {
+    size_t count = c.send(bytes, size);
+    bytes += count;
+    size -= count;
+    if ((size > 0) && (count == 0)) {
+      c.signal(true).wait([&c] { return c.canProgress(true); }, WAIT_TIMEOUT);
+    }
+  }
+}
+
+void
+SharedMemoryCommunication::read(int rankSender, void* data, size_t size) {
+  Channel& c = channel(rankSender);
+
+  {
+    std::unique_lock<std::mutex> lock(_operationsMutex);
+    if (c.pendingReceives > 0) {
+      lock.unlock();
+      post(rankSender, false, data, size)->wait();
+      return;
+    }
+  }
+
+  char* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    size_t count = c.receive(bytes, size);
+    bytes += count;
+    size -= count;
+    if ((size > 0) && (count == 0)) {
+      c.signal(false).wait([&c] { return c.canProgress(false); }, WAIT_TIMEOUT);
+    }
+  }
+}
+
+Request::SharedPointer
+SharedMemoryCommunication::post(int rank, bool isSend, void* data, size_t size) {
+  Channel& c = channel(rank);
+  char* bytes = static_cast<char*>(data);
+
+  std::lock_guard<std::mutex> lock(_operationsMutex);
+  int& pending = isSend ? c.pendingSends : c.pendingReceives;
+
+  // Fast path, the operation is completed right away
+  if (pending == 0) {
+    size_t count = isSend ? c.send(bytes, size) : c.receive(bytes, size);
+    bytes += count;
+    size -= count;
+    if (size == 0) {
+      return Request::SharedPointer(new SharedMemoryRequest(true));
+    }
+  }
+
+  Request::SharedPointer request(new SharedMemoryRequest);
+  _operations.push_back(Operation{&c, isSend, bytes, size, request});
+  pending++;
+
+  _operationsCondition.notify_one();
+  c.wakeup->notify();
+
+  return request;
+}
+
+void
+SharedMemoryCommunication::startThread() {
+  _stopThread = false;
+  _thread = std::thread([this]() { progressOperations(); });
+}
+
+void
+SharedMemoryCommunication::progressOperations() {
+  Signal& wakeup = *_channels.front()->wakeup;
+  std::unique_lock<std::mutex> lock(_operationsMutex);
+
+  while (true) {
+    _operationsCondition.wait(lock, [this] {
+      return _stopThread || (not _operations.empty());
+    });
+
+    if (_stopThread) {
+      break;
+    }
+
+    // Every later transfer or posted operation changes the sequence
+    std::uint32_t sequence = wakeup.sequence.load();
+
+    // Only the first pending operation per channel and direction may progress
+    bool hasProgressed = false;
+    std::vector<std::pair<Channel*, bool>> blocked;
+
+    for (auto it = _operations.begin(); it != _operations.end();) {
+      std::pair<Channel*, bool> key(it->channel, it->isSend);
+
+      if (std::find(blocked.begin(), blocked.end(), key) != blocked.end()) {
+        ++it;
+        continue;
+      }
+
+      size_t count = it->isSend ? it->channel->send(it->data, it->size)
+                                : it->channel->receive(it->data, it->size);
+      it->data += count;
+      it->size -= count;
+      hasProgressed |= count > 0;
+
+      if (it->size == 0) {
+        (it->isSend ? it->channel->pendingSends : it->channel->pendingReceives)--;
+        static_cast<SharedMemoryRequest*>(it->request.get())->complete();
+        it = _operations.erase(it);
+      } else {
+        blocked.push_back(key);
+        ++it;
+      }
+    }
+
+    if ((not hasProgressed) && (not _operations.empty())) {
+      lock.unlock();
+      wakeup.wait([&wakeup, sequence] { return wakeup.sequence.load() != sequence; },
+                  WAIT_TIMEOUT);
+      lock.lock();
+    }
+  }
+}
+}
+} // namespace precice, com
+
+#endif // not PRECICE_NO_SHARED_MEMORY
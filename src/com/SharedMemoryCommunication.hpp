@@ -0,0 +1,339 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at
+// http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SHARED_MEMORY
+
+#ifndef PRECICE_COM_SHARED_MEMORY_COMMUNICATION_HPP_
+#define PRECICE_COM_SHARED_MEMORY_COMMUNICATION_HPP_
+
+#include "com/Communication.hpp"
+
+#include "tarch/logging/Log.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace precice {
+namespace com {
+/**
+ * @brief Implements Communication by using POSIX shared memory.
+ *
+ * Can only be used, if both participants run on the same node. Every
+ * connection between the acceptor and one requester process is a shared memory
+ * segment with one ring buffer per direction. Messages are copied into the
+ * ring buffer by the sender and out of it by the receiver. Waiting processes
+ * sleep on futexes located in the segment, which are woken by the peer.
+ *
+ * Asynchronous operations, which cannot be completed right away, are
+ * progressed by a helper thread. It sleeps on one futex per process, which
+ * every transfer on any of its channels notifies.
+ */
+class SharedMemoryCommunication : public Communication {
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param addressDirectory [IN] Directory where the segment name is exchanged.
+   * @param bufferSize [IN] Size of each ring buffer in bytes.
+   */
+  SharedMemoryCommunication(std::string const& addressDirectory = ".",
+                            size_t bufferSize = 1 << 20);
+
+  /**
+   * @brief Destructor.
+   */
+  virtual ~SharedMemoryCommunication();
+
+  /**
+   * @brief Returns true, if a connection to a remote participant has been
+   * setup.
+   */
+  virtual bool isConnected();
+
+  /**
+   * @brief Returns the number of processes in the remote communicator.
+   *
+   * Precondition: a connection to the remote participant has been setup.
+   */
+  virtual size_t getRemoteCommunicatorSize();
+
+  /**
+   * @brief Accepts connection from participant, which has to call
+   *requestConnection().
+   *
+   * If several connections are going in to a server, the server has to call
+   *this
+   * method, while the clients have to call requestConnection().
+   *
+   * @param nameAcceptor [IN] Name of calling participant.
+   * @param nameRequester [IN] Name of remote participant to connect to.
+   */
+  virtual void acceptConnection(std::string const& nameAcceptor,
+                                std::string const& nameRequester,
+                                int acceptorProcessRank,
+                                int acceptorCommunicatorSize);
+
+  virtual void acceptConnectionAsServer(std::string const& nameAcceptor,
+                                        std::string const& nameRequester,
+                                        int requesterCommunicatorSize);
+
+  /**
+   * @brief Requests connection from participant, which has to call
+   *acceptConnection().
+   *
+   * If several connections are going in to a server, the clients have to call
+   *this
+   * method, while the server has to call acceptConnection().
+   *
+   * @param nameAcceptor [IN] Name of remote participant to connect to.
+   * @param nameReuester [IN] Name of calling participant.
+   */
+  virtual void requestConnection(std::string const& nameAcceptor,
+                                 std::string const& nameRequester,
+                                 int requesterProcessRank,
+                                 int requesterCommunicatorSize);
+
+  virtual int requestConnectionAsClient(std::string const& nameAcceptor,
+                                        std::string const& nameRequester);
+
+  /**
+   * @brief Disconnects from communication space, i.e. participant.
+   *
+   * This method is called on destruction.
+   */
+  virtual void closeConnection();
+
+  /**
+   * @brief Is empty.
+   */
+  virtual void startSendPackage(int rankReceiver);
+
+  /**
+   * @brief Is empty.
+   */
+  virtual void finishSendPackage();
+
+  /**
+   * @brief Just returns rank of sender.
+   */
+  virtual int startReceivePackage(int rankSender);
+
+  /**
+   * @brief Is empty.
+   */
+  virtual void finishReceivePackage();
+
+  /**
+   * @brief Sends a std::string to process with given rank.
+   */
+  virtual void send(std::string const& itemToSend, int rankReceiver);
+
+  /**
+   * @brief Sends an array of integer values.
+   */
+  virtual void send(int* itemsToSend, int size, int rankReceiver);
+
+  /**
+   * @brief Asynchronously sends an array of integer values.
+   */
+  virtual Request::SharedPointer aSend(int* itemsToSend,
+                                       int size,
+                                       int rankReceiver);
+
+  /**
+   * @brief Sends an array of double values.
+   */
+  virtual void send(double* itemsToSend, int size, int rankReceiver);
+
+  /**
+   * @brief Asynchronously sends an array of double values.
+   */
+  virtual Request::SharedPointer aSend(double* itemsToSend,
+                                       int size,
+                                       int rankReceiver);
+
+  /**
+   * @brief Asynchronously sends an array of single precision values.
+   */
+  virtual Request::SharedPointer aSend(float* itemsToSend,
+                                       int size,
+                                       int rankReceiver);
+
+  /**
+   * @brief Sends a double to process with given rank.
+   */
+  virtual void send(double itemToSend, int rankReceiver);
+
+  /**
+   * @brief Asynchronously sends a double to process with given rank.
+   */
+  virtual Request::SharedPointer aSend(double* itemToSend, int rankReceiver);
+
+  /**
+   * @brief Sends an int to process with given rank.
+   */
+  virtual void send(int itemToSend, int rankReceiver);
+
+  /**
+   * @brief Asynchronously sends an int to process with given rank.
+   */
+  virtual Request::SharedPointer aSend(int* itemToSend, int rankReceiver);
+
+  /**
+   * @brief Sends a bool to process with given rank.
+   */
+  virtual void send(bool itemToSend, int rankReceiver);
+
+  /**
+   * @brief Asynchronously sends a bool to process with given rank.
+   */
+  virtual Request::SharedPointer aSend(bool* itemToSend, int rankReceiver);
+
+  /**
+   * @brief Receives a std::string from process with given rank.
+   */
+  virtual void receive(std::string& itemToReceive, int rankSender);
+
+  /**
+   * @brief Receives an array of integer values.
+   */
+  virtual void receive(int* itemsToReceive, int size, int rankSender);
+
+  /**
+   * @brief Asynchronously receives an array of integer values.
+   */
+  virtual Request::SharedPointer aReceive(int* itemsToReceive,
+                                          int size,
+                                          int rankSender);
+
+  /**
+   * @brief Receives an array of double values.
+   */
+  virtual void receive(double* itemsToReceive, int size, int rankSender);
+
+  /**
+   * @brief Asynchronously receives an array of double values.
+   */
+  virtual Request::SharedPointer aReceive(double* itemsToReceive,
+                                          int size,
+                                          int rankSender);
+
+  /**
+   * @brief Asynchronously receives an array of single precision values.
+   */
+  virtual Request::SharedPointer aReceive(float* itemsToReceive,
+                                          int size,
+                                          int rankSender);
+
+  /**
+   * @brief Receives a double from process with given rank.
+   */
+  virtual void receive(double& itemToReceive, int rankSender);
+
+  /**
+   * @brief Asynchronously receives a double from process with given rank.
+   */
+  virtual Request::SharedPointer aReceive(double* itemToReceive,
+                                          int rankSender);
+
+  /**
+   * @brief Receives an int from process with given rank.
+   */
+  virtual void receive(int& itemToReceive, int rankSender);
+
+  /**
+   * @brief Asynchronously receives an int from process with given rank.
+   */
+  virtual Request::SharedPointer aReceive(int* itemToReceive, int rankSender);
+
+  /**
+   * @brief Receives a bool from process with given rank.
+   */
+  virtual void receive(bool& itemToReceive, int rankSender);
+
+  /**
+   * @brief Asynchronously receives a bool from process with given rank.
+   */
+  virtual Request::SharedPointer aReceive(bool* itemToReceive, int rankSender);
+
+private:
+  static tarch::logging::Log _log;
+
+  /// Connection to one remote process, defined in the implementation.
+  struct Channel;
+
+  /// Pending asynchronous send or receive.
+  struct Operation {
+    Channel* channel;
+    bool isSend;
+    char* data;
+    size_t size;
+    std::shared_ptr<Request> request;
+  };
+
+  // @brief Directory where the segment name is exchanged by file.
+  std::string _addressDirectory;
+
+  size_t _bufferSize;
+
+  bool _isConnected;
+
+  int _remoteCommunicatorSize;
+
+  std::vector<std::unique_ptr<Channel>> _channels;
+
+  /// Segment the requesters connected by, holds the wakeup of the acceptor.
+  void* _controlSegment;
+
+  /// Operations progressed by _thread, in order of posting.
+  std::deque<Operation> _operations;
+
+  std::mutex _operationsMutex;
+
+  std::condition_variable _operationsCondition;
+
+  bool _stopThread;
+
+  std::thread _thread;
+
+  /// Creates the segment requesters connect to and publishes its name.
+  std::string createControlSegment(std::string const& nameAcceptor,
+                                   std::string const& nameRequester);
+
+  /// Waits for all requesters and maps their channels.
+  void acceptChannels(std::string const& controlName, int requesterCommunicatorSize);
+
+  /// Creates the channel of the requester with given rank.
+  void requestChannel(std::string const& nameAcceptor,
+                      std::string const& nameRequester,
+                      int requesterProcessRank,
+                      int requesterCommunicatorSize);
+
+  Channel& channel(int rank);
+
+  /// Blocking send of raw bytes.
+  void write(int rankReceiver, void const* data, size_t size);
+
+  /// Blocking receive of raw bytes.
+  void read(int rankSender, void* data, size_t size);
+
+  /// Posts an asynchronous operation, which is completed right away if possible.
+  Request::SharedPointer post(int rank, bool isSend, void* data, size_t size);
+
+  void startThread();
+
+  void progressOperations();
+};
+}
+} // namespace precice, com
+
+#endif /* PRECICE_COM_SHARED_MEMORY_COMMUNICATION_HPP_ */
+
+#endif // not PRECICE_NO_SHARED_MEMORY
@@ -0,0 +1,36 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at
+// http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SHARED_MEMORY
+
+#include "SharedMemoryCommunicationFactory.hpp"
+
+#include "SharedMemoryCommunication.hpp"
+
+namespace precice {
+namespace com {
+SharedMemoryCommunicationFactory::SharedMemoryCommunicationFactory(
+    std::string const& addressDirectory, size_t bufferSize)
+    : _addressDirectory(addressDirectory)
+    , _bufferSize(bufferSize) {
+  if (_addressDirectory.empty()) {
+    _addressDirectory = ".";
+  }
+}
+
+Communication::SharedPointer
+SharedMemoryCommunicationFactory::newCommunication() {
+  return Communication::SharedPointer(
+      new SharedMemoryCommunication(_addressDirectory, _bufferSize));
+}
+
+std::string
+SharedMemoryCommunicationFactory::addressDirectory() {
+  return _addressDirectory;
+}
+}
+} // namespace precice, com
+
+#endif // not PRECICE_NO_SHARED_MEMORY
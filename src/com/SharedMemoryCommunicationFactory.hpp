@@ -0,0 +1,35 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at
+// http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SHARED_MEMORY
+
+#ifndef PRECICE_COM_SHARED_MEMORY_COMMUNICATION_FACTORY_HPP_
+#define PRECICE_COM_SHARED_MEMORY_COMMUNICATION_FACTORY_HPP_
+
+#include "CommunicationFactory.hpp"
+
+#include <string>
+
+namespace precice {
+namespace com {
+class SharedMemoryCommunicationFactory : public CommunicationFactory {
+public:
+  SharedMemoryCommunicationFactory(std::string const& addressDirectory = ".",
+                                   size_t bufferSize = 1 << 20);
+
+  Communication::SharedPointer newCommunication();
+
+  std::string addressDirectory();
+
+private:
+  std::string _addressDirectory;
+  size_t _bufferSize;
+};
+}
+} // namespace precice, com
+
+#endif /* PRECICE_COM_SHARED_MEMORY_COMMUNICATION_FACTORY_HPP_ */
+
+#endif // not PRECICE_NO_SHARED_MEMORY
@@ -0,0 +1,42 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at
+// http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SHARED_MEMORY
+
+#include "SharedMemoryRequest.hpp"
+
+namespace precice {
+namespace com {
+SharedMemoryRequest::SharedMemoryRequest(bool complete) : _complete(complete) {
+}
+
+void
+SharedMemoryRequest::complete() {
+  {
+    std::lock_guard<std::mutex> lock(_completeMutex);
+
+    _complete = true;
+  }
+
+  _completeCondition.notify_one();
+}
+
+bool
+SharedMemoryRequest::test() {
+  std::lock_guard<std::mutex> lock(_completeMutex);
+
+  return _complete;
+}
+
+void
+SharedMemoryRequest::wait() {
+  std::unique_lock<std::mutex> lock(_completeMutex);
+
+  _completeCondition.wait(lock, [this] { return _complete; });
+}
+}
+} // namespace precice, com
+
+#endif // not PRECICE_NO_SHARED_MEMORY
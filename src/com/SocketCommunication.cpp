@@ -6,6 +6,7 @@
 
 #include "SocketCommunication.hpp"
 
+#include "SocketIOService.hpp"
 #include "SocketRequest.hpp"
 
 #include "utils/Publisher.hpp"
@@ -13,6 +14,7 @@
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 using precice::utils::Publisher;
@@ -23,23 +25,40 @@ namespace com {
 
 namespace asio = boost::asio;
 
+namespace {
+
+/// Sends up to this size are copied into a send package, larger ones are
+/// written directly together with the collected data.
+const size_t MAX_PACKAGE_ITEM_SIZE = 4096;
+
+/// A send package is written as soon as it reaches this size.
+const size_t MAX_PACKAGE_SIZE = 65536;
+
+/// Bounds of the wait in milliseconds between two attempts to connect.
+const int MIN_CONNECT_WAIT = 1;
+const int MAX_CONNECT_WAIT = 100;
+
+}
+
 tarch::logging::Log SocketCommunication::_log(
     "precice::com::SocketCommunication");
 
 SocketCommunication::SocketCommunication(unsigned short portNumber,
                                          bool reuseAddress,
                                          std::string const& networkName,
-                                         std::string const& addressDirectory)
+                                         std::string const& addressDirectory,
+                                         int bufferSize)
     : _portNumber(portNumber)
     , _reuseAddress(reuseAddress)
     , _networkName(networkName)
     , _addressDirectory(addressDirectory)
+    , _bufferSize(bufferSize)
     , _isConnected(false)
     , _remoteCommunicatorSize(0)
-    , _ioService(new IOService)
+    , _ioService(SocketIOService::get())
     , _sockets()
-    , _work()
-    , _thread() {
+    , _packageSocket(-1)
+    , _packageBuffer() {
   if (_addressDirectory.empty()) {
     _addressDirectory = ".";
   }
@@ -123,6 +142,7 @@ SocketCommunication::acceptConnection(std::string const& nameAcceptor,
     PtrSocket socket(new Socket(*_ioService));
 
     acceptor.accept(*socket);
+    configureSocket(*socket);
 
     preciceDebug("Accepted connection at " << address);
 
@@ -145,13 +165,16 @@ SocketCommunication::acceptConnection(std::string const& nameAcceptor,
 
     _isConnected = true;
 
+    startSendPackage(remoteRank);
     send(acceptorProcessRank, remoteRank);
     send(acceptorCommunicatorSize, remoteRank);
+    finishSendPackage();
 
     for (int i = 1; i < _remoteCommunicatorSize; ++i) {
       socket = PtrSocket(new Socket(*_ioService));
 
       acceptor.accept(*socket);
+      configureSocket(*socket);
 
       preciceDebug("Accepted connection at " << address);
 
@@ -169,8 +192,10 @@ SocketCommunication::acceptConnection(std::string const& nameAcceptor,
 
       _isConnected = true;
 
+      startSendPackage(remoteRank);
       send(acceptorProcessRank, remoteRank);
       send(acceptorCommunicatorSize, remoteRank);
+      finishSendPackage();
     }
 
     acceptor.close();
@@ -179,12 +204,6 @@ SocketCommunication::acceptConnection(std::string const& nameAcceptor,
                  "Accepting connection at " << address
                                             << " failed: " << e.what());
   }
-
-  // NOTE:
-  // Keep IO service running so that it fires asynchronous handlers from another
-  // thread.
-  _work = PtrWork(new asio::io_service::work(*_ioService));
-  _thread = std::thread([this]() { _ioService->run(); });
 }
 
 void
@@ -247,6 +266,7 @@ SocketCommunication::acceptConnectionAsServer(std::string const& nameAcceptor,
       PtrSocket socket = PtrSocket(new Socket(*_ioService));
 
       acceptor.accept(*socket);
+      configureSocket(*socket);
 
       preciceDebug("Accepted connection at " << address);
 
@@ -259,10 +279,11 @@ SocketCommunication::acceptConnectionAsServer(std::string const& nameAcceptor,
 
       _isConnected = true;
 
+      startSendPackage(remoteRank);
       send(remoteRank, remoteRank);
-
       send(0, remoteRank);
       send(1, remoteRank);
+      finishSendPackage();
     }
 
     acceptor.close();
@@ -271,12 +292,6 @@ SocketCommunication::acceptConnectionAsServer(std::string const& nameAcceptor,
                  "Accepting connection at " << address
                                             << " failed: " << e.what());
   }
-
-  // NOTE:
-  // Keep IO service running so that it fires asynchronous handlers from another
-  // thread.
-  _work = PtrWork(new asio::io_service::work(*_ioService));
-  _thread = std::thread([this]() { _ioService->run(); });
 }
 
 void
@@ -312,12 +327,13 @@ SocketCommunication::requestConnection(std::string const& nameAcceptor,
     using asio::ip::tcp;
 
     tcp::resolver::query query(tcp::v4(), ipAddress, portNumber);
+    tcp::resolver resolver(*_ioService);
+    tcp::resolver::endpoint_type endpoint = *(resolver.resolve(query));
 
-    while (not isConnected()) {
-      tcp::resolver resolver(*_ioService);
+    int wait = MIN_CONNECT_WAIT;
 
+    while (not isConnected()) {
       {
-        tcp::resolver::endpoint_type endpoint = *(resolver.resolve(query));
         boost::system::error_code error = asio::error::host_not_found;
         socket->connect(endpoint, error);
 
@@ -327,20 +343,26 @@ SocketCommunication::requestConnection(std::string const& nameAcceptor,
       if (not isConnected()) {
         // Wait a little, since after a couple of ten-thousand trials the system
         // seems to get confused and the requester connects wrongly to itself.
+        // The wait grows, such that a busy acceptor is not flooded.
         boost::asio::deadline_timer timer(*_ioService,
-                                          boost::posix_time::milliseconds(1));
+                                          boost::posix_time::milliseconds(wait));
         timer.wait();
+        wait = std::min(2 * wait, MAX_CONNECT_WAIT);
       }
     }
 
     preciceDebug("Requested connection to " << address);
 
+    configureSocket(*socket);
+
     _sockets.push_back(socket);
 
     _rank = requesterProcessRank;
 
+    startSendPackage(0);
     send(requesterProcessRank, 0);
     send(requesterCommunicatorSize, 0);
+    finishSendPackage();
 
     int remoteSize = 0;
     int remoteRank = -1;
@@ -363,12 +385,6 @@ SocketCommunication::requestConnection(std::string const& nameAcceptor,
                  "Requesting connection to " << address
                                              << " failed: " << e.what());
   }
-
-  // NOTE:
-  // Keep IO service running so that it fires asynchronous handlers from another
-  // thread.
-  _work = PtrWork(new asio::io_service::work(*_ioService));
-  _thread = std::thread([this]() { _ioService->run(); });
 }
 
 int
@@ -402,12 +418,13 @@ SocketCommunication::requestConnectionAsClient(
     using asio::ip::tcp;
 
     tcp::resolver::query query(tcp::v4(), ipAddress, portNumber);
+    tcp::resolver resolver(*_ioService);
+    tcp::resolver::endpoint_type endpoint = *(resolver.resolve(query));
 
-    while (not isConnected()) {
-      tcp::resolver resolver(*_ioService);
+    int wait = MIN_CONNECT_WAIT;
 
+    while (not isConnected()) {
       {
-        tcp::resolver::endpoint_type endpoint = *(resolver.resolve(query));
         boost::system::error_code error = asio::error::host_not_found;
         socket->connect(endpoint, error);
 
@@ -417,14 +434,18 @@ SocketCommunication::requestConnectionAsClient(
       if (not isConnected()) {
         // Wait a little, since after a couple of ten-thousand trials the system
         // seems to get confused and the requester connects wrongly to itself.
+        // The wait grows, such that a busy acceptor is not flooded.
         boost::asio::deadline_timer timer(*_ioService,
-                                          boost::posix_time::milliseconds(1));
+                                          boost::posix_time::milliseconds(wait));
         timer.wait();
+        wait = std::min(2 * wait, MAX_CONNECT_WAIT);
       }
     }
 
     preciceDebug("Requested connection to " << address);
 
+    configureSocket(*socket);
+
     _sockets.push_back(socket);
 
     receive(_rank, 0);
@@ -451,12 +472,6 @@ SocketCommunication::requestConnectionAsClient(
                                              << " failed: " << e.what());
   }
 
-  // NOTE:
-  // Keep IO service running so that it fires asynchronous handlers from another
-  // thread.
-  _work = PtrWork(new asio::io_service::work(*_ioService));
-  _thread = std::thread([this]() { _ioService->run(); });
-
   return _rank;
 }
 
@@ -467,11 +482,12 @@ SocketCommunication::closeConnection() {
   if (not isConnected())
     return;
 
-  if (_thread.joinable()) {
-    _work.reset();
-    _ioService->stop();
-    _thread.join();
+  try {
+    flushPackage();
+  } catch (std::exception& e) {
+    preciceError("closeConnection()", "Send failed: " << e.what());
   }
+  _packageSocket = -1;
 
   for (PtrSocket& socket : _sockets) {
     assertion(socket->is_open());
@@ -485,10 +501,37 @@ SocketCommunication::closeConnection() {
 
 void
 SocketCommunication::startSendPackage(int rankReceiver) {
+  preciceTrace1("startSendPackage()", rankReceiver);
+
+  try {
+    flushPackage();
+  } catch (std::exception& e) {
+    preciceError("startSendPackage()", "Send failed: " << e.what());
+  }
+  _packageSocket = rankReceiver - _rankOffset;
 }
 
 void
 SocketCommunication::finishSendPackage() {
+  preciceTrace("finishSendPackage()");
+
+  try {
+    flushPackage();
+  } catch (std::exception& e) {
+    preciceError("finishSendPackage()", "Send failed: " << e.what());
+  }
+  _packageSocket = -1;
+}
+
+void
+SocketCommunication::flushSendPackage() {
+  preciceTrace("flushSendPackage()");
+
+  try {
+    flushPackage();
+  } catch (std::exception& e) {
+    preciceError("flushSendPackage()", "Send failed: " << e.what());
+  }
 }
 
 int
@@ -515,9 +558,9 @@ SocketCommunication::send(std::string const& itemToSend, int rankReceiver) {
 
   size_t size = itemToSend.size() + 1;
   try {
-    asio::write(*_sockets[rankReceiver], asio::buffer(&size, sizeof(size_t)));
-    asio::write(*_sockets[rankReceiver],
-                asio::buffer(itemToSend.c_str(), size));
+    write(rankReceiver,
+          {asio::buffer(&size, sizeof(size_t)),
+           asio::buffer(itemToSend.c_str(), size)});
   } catch (std::exception& e) {
     preciceError("send(string)", "Send failed: " << e.what());
   }
@@ -535,8 +578,7 @@ SocketCommunication::send(int* itemsToSend, int size, int rankReceiver) {
   assertion(isConnected());
 
   try {
-    asio::write(*_sockets[rankReceiver],
-                asio::buffer(itemsToSend, size * sizeof(int)));
+    write(rankReceiver, {asio::buffer(itemsToSend, size * sizeof(int))});
   } catch (std::exception& e) {
     preciceError("send(int*)", "Send failed: " << e.what());
   }
@@ -556,9 +598,11 @@ SocketCommunication::aSend(int* itemsToSend, int size, int rankReceiver) {
   Request::SharedPointer request(new SocketRequest);
 
   try {
-    asio::async_write(*_sockets[rankReceiver],
+    flushPackage();
+    PtrSocket socket = _sockets[rankReceiver];
+    asio::async_write(*socket,
                       asio::buffer(itemsToSend, size * sizeof(int)),
-                      [request](boost::system::error_code const&, std::size_t) {
+                      [request, socket](boost::system::error_code const&, std::size_t) {
       static_cast<SocketRequest*>(request.get())->complete();
     });
   } catch (std::exception& e) {
@@ -580,8 +624,7 @@ SocketCommunication::send(double* itemsToSend, int size, int rankReceiver) {
   assertion(isConnected());
 
   try {
-    asio::write(*_sockets[rankReceiver],
-                asio::buffer(itemsToSend, size * sizeof(double)));
+    write(rankReceiver, {asio::buffer(itemsToSend, size * sizeof(double))});
   } catch (std::exception& e) {
     preciceError("send(double*)", "Send failed: " << e.what());
   }
@@ -601,9 +644,11 @@ SocketCommunication::aSend(double* itemsToSend, int size, int rankReceiver) {
   Request::SharedPointer request(new SocketRequest);
 
   try {
-    asio::async_write(*_sockets[rankReceiver],
+    flushPackage();
+    PtrSocket socket = _sockets[rankReceiver];
+    asio::async_write(*socket,
                       asio::buffer(itemsToSend, size * sizeof(double)),
-                      [request](boost::system::error_code const&, std::size_t) {
+                      [request, socket](boost::system::error_code const&, std::size_t) {
       static_cast<SocketRequest*>(request.get())->complete();
     });
   } catch (std::exception& e) {
@@ -613,6 +658,34 @@ SocketCommunication::aSend(double* itemsToSend, int size, int rankReceiver) {
   return request;
 }
 
+Request::SharedPointer
+SocketCommunication::aSend(float* itemsToSend, int size, int rankReceiver) {
+  preciceTrace2("aSend(float*)", size, rankReceiver);
+
+  rankReceiver = rankReceiver - _rankOffset;
+
+  assertion((rankReceiver >= 0) && (rankReceiver < (int)_sockets.size()),
+             rankReceiver,
+             _sockets.size());
+  assertion(isConnected());
+
+  Request::SharedPointer request(new SocketRequest);
+
+  try {
+    flushPackage();
+    PtrSocket socket = _sockets[rankReceiver];
+    asio::async_write(*socket,
+                      asio::buffer(itemsToSend, size * sizeof(float)),
+                      [request, socket](boost::system::error_code const&, std::size_t) {
+      static_cast<SocketRequest*>(request.get())->complete();
+    });
+  } catch (std::exception& e) {
+    preciceError("aSend(float*)", "Send failed: " << e.what());
+  }
+
+  return request;
+}
+
 void
 SocketCommunication::send(double itemToSend, int rankReceiver) {
   preciceTrace2("send(double)", itemToSend, rankReceiver);
@@ -625,8 +698,7 @@ SocketCommunication::send(double itemToSend, int rankReceiver) {
   assertion(isConnected());
 
   try {
-    asio::write(*_sockets[rankReceiver],
-                asio::buffer(&itemToSend, sizeof(double)));
+    write(rankReceiver, {asio::buffer(&itemToSend, sizeof(double))});
   } catch (std::exception& e) {
     preciceError("send(double)", "Send failed: " << e.what());
   }
@@ -649,8 +721,7 @@ SocketCommunication::send(int itemToSend, int rankReceiver) {
   assertion(isConnected());
 
   try {
-    asio::write(*_sockets[rankReceiver],
-                asio::buffer(&itemToSend, sizeof(int)));
+    write(rankReceiver, {asio::buffer(&itemToSend, sizeof(int))});
   } catch (std::exception& e) {
     preciceError("send(int)", "Send failed: " << e.what());
   }
@@ -673,8 +744,7 @@ SocketCommunication::send(bool itemToSend, int rankReceiver) {
   assertion(isConnected());
 
   try {
-    asio::write(*_sockets[rankReceiver],
-                asio::buffer(&itemToSend, sizeof(bool)));
+    write(rankReceiver, {asio::buffer(&itemToSend, sizeof(bool))});
   } catch (std::exception& e) {
     preciceError("send(double)", "Send failed: " << e.what());
   }
@@ -694,9 +764,11 @@ SocketCommunication::aSend(bool* itemToSend, int rankReceiver) {
   Request::SharedPointer request(new SocketRequest);
 
   try {
-    asio::async_write(*_sockets[rankReceiver],
+    flushPackage();
+    PtrSocket socket = _sockets[rankReceiver];
+    asio::async_write(*socket,
                       asio::buffer(itemToSend, sizeof(bool)),
-                      [request](boost::system::error_code const&, std::size_t) {
+                      [request, socket](boost::system::error_code const&, std::size_t) {
       static_cast<SocketRequest*>(request.get())->complete();
     });
   } catch (std::exception& e) {
@@ -720,6 +792,7 @@ SocketCommunication::receive(std::string& itemToReceive, int rankSender) {
   size_t size = 0;
 
   try {
+    flushPackage();
     asio::read(*_sockets[rankSender], asio::buffer(&size, sizeof(size_t)));
     char* msg = new char[size];
     asio::read(*_sockets[rankSender], asio::buffer(msg, size));
@@ -742,6 +815,7 @@ SocketCommunication::receive(int* itemsToReceive, int size, int rankSender) {
   assertion(isConnected());
 
   try {
+    flushPackage();
     asio::read(*_sockets[rankSender],
                asio::buffer(itemsToReceive, size * sizeof(int)));
   } catch (std::exception& e) {
@@ -763,9 +837,11 @@ SocketCommunication::aReceive(int* itemsToReceive, int size, int rankSender) {
   Request::SharedPointer request(new SocketRequest);
 
   try {
-    asio::async_read(*_sockets[rankSender],
+    flushPackage();
+    PtrSocket socket = _sockets[rankSender];
+    asio::async_read(*socket,
                      asio::buffer(itemsToReceive, size * sizeof(int)),
-                     [request](boost::system::error_code const&, std::size_t) {
+                     [request, socket](boost::system::error_code const&, std::size_t) {
       static_cast<SocketRequest*>(request.get())->complete();
     });
   } catch (std::exception& e) {
@@ -787,6 +863,7 @@ SocketCommunication::receive(double* itemsToReceive, int size, int rankSender) {
   assertion(isConnected());
 
   try {
+    flushPackage();
     asio::read(*_sockets[rankSender],
                asio::buffer(itemsToReceive, size * sizeof(double)));
   } catch (std::exception& e) {
@@ -810,9 +887,11 @@ SocketCommunication::aReceive(double* itemsToReceive,
   Request::SharedPointer request(new SocketRequest);
 
   try {
-    asio::async_read(*_sockets[rankSender],
+    flushPackage();
+    PtrSocket socket = _sockets[rankSender];
+    asio::async_read(*socket,
                      asio::buffer(itemsToReceive, size * sizeof(double)),
-                     [request](boost::system::error_code const&, std::size_t) {
+                     [request, socket](boost::system::error_code const&, std::size_t) {
       static_cast<SocketRequest*>(request.get())->complete();
     });
   } catch (std::exception& e) {
@@ -822,6 +901,36 @@ SocketCommunication::aReceive(double* itemsToReceive,
   return request;
 }
 
+Request::SharedPointer
+SocketCommunication::aReceive(float* itemsToReceive,
+                              int size,
+                              int rankSender) {
+  preciceTrace2("aReceive(float*)", size, rankSender);
+
+  rankSender = rankSender - _rankOffset;
+
+  assertion((rankSender >= 0) && (rankSender < (int)_sockets.size()),
+             rankSender,
+             _sockets.size());
+  assertion(isConnected());
+
+  Request::SharedPointer request(new SocketRequest);
+
+  try {
+    flushPackage();
+    PtrSocket socket = _sockets[rankSender];
+    asio::async_read(*socket,
+                     asio::buffer(itemsToReceive, size * sizeof(float)),
+                     [request, socket](boost::system::error_code const&, std::size_t) {
+      static_cast<SocketRequest*>(request.get())->complete();
+    });
+  } catch (std::exception& e) {
+    preciceError("aReceive(float*)", "Receive failed: " << e.what());
+  }
+
+  return request;
+}
+
 void
 SocketCommunication::receive(double& itemToReceive, int rankSender) {
   preciceTrace1("receive(double)", rankSender);
@@ -834,6 +943,7 @@ SocketCommunication::receive(double& itemToReceive, int rankSender) {
   assertion(isConnected());
 
   try {
+    flushPackage();
     asio::read(*_sockets[rankSender],
                asio::buffer(&itemToReceive, sizeof(double)));
   } catch (std::exception& e) {
@@ -858,6 +968,7 @@ SocketCommunication::receive(int& itemToReceive, int rankSender) {
   assertion(isConnected());
 
   try {
+    flushPackage();
     asio::read(*_sockets[rankSender],
                asio::buffer(&itemToReceive, sizeof(int)));
   } catch (std::exception& e) {
@@ -882,6 +993,7 @@ SocketCommunication::receive(bool& itemToReceive, int rankSender) {
   assertion(isConnected());
 
   try {
+    flushPackage();
     asio::read(*_sockets[rankSender],
                asio::buffer(&itemToReceive, sizeof(bool)));
   } catch (std::exception& e) {
@@ -903,9 +1015,11 @@ SocketCommunication::aReceive(bool* itemToReceive, int rankSender) {
   Request::SharedPointer request(new SocketRequest);
 
   try {
-    asio::async_read(*_sockets[rankSender],
+    flushPackage();
+    PtrSocket socket = _sockets[rankSender];
+    asio::async_read(*socket,
                      asio::buffer(itemToReceive, sizeof(bool)),
-                     [request](boost::system::error_code const&, std::size_t) {
+                     [request, socket](boost::system::error_code const&, std::size_t) {
       static_cast<SocketRequest*>(request.get())->complete();
     });
   } catch (std::exception& e) {
@@ -915,6 +1029,63 @@ SocketCommunication::aReceive(bool* itemToReceive, int rankSender) {
   return request;
 }
 
+void
+SocketCommunication::configureSocket(Socket& socket) {
+  socket.set_option(asio::ip::tcp::no_delay(true));
+
+  if (_bufferSize > 0) {
+    socket.set_option(asio::socket_base::send_buffer_size(_bufferSize));
+    socket.set_option(asio::socket_base::receive_buffer_size(_bufferSize));
+  }
+}
+
+void
+SocketCommunication::write(int socketIndex,
+                           std::initializer_list<asio::const_buffer> buffers) {
+  if (socketIndex != _packageSocket) {
+    asio::write(*_sockets[socketIndex], buffers);
+    return;
+  }
+
+  size_t size = 0;
+  for (asio::const_buffer const& buffer : buffers) {
+    size += asio::buffer_size(buffer);
+  }
+
+  if (size <= MAX_PACKAGE_ITEM_SIZE) {
+    for (asio::const_buffer const& buffer : buffers) {
+      char const* data = asio::buffer_cast<char const*>(buffer);
+      _packageBuffer.insert(
+          _packageBuffer.end(), data, data + asio::buffer_size(buffer));
+    }
+
+    if (_packageBuffer.size() >= MAX_PACKAGE_SIZE) {
+      flushPackage();
+    }
+  } else {
+    std::vector<asio::const_buffer> gathered;
+    gathered.reserve(buffers.size() + 1);
+    gathered.push_back(asio::buffer(_packageBuffer));
+    gathered.insert(gathered.end(), buffers.begin(), buffers.end());
+    asio::write(*_sockets[socketIndex], gathered);
+    _packageBuffer.clear();
+  }
+}
+
+void
+SocketCommunication::flushPackage() {
+  if (_packageBuffer.empty()) {
+    return;
+  }
+
+  assertion((_packageSocket >= 0) && (_packageSocket < (int)_sockets.size()),
+            _packageSocket,
+            _sockets.size());
+
+  asio::write(*_sockets[_packageSocket], asio::buffer(_packageBuffer));
+  _packageBuffer.clear();
+}
+
 std::string
 SocketCommunication::getIpAddress() {
   preciceTrace("getIpAddress()");
@@ -15,13 +15,15 @@
 #include <boost/asio/io_service.hpp>
 
 #include <condition_variable>
+#include <initializer_list>
 #include <mutex>
 #include <set>
-#include <thread>
+#include <vector>
 
 namespace boost {
 namespace asio {
 class io_service;
+class const_buffer;
 namespace ip {
 class tcp;
 }
@@ -39,16 +41,29 @@ namespace precice {
 namespace com {
 /**
  * @brief Implements Communication by using sockets.
+ *
+ * Blocking sends of small messages between startSendPackage() and
+ * finishSendPackage() are collected and written with one gathered write when
+ * the package is finished or flushed, a large message is sent, or data is
+ * received.
+ *
+ * Asynchronous operations are run by the I/O threads of SocketIOService. Their
+ * handlers hold a reference to the socket, since the shared service may still
+ * run them after the connection has been closed.
  */
 class SocketCommunication : public Communication {
 public:
   /**
    * @brief Constructor.
+   *
+   * @param bufferSize [IN] Size in bytes of the kernel send and receive buffer
+   *        of each socket, 0 keeps the defaults of the operating system.
    */
   SocketCommunication(unsigned short portNumber = 0,
                       bool reuseAddress = false,
                       std::string const& networkName = "lo",
-                      std::string const& addressDirectory = ".");
+                      std::string const& addressDirectory = ".",
+                      int bufferSize = 0);
 
   /**
    * @brief Constructor.
@@ -120,15 +135,20 @@ public:
   virtual void closeConnection();
 
   /**
-   * @brief Is empty.
+   * @brief Starts to collect small blocking sends to rankReceiver.
    */
   virtual void startSendPackage(int rankReceiver);
 
   /**
-   * @brief Is empty.
+   * @brief Writes all collected sends of the package at once.
    */
   virtual void finishSendPackage();
 
+  /**
+   * @brief Writes the sends collected so far, the package stays open.
+   */
+  virtual void flushSendPackage();
+
   /**
    * @brief Just returns rank of sender.
    */
@@ -168,6 +188,13 @@ public:
                                        int size,
                                        int rankReceiver);
 
+  /**
+   * @brief Asynchronously sends an array of single precision values.
+   */
+  virtual Request::SharedPointer aSend(float* itemsToSend,
+                                       int size,
+                                       int rankReceiver);
+
   /**
    * @brief Sends a double to process with given rank.
    */
@@ -227,6 +254,13 @@ public:
                                           int size,
                                           int rankSender);
 
+  /**
+   * @brief Asynchronously receives an array of single precision values.
+   */
+  virtual Request::SharedPointer aReceive(float* itemsToReceive,
+                                          int size,
+                                          int rankSender);
+
   /**
    * @brief Receives a double from process with given rank.
    */
@@ -272,11 +306,16 @@ private:
   // @brief Directory where IP address is exchanged by file.
   std::string _addressDirectory;
 
+  // @brief Kernel buffer size per socket, 0 for the system default.
+  int _bufferSize;
+
   bool _isConnected;
 
   int _remoteCommunicatorSize;
 
   typedef boost::asio::io_service IOService;
+
+  // @brief I/O service shared by all socket communications, see SocketIOService.
   std::shared_ptr<IOService> _ioService;
 
   typedef boost::asio::ip::tcp TCP;
@@ -285,15 +324,32 @@ private:
   typedef std::shared_ptr<Socket> PtrSocket;
   std::vector<PtrSocket> _sockets;
 
-  typedef boost::asio::io_service::work Work;
-  typedef std::shared_ptr<Work> PtrWork;
-  PtrWork _work;
+  // @brief Index of the socket the current send package goes to, or -1.
+  int _packageSocket;
 
-  std::thread _thread;
+  // @brief Small sends collected for the current send package.
+  std::vector<char> _packageBuffer;
 
   bool isClient();
   bool isServer();
 
+  /**
+   * @brief Sets TCP_NODELAY and the buffer sizes of a connected socket.
+   */
+  void configureSocket(Socket& socket);
+
+  /**
+   * @brief Writes buffers to the socket with given index, or adds them to the
+   *        current send package.
+   */
+  void write(int socketIndex,
+             std::initializer_list<boost::asio::const_buffer> buffers);
+
+  /**
+   * @brief Writes the collected sends of the current send package.
+   */
+  void flushPackage();
+
   std::string getIpAddress();
 };
 }
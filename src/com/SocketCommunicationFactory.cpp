@@ -15,11 +15,13 @@ SocketCommunicationFactory::SocketCommunicationFactory(
     unsigned short portNumber,
     bool reuseAddress,
     std::string const& networkName,
-    std::string const& addressDirectory)
+    std::string const& addressDirectory,
+    int bufferSize)
     : _portNumber(portNumber)
     , _reuseAddress(reuseAddress)
     , _networkName(networkName)
-    , _addressDirectory(addressDirectory) {
+    , _addressDirectory(addressDirectory)
+    , _bufferSize(bufferSize) {
   if (_addressDirectory.empty()) {
     _addressDirectory = ".";
   }
@@ -33,7 +35,7 @@ SocketCommunicationFactory::SocketCommunicationFactory(
 Communication::SharedPointer
 SocketCommunicationFactory::newCommunication() {
   return Communication::SharedPointer(new SocketCommunication(
-      _portNumber, _reuseAddress, _networkName, _addressDirectory));
+      _portNumber, _reuseAddress, _networkName, _addressDirectory, _bufferSize));
 }
 
 std::string
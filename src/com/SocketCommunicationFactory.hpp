@@ -19,7 +19,8 @@ public:
   SocketCommunicationFactory(unsigned short portNumber = 0,
                              bool reuseAddress = false,
                              std::string const& networkName = "lo",
-                             std::string const& addressDirectory = ".");
+                             std::string const& addressDirectory = ".",
+                             int bufferSize = 0);
 
   SocketCommunicationFactory(std::string const& addressDirectory);
 
@@ -32,6 +33,7 @@ private:
   bool _reuseAddress;
   std::string _networkName;
   std::string _addressDirectory;
+  int _bufferSize;
 };
 }
 } // namespace precice, com
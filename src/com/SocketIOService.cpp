@@ -0,0 +1,101 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at
+// http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#ifndef PRECICE_NO_SOCKETS
+
+#include "SocketIOService.hpp"
+
+#include "utils/Globals.hpp"
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+
+namespace precice {
+namespace com {
+
+tarch::logging::Log SocketIOService::_log("precice::com::SocketIOService");
+
+std::mutex SocketIOService::_mutex;
+
+std::weak_ptr<SocketIOService> SocketIOService::_instance;
+
+int SocketIOService::_threadCount = 1;
+
+std::shared_ptr<SocketIOService::IOService>
+SocketIOService::get() {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  std::shared_ptr<SocketIOService> instance = _instance.lock();
+
+  if (not instance) {
+    instance.reset(new SocketIOService);
+    instance->startThreads(_threadCount);
+    _instance = instance;
+  }
+
+  // Shares ownership of the pool, but points to its io_service
+  return std::shared_ptr<IOService>(instance, &instance->_ioService);
+}
+
+void
+SocketIOService::setThreadCount(int threadCount) {
+  preciceTrace1("setThreadCount()", threadCount);
+
+  preciceCheck(threadCount > 0,
+               "setThreadCount()",
+               "Number of socket I/O threads has to be > 0!");
+
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _threadCount = std::max(_threadCount, threadCount);
+
+  std::shared_ptr<SocketIOService> instance = _instance.lock();
+
+  if (instance) {
+    instance->startThreads(_threadCount);
+  }
+}
+
+int
+SocketIOService::getThreadCount() {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _threadCount;
+}
+
+SocketIOService::SocketIOService()
+    : _ioService()
+    , _work(new IOService::work(_ioService))
+    , _threads() {
+}
+
+SocketIOService::~SocketIOService() {
+  preciceTrace1("~SocketIOService()", _threads.size());
+
+  // NOTE:
+  // The io_service is not stopped, such that handlers of operations canceled by
+  // closing their sockets are still run and release the sockets.
+  _work.reset();
+
+  for (std::thread& thread : _threads) {
+    assertion(thread.get_id() != std::this_thread::get_id());
+    thread.join();
+  }
+}
+
+void
+SocketIOService::startThreads(int threadCount) {
+  preciceTrace1("startThreads()", threadCount);
+
+  while ((int)_threads.size() < threadCount) {
+    _threads.push_back(std::thread([this]() { _ioService.run(); }));
+  }
+
+  preciceDebug("Running " << _threads.size() << " socket I/O threads");
+}
+}
+} // namespace precice, com
+
+#endif // not PRECICE_NO_SOCKETS
@@ -0,0 +1,85 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at
+// http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SOCKETS
+
+#ifndef PRECICE_COM_SOCKET_IO_SERVICE_HPP_
+#define PRECICE_COM_SOCKET_IO_SERVICE_HPP_
+
+#include "tarch/logging/Log.h"
+#include <boost/asio/io_service.hpp>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace precice {
+namespace com {
+/**
+ * @brief Runs the asynchronous operations of all socket communications.
+ *
+ * All SocketCommunication objects of a process share one io_service, which is
+ * run by a small pool of threads. The pool is started with the first and
+ * stopped with the last socket communication.
+ */
+class SocketIOService {
+public:
+  typedef boost::asio::io_service IOService;
+
+  /**
+   * @brief Returns the shared io_service, starts the threads if necessary.
+   *
+   * The threads are joined when the last returned pointer is released.
+   */
+  static std::shared_ptr<IOService> get();
+
+  /**
+   * @brief Sets the number of threads running the shared io_service.
+   *
+   * The pool is never shrunk, hence a running pool only grows to the given
+   * size. The default is one thread.
+   */
+  static void setThreadCount(int threadCount);
+
+  /**
+   * @brief Returns the number of threads running the shared io_service.
+   */
+  static int getThreadCount();
+
+  /**
+   * @brief Destructor, waits for all pending handlers and joins the threads.
+   */
+  ~SocketIOService();
+
+private:
+  static tarch::logging::Log _log;
+
+  // @brief Protects the static members.
+  static std::mutex _mutex;
+
+  static std::weak_ptr<SocketIOService> _instance;
+
+  static int _threadCount;
+
+  IOService _ioService;
+
+  std::unique_ptr<IOService::work> _work;
+
+  std::vector<std::thread> _threads;
+
+  SocketIOService();
+
+  /**
+   * @brief Starts threads until the pool has the given size.
+   */
+  void startThreads(int threadCount);
+};
+}
+} // namespace precice, com
+
+#endif /* PRECICE_COM_SOCKET_IO_SERVICE_HPP_ */
+
+#endif // not PRECICE_NO_SOCKETS
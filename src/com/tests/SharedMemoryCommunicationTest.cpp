@@ -0,0 +1,302 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SHARED_MEMORY
+
+#include "SharedMemoryCommunicationTest.hpp"
+#include "com/SharedMemoryCommunication.hpp"
+#include "utils/Parallel.hpp"
+#include "utils/Globals.hpp"
+#include <functional>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(precice::com::tests::SharedMemoryCommunicationTest)
+
+namespace precice {
+namespace com {
+namespace tests {
+
+namespace {
+
+/// Runs body in a forked process, which exits with 0 if body returns true.
+pid_t forkProcess(std::function<bool()> body)
+{
+  std::cout.flush();
+  std::cerr.flush();
+  pid_t pid = fork();
+  if (pid == 0){
+    bool success = false;
+    try {
+      success = body();
+    }
+    catch (...) {}
+    _exit(success ? 0 : 1);
+  }
+  return pid;
+}
+
+bool joinProcess(pid_t pid)
+{
+  int status = 0;
+  return (pid > 0) && (waitpid(pid, &status, 0) == pid)
+         && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+}
+
+tarch::logging::Log SharedMemoryCommunicationTest::
+  _log ("precice::com::tests::SharedMemoryCommunicationTest");
+
+SharedMemoryCommunicationTest:: SharedMemoryCommunicationTest()
+:
+  TestCase ("precice::com::tests::SharedMemoryCommunicationTest")
+{}
+
+void SharedMemoryCommunicationTest:: run()
+{
+  PRECICE_MASTER_ONLY {
+    testMethod ( testSendAndReceive );
+    testMethod ( testParallelClient );
+    testMethod ( testAsynchronousSendAndReceive );
+    testMethod ( testCollectives );
+  }
+}
+
+void SharedMemoryCommunicationTest:: testSendAndReceive()
+{
+  preciceTrace ( "testSendAndReceive()" );
+  // Small ring buffer, such that messages wrap around and are split
+  size_t bufferSize = 64;
+
+  pid_t pid = forkProcess([bufferSize](){
+    SharedMemoryCommunication com(".", bufferSize);
+    com.requestConnection("process0", "process1", 0, 1);
+    bool success = com.getRemoteCommunicatorSize() == 1;
+    std::string msg;
+    com.receive(msg, 0);
+    success &= msg == std::string(100, 'a');
+    com.send(std::string("testTwo"), 0);
+    std::vector<double> doubles(1000, 0.0);
+    com.receive(doubles.data(), doubles.size(), 0);
+    for (size_t i=0; i < doubles.size(); i++){
+      success &= doubles[i] == (double)i;
+      doubles[i] = -(double)i;
+    }
+    com.send(doubles.data(), doubles.size(), 0);
+    std::vector<int> ints(4, 1);
+    com.send(ints.data(), ints.size(), 0);
+    double doubleMsg = 0.0;
+    com.receive(doubleMsg, 0);
+    success &= doubleMsg == 1.0;
+    int intMsg = 0;
+    com.receive(intMsg, 0);
+    success &= intMsg == 1;
+    com.send(2, 0);
+    bool boolMsg = false;
+    com.receive(boolMsg, 0);
+    success &= boolMsg;
+    com.send(false, 0);
+    com.closeConnection();
+    return success;
+  });
+
+  SharedMemoryCommunication com(".", bufferSize);
+  com.acceptConnection("process0", "process1", 0, 1);
+  validateEquals ( com.getRemoteCommunicatorSize(), 1 );
+  {
+    std::string msg(100, 'a');
+    com.send(msg, 0);
+    com.receive(msg, 0);
+    validate ( msg == std::string("testTwo") );
+  }
+  {
+    std::vector<double> msg(1000);
+    for (size_t i=0; i < msg.size(); i++){
+      msg[i] = (double)i;
+    }
+    com.send(msg.data(), msg.size(), 0);
+    com.receive(msg.data(), msg.size(), 0);
+    for (size_t i=0; i < msg.size(); i++){
+      validateNumericalEquals ( msg[i], -(double)i );
+    }
+  }
+  {
+    std::vector<int> msg(4, 0);
+    com.receive(msg.data(), msg.size(), 0);
+    validate ( msg == std::vector<int>(4, 1) );
+  }
+  {
+    com.send(1.0, 0);
+    com.send(1, 0);
+    int msg = 0;
+    com.receive(msg, 0);
+    validateEquals ( msg, 2 );
+  }
+  {
+    bool msg = true;
+    com.send(msg, 0);
+    com.receive(msg, 0);
+    validate ( msg == false );
+  }
+  com.closeConnection();
+  validate ( joinProcess(pid) );
+}
+
+void SharedMemoryCommunicationTest:: testParallelClient()
+{
+  preciceTrace ( "testParallelClient()" );
+  std::vector<pid_t> pids;
+  for (int i=0; i < 2; i++){
+    pids.push_back(forkProcess([](){
+      SharedMemoryCommunication com;
+      int rank = com.requestConnectionAsClient("server", "client");
+      bool success = com.getRemoteCommunicatorSize() == 1;
+      success &= (rank == 0) || (rank == 1);
+      com.send(rank, 0);
+      int msg = -1;
+      com.receive(msg, 0);
+      success &= msg == rank + 10;
+      com.closeConnection();
+      return success;
+    }));
+  }
+
+  SharedMemoryCommunication com;
+  com.acceptConnectionAsServer("server", "client", 2);
+  validateEquals ( com.getRemoteCommunicatorSize(), 2 );
+  for (int rank=0; rank < 2; rank++){
+    int msg = -1;
+    com.receive(msg, rank);
+    validateEquals ( msg, rank );
+    com.send(rank + 10, rank);
+  }
+  com.closeConnection();
+  for (pid_t pid : pids){
+    validate ( joinProcess(pid) );
+  }
+}
+
+void SharedMemoryCommunicationTest:: testAsynchronousSendAndReceive()
+{
+  preciceTrace ( "testAsynchronousSendAndReceive()" );
+  size_t bufferSize = 256;
+  int size = 10000;
+
+  pid_t pid = forkProcess([bufferSize, size](){
+    SharedMemoryCommunication com(".", bufferSize);
+    com.requestConnection("process0", "process1", 0, 1);
+    std::vector<double> doubles(size, 0.0);
+    std::vector<float> floats(size, 0.0f);
+    auto doubleRequest = com.aReceive(doubles.data(), size, 0);
+    auto floatRequest = com.aReceive(floats.data(), size, 0);
+    // Blocking receive after pending ones keeps the order of messages
+    int msg = 0;
+    com.receive(msg, 0);
+    doubleRequest->wait();
+    floatRequest->wait();
+    bool success = msg == 3;
+    for (int i=0; i < size; i++){
+      success &= doubles[i] == 0.5 * i;
+      success &= floats[i] == (float)i;
+    }
+    auto request = com.aSend(doubles.data(), size, 0);
+    request->wait();
+    com.closeConnection();
+    return success;
+  });
+
+  SharedMemoryCommunication com(".", bufferSize);
+  com.acceptConnection("process0", "process1", 0, 1);
+  std::vector<double> doubles(size);
+  std::vector<float> floats(size);
+  for (int i=0; i < size; i++){
+    doubles[i] = 0.5 * i;
+    floats[i] = (float)i;
+  }
+  std::vector<com::Request::SharedPointer> requests;
+  requests.push_back(com.aSend(doubles.data(), size, 0));
+  requests.push_back(com.aSend(floats.data(), size, 0));
+  int msg = 3;
+  requests.push_back(com.aSend(&msg, 0));
+  com::Request::wait(requests);
+
+  std::vector<double> received(size, 0.0);
+  com.aReceive(received.data(), size, 0)->wait();
+  validate ( received == doubles );
+  com.closeConnection();
+  validate ( joinProcess(pid) );
+}
+
+void SharedMemoryCommunicationTest:: testCollectives()
+{
+  preciceTrace ( "testCollectives()" );
+  int slaves = 2;
+  std::vector<pid_t> pids;
+  for (int slave=0; slave < slaves; slave++){
+    pids.push_back(forkProcess([slave, slaves](){
+      SharedMemoryCommunication com;
+      com.requestConnection("master", "slaves", slave, slaves);
+      bool success = true;
+      double values[2] = {1.0 + slave, 10.0 * slave};
+      double result[2] = {0.0, 0.0};
+      com.allreduceSum(values, result, 2, 0);
+      success &= (result[0] == 6.0) && (result[1] == 10.0);
+      com.reduceSum(values, result, 2, 0);
+      int intValue = slave + 1;
+      int intResult = 0;
+      com.allreduceSum(intValue, intResult, 0);
+      success &= intResult == 6;
+      double value = 0.0;
+      com.broadcast(value, 0);
+      success &= value == 0.5;
+      std::vector<int> ints(3, 0);
+      com.broadcast(ints.data(), ints.size(), 0);
+      success &= ints == std::vector<int>({1, 2, 3});
+      bool flag = false;
+      com.broadcast(flag, 0);
+      success &= flag;
+      com.closeConnection();
+      return success;
+    }));
+  }
+
+  SharedMemoryCommunication com;
+  com.acceptConnection("master", "slaves", 0, 1);
+  com.setRankOffset(0);
+  validateEquals ( com.getRemoteCommunicatorSize(), (size_t)slaves );
+  {
+    double values[2] = {3.0, 0.0};
+    double result[2] = {0.0, 0.0};
+    com.allreduceSum(values, result, 2);
+    validateNumericalEquals ( result[0], 6.0 );
+    validateNumericalEquals ( result[1], 10.0 );
+    // Input values are not modified
+    validateNumericalEquals ( values[0], 3.0 );
+    com.reduceSum(values, result, 2);
+    validateNumericalEquals ( result[0], 6.0 );
+    validateNumericalEquals ( result[1], 10.0 );
+  }
+  {
+    int value = 3;
+    int result = 0;
+    com.allreduceSum(value, result);
+    validateEquals ( result, 6 );
+  }
+  com.broadcast(0.5);
+  std::vector<int> ints({1, 2, 3});
+  com.broadcast(ints.data(), ints.size());
+  com.broadcast(true);
+  com.closeConnection();
+  for (pid_t pid : pids){
+    validate ( joinProcess(pid) );
+  }
+}
+
+}}} // namespace precice, com, tests
+
+#endif // not PRECICE_NO_SHARED_MEMORY
@@ -0,0 +1,74 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SHARED_MEMORY
+
+#ifndef PRECICE_COM_TESTS_SHAREDMEMORYCOMMUNICATIONTEST_HPP_
+#define PRECICE_COM_TESTS_SHAREDMEMORYCOMMUNICATIONTEST_HPP_
+
+#include "tarch/tests/TestCase.h"
+#include "tarch/logging/Log.h"
+
+namespace precice {
+namespace com {
+namespace tests {
+
+/**
+ * @brief Provides tests for class SharedMemoryCommunication.
+ *
+ * The remote processes are forked from the master process, hence no second
+ * MPI rank is needed.
+ */
+class SharedMemoryCommunicationTest : public tarch::tests::TestCase
+{
+public:
+
+  /**
+   * @brief Constructor.
+   */
+  SharedMemoryCommunicationTest();
+
+  /**
+   * @brief Destructor, empty.
+   */
+  virtual ~SharedMemoryCommunicationTest() {}
+
+  /**
+   * @brief Empty.
+   */
+  virtual void setUp() {}
+
+  /**
+   * @brief Runs all tests.
+   */
+  virtual void run();
+
+private:
+
+  // @brief Logging device.
+  static tarch::logging::Log _log;
+
+  /**
+   * @brief Tests a send/receive of all message types, exceeding the ring buffer.
+   */
+  void testSendAndReceive();
+
+  void testParallelClient();
+
+  /**
+   * @brief Tests asynchronous transfers, which are completed by the helper thread.
+   */
+  void testAsynchronousSendAndReceive();
+
+  /**
+   * @brief Tests the collective operations of a master with two slaves.
+   */
+  void testCollectives();
+};
+
+}}} // namespace precice, com, tests
+
+#endif /* PRECICE_COM_TESTS_SHAREDMEMORYCOMMUNICATIONTEST_HPP_ */
+
+#endif // not PRECICE_NO_SHARED_MEMORY
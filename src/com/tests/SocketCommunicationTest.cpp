@@ -32,6 +32,10 @@ void SocketCommunicationTest:: run()
       testMethod ( testSendAndReceive );
     }
     utils::Parallel::synchronizeProcesses(); // Necessary for sockets
+    if ( utils::Parallel::getProcessRank() < 2 ){
+      testMethod ( testSendPackage );
+    }
+    utils::Parallel::synchronizeProcesses(); // Necessary for sockets
   }
   if ( utils::Parallel::getCommunicatorSize() >= 3 ){
     if ( utils::Parallel::getProcessRank() < 3 ){
@@ -133,6 +137,55 @@ void SocketCommunicationTest:: testSendAndReceive()
   }
 }
 
+void SocketCommunicationTest:: testSendPackage()
+{
+  preciceTrace ( "testSendPackage()" );
+  SocketCommunication com;
+  if ( utils::Parallel::getProcessRank() == 0 ){
+    com.acceptConnection("process0", "process1", 0, 1);
+    com.startSendPackage(0);
+    com.send(1.0, 0);
+    com.send(2, 0);
+    com.send(true, 0);
+    com.send(std::string("testOne"), 0);
+    // Larger than the collected small messages, written with them at once
+    utils::DynVector msg(10000, 3.0);
+    com.send(tarch::la::raw(msg), msg.size(), 0);
+    com.send(4, 0);
+    // Receiving flushes the package, since the remote side waits for it
+    int reply = 0;
+    com.receive(reply, 0);
+    validateEquals ( reply, 5 );
+    com.send(6, 0);
+    com.finishSendPackage();
+    com.closeConnection();
+  }
+  else if ( utils::Parallel::getProcessRank() == 1 ){
+    com.requestConnection("process0", "process1", 0, 1);
+    double doubleMsg = 0.0;
+    com.receive(doubleMsg, 0);
+    validateNumericalEquals ( doubleMsg, 1.0 );
+    int intMsg = 0;
+    com.receive(intMsg, 0);
+    validateEquals ( intMsg, 2 );
+    bool boolMsg = false;
+    com.receive(boolMsg, 0);
+    validate ( boolMsg );
+    std::string stringMsg;
+    com.receive(stringMsg, 0);
+    validate ( stringMsg == std::string("testOne") );
+    utils::DynVector msg(10000, 0.0);
+    com.receive(tarch::la::raw(msg), msg.size(), 0);
+    validate ( tarch::la::equals(msg, utils::DynVector(10000, 3.0)) );
+    com.receive(intMsg, 0);
+    validateEquals ( intMsg, 4 );
+    com.send(5, 0);
+    com.receive(intMsg, 0);
+    validateEquals ( intMsg, 6 );
+    com.closeConnection();
+  }
+}
+
 void SocketCommunicationTest:: testParallelClient()
 {
   preciceTrace ( "testParallelClient()" );
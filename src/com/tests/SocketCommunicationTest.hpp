@@ -48,6 +48,8 @@ private:
 
   void testSendAndReceive();
 
+  void testSendPackage();
+
   void testParallelClient();
 
   void testReceiveFromAnyClient();
@@ -0,0 +1,96 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+
+#ifndef PRECICE_NO_SOCKETS
+
+#include <boost/asio.hpp>
+
+#include "SocketIOServiceTest.hpp"
+#include "com/SocketIOService.hpp"
+#include "utils/Parallel.hpp"
+#include "utils/Globals.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(precice::com::tests::SocketIOServiceTest)
+
+namespace precice {
+namespace com {
+namespace tests {
+
+tarch::logging::Log SocketIOServiceTest::
+  _log ("precice::com::tests::SocketIOServiceTest");
+
+SocketIOServiceTest:: SocketIOServiceTest()
+:
+  TestCase ("precice::com::tests::SocketIOServiceTest")
+{}
+
+void SocketIOServiceTest:: run()
+{
+  PRECICE_MASTER_ONLY {
+    testMethod ( testSharedService );
+    testMethod ( testThreadPool );
+  }
+}
+
+void SocketIOServiceTest:: testSharedService()
+{
+  preciceTrace ( "testSharedService()" );
+  std::shared_ptr<SocketIOService::IOService> first = SocketIOService::get();
+  std::shared_ptr<SocketIOService::IOService> second = SocketIOService::get();
+  validate ( first.get() == second.get() );
+
+  // Handlers are run by the I/O threads, not by the calling thread
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::thread::id handlerThread = std::this_thread::get_id();
+  bool done = false;
+  first->post([&](){
+    std::lock_guard<std::mutex> lock(mutex);
+    handlerThread = std::this_thread::get_id();
+    done = true;
+    condition.notify_one();
+  });
+  std::unique_lock<std::mutex> lock(mutex);
+  validate ( condition.wait_for(lock, std::chrono::seconds(10),
+                                [&](){ return done; }) );
+  validate ( handlerThread != std::this_thread::get_id() );
+}
+
+void SocketIOServiceTest:: testThreadPool()
+{
+  preciceTrace ( "testThreadPool()" );
+  std::shared_ptr<SocketIOService::IOService> ioService = SocketIOService::get();
+  SocketIOService::setThreadCount(2);
+  validate ( SocketIOService::getThreadCount() >= 2 );
+
+  // Both handlers wait for each other, which only succeeds on two threads
+  std::mutex mutex;
+  std::condition_variable condition;
+  int arrived = 0;
+  int met = 0;
+  for (int i=0; i < 2; i++){
+    ioService->post([&](){
+      std::unique_lock<std::mutex> lock(mutex);
+      arrived++;
+      condition.notify_all();
+      if (condition.wait_for(lock, std::chrono::seconds(10),
+                             [&](){ return arrived == 2; })){
+        met++;
+      }
+      condition.notify_all();
+    });
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait_for(lock, std::chrono::seconds(20), [&](){ return met == 2; });
+  validateEquals ( met, 2 );
+}
+
+}}} // namespace precice, com, tests
+
+#endif // not PRECICE_NO_SOCKETS
@@ -5,6 +5,7 @@
 #include "mesh/Mesh.hpp"
 #include "com/Communication.hpp"
 #include "m2n/M2N.hpp"
+#include "m2n/DistributedCommunication.hpp"
 #include "utils/Globals.hpp"
 #include "utils/MasterSlave.hpp"
 #include "utils/EigenHelperFunctions.hpp"
@@ -16,6 +17,7 @@
 #include "tarch/la/ScalarOperations.h"
 #include "Eigen/Dense"
 #include <limits>
+#include <map>
 #include <sstream>
 
 namespace precice {
@@ -309,16 +311,41 @@ std::vector<int> BaseCouplingScheme:: sendData
   m2n::M2N::SharedPointer m2n)
 {
   preciceTrace("sendData()");
+  std::vector<int> sentDataIDs = startSendData(m2n);
+  m2n->finishSend();
+  return sentDataIDs;
+}
+
+std::vector<int> BaseCouplingScheme:: startSendData
+(
+  m2n::M2N::SharedPointer m2n)
+{
+  return startSendData(m2n, _sendData);
+}
+
+std::vector<int> BaseCouplingScheme:: startSendData
+(
+  m2n::M2N::SharedPointer m2n,
+  DataMap&                sendData )
+{
+  preciceTrace1("startSendData()", sendData.size());
 
   std::vector<int> sentDataIDs;
   assertion(m2n.get() != nullptr);
   assertion(m2n->isConnected());
-  for (DataMap::value_type& pair : _sendData){
+  // All data of one mesh is sent at once, such that it is fused into one
+  // message per remote rank
+  std::map<int, std::vector<m2n::DistributedCommunication::DataValues>> meshData;
+  for (DataMap::value_type& pair : sendData){
     //std::cout<<"\nsend data id="<<pair.first<<": "<<*(pair.second->values)<<std::endl;
-    int size = pair.second->values->size();
-    m2n->send(pair.second->values->data(), size, pair.second->mesh->getID(), pair.second->dimension);
+    m2n::DistributedCommunication::DataValues values = {
+      pair.second->values->data(), (size_t) pair.second->values->size(), pair.second->dimension };
+    meshData[pair.second->mesh->getID()].push_back(values);
     sentDataIDs.push_back(pair.first);
   }
+  for (auto& pair : meshData){
+    m2n->startSend(pair.second, pair.first);
+  }
   preciceDebug("Number of sent data sets = " << sentDataIDs.size());
   return sentDataIDs;
 }
@@ -328,16 +355,39 @@ std::vector<int> BaseCouplingScheme:: receiveData
   m2n::M2N::SharedPointer m2n)
 {
   preciceTrace("receiveData()");
+  std::vector<int> receivedDataIDs = startReceiveData(m2n);
+  m2n->finishReceive();
+  return receivedDataIDs;
+}
+
+std::vector<int> BaseCouplingScheme:: startReceiveData
+(
+  m2n::M2N::SharedPointer m2n)
+{
+  return startReceiveData(m2n, _receiveData);
+}
+
+std::vector<int> BaseCouplingScheme:: startReceiveData
+(
+  m2n::M2N::SharedPointer m2n,
+  DataMap&                receiveData )
+{
+  preciceTrace1("startReceiveData()", receiveData.size());
   std::vector<int> receivedDataIDs;
   assertion(m2n.get() != nullptr);
   assertion(m2n->isConnected());
 
-  for (DataMap::value_type & pair : _receiveData) {
-    int size = pair.second->values->size();
+  std::map<int, std::vector<m2n::DistributedCommunication::DataValues>> meshData;
+  for (DataMap::value_type & pair : receiveData) {
     //std::cout<<"\nreceive data id="<<pair.first<<": "<<*(pair.second->values)<<std::endl;
-    m2n->receive(pair.second->values->data(), size, pair.second->mesh->getID(), pair.second->dimension);
+    m2n::DistributedCommunication::DataValues values = {
+      pair.second->values->data(), (size_t) pair.second->values->size(), pair.second->dimension };
+    meshData[pair.second->mesh->getID()].push_back(values);
     receivedDataIDs.push_back(pair.first);
   }
+  for (auto& pair : meshData){
+    m2n->startReceive(pair.second, pair.first);
+  }
   preciceDebug("Number of received data sets = " << receivedDataIDs.size());
 
   return receivedDataIDs;
@@ -306,6 +306,27 @@ protected:
   /// @brief Receives data receiveDataIDs given in mapCouplingData with communication.
   std::vector<int> receiveData ( m2n::M2N::SharedPointer m2n );
 
+  /// @brief Starts to send data, completed by m2n->finishSend().
+  std::vector<int> startSendData ( m2n::M2N::SharedPointer m2n );
+
+  /// @brief Starts to receive data, the values are valid after m2n->finishReceive().
+  std::vector<int> startReceiveData ( m2n::M2N::SharedPointer m2n );
+
+  /**
+   * @brief Starts to send the given data, completed by m2n->finishSend().
+   *
+   * All data of one mesh is fused into one message per remote rank, the
+   * receiver has to call startReceiveData() with the same data of the mesh.
+   */
+  std::vector<int> startSendData (
+    m2n::M2N::SharedPointer m2n,
+    DataMap&                sendData );
+
+  /// @brief Starts to receive the given data, the values are valid after m2n->finishReceive().
+  std::vector<int> startReceiveData (
+    m2n::M2N::SharedPointer m2n,
+    DataMap&                receiveData );
+
   /// @brief Returns all data to be sent.
   const DataMap& getSendData() const {
     return _sendData;
@@ -97,6 +97,22 @@ public:
    */
   virtual void advance() =0;
 
+  /**
+   * @brief Starts to advance the coupling scheme, completed by finishAdvance().
+   *
+   * Schemes may post the data exchange here, such that the solver can work
+   * while data is in flight. Written data must not be changed and read data
+   * must not be accessed before finishAdvance() is called. By default,
+   * nothing is done and finishAdvance() calls advance().
+   */
+  virtual void startAdvance() {}
+
+  /// @brief Completes an advance started by startAdvance().
+  virtual void finishAdvance()
+  {
+    advance();
+  }
+
   /// @brief Finalizes the coupling and disconnects communication.
   virtual void finalize() =0;
 
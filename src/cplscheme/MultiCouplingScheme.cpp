@@ -263,16 +263,12 @@ void MultiCouplingScheme:: sendData()
 {
   preciceTrace("sendData()");
 
+  // Fused per mesh as in the parallel coupling schemes of the partners
   for(size_t i=0;i<_communications.size();i++){
-    assertion(_communications[i].get() != nullptr);
-    assertion(_communications[i]->isConnected());
-
-    for (DataMap::value_type& pair : _sendDataVector[i]) {
-      int size = pair.second->values->size();
-      if (size > 0) {
-        _communications[i]->send(pair.second->values->data(), size, pair.second->mesh->getID(), pair.second->dimension);
-      }
-    }
+    startSendData(_communications[i], _sendDataVector[i]);
+  }
+  for (m2n::M2N::SharedPointer m2n : _communications) {
+    m2n->finishSend();
   }
 }
 
@@ -281,15 +277,10 @@ void MultiCouplingScheme:: receiveData()
   preciceTrace("receiveData()");
 
   for(size_t i=0;i<_communications.size();i++){
-    assertion(_communications[i].get() != nullptr);
-    assertion(_communications[i]->isConnected());
-
-    for (DataMap::value_type& pair : _receiveDataVector[i]) {
-      int size = pair.second->values->size();
-      if (size > 0) {
-        _communications[i]->receive(pair.second->values->data(), size, pair.second->mesh->getID(), pair.second->dimension);
-      }
-    }
+    startReceiveData(_communications[i], _receiveDataVector[i]);
+  }
+  for (m2n::M2N::SharedPointer m2n : _communications) {
+    m2n->finishReceive();
   }
 }
 
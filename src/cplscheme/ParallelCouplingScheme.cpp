@@ -25,7 +25,8 @@ ParallelCouplingScheme::ParallelCouplingScheme
   :
   BaseCouplingScheme(maxTime,maxTimesteps,timestepLength,validDigits,firstParticipant,
                      secondParticipant,localParticipant,m2n,maxIterations,dtMethod),
-  _allData ()
+  _allData (),
+  _isExchangeStarted(false)
 {
   _couplingMode = cplMode;
   // Coupling mode must be either Explicit or Implicit when using SerialCouplingScheme.
@@ -164,6 +165,68 @@ void ParallelCouplingScheme::advance()
   }
 }
 
+void ParallelCouplingScheme::startAdvance()
+{
+  if (_couplingMode != Explicit) {
+    return;
+  }
+  preciceTrace("startAdvance()");
+  checkCompletenessRequiredActions();
+  preciceCheck(!hasToReceiveInitData() && !hasToSendInitData(), "startAdvance()",
+               "initializeData() needs to be called before advance if data has to be initialized!");
+  setHasDataBeenExchanged(false);
+  setIsCouplingTimestepComplete(false);
+  _isExchangeStarted = tarch::la::equals(getThisTimestepRemainder(), 0.0, _eps);
+
+  if (_isExchangeStarted) {
+    setIsCouplingTimestepComplete(true);
+    setTimesteps(getTimesteps() + 1);
+
+    if (doesFirstStep()) {
+      preciceDebug("Start sending data...");
+      getM2N()->startSendPackage(0);
+      sendDt();
+      startSendData(getM2N());
+      getM2N()->finishSendPackage();
+    }
+    // The receives are posted by both participants, the second one sends its
+    // data only after having received, as in explicitAdvance()
+    startReceiveData(getM2N());
+  }
+}
+
+void ParallelCouplingScheme::finishAdvance()
+{
+  if (_couplingMode != Explicit) {
+    advance();
+    return;
+  }
+  preciceTrace("finishAdvance()");
+  if (_isExchangeStarted) {
+    preciceDebug("Receiving data...");
+    getM2N()->startReceivePackage(0);
+    receiveAndSetDt();
+    getM2N()->finishReceive();
+    getM2N()->finishReceivePackage();
+    setHasDataBeenExchanged(true);
+
+    if (doesFirstStep()) {
+      getM2N()->finishSend();
+    }
+    else { //second participant
+      preciceDebug("Sending data...");
+      getM2N()->startSendPackage(0);
+      sendDt();
+      sendData(getM2N());
+      getM2N()->finishSendPackage();
+    }
+
+    //both participants
+    setComputedTimestepPart(0.0);
+    _isExchangeStarted = false;
+  }
+}
+
 void ParallelCouplingScheme::explicitAdvance()
 {
   preciceTrace("advance()");
@@ -32,6 +32,16 @@ public:
 
   virtual void advance();
 
+  /**
+   * @brief Posts the data exchange of explicit coupling.
+   *
+   * The first participant sends its data, both participants post their
+   * receives. Implicit coupling is advanced in finishAdvance().
+   */
+  virtual void startAdvance();
+
+  virtual void finishAdvance();
+
 
 protected:
   /// @brief merges send and receive data into one map (for parallel post-processing)
@@ -49,6 +59,9 @@ private:
   /// @brief Map from data ID -> all data (receive and send) with that ID
   DataMap _allData;
 
+  /// @brief True, if startAdvance() has started a data exchange.
+  bool _isExchangeStarted;
+
   virtual void explicitAdvance();
 
   virtual void implicitAdvance();
@@ -105,9 +105,11 @@ void AitkenPostProcessing:: performPostProcessing
   }
   else {
     // compute fraction of aitken factor with residuals and residual deltas
-    double nominator = utils::MasterSlave::dot(_residuals, residualDeltas);
-    double denominator = utils::MasterSlave::dot(residualDeltas, residualDeltas);
-    _aitkenFactor = -_aitkenFactor * (nominator / denominator);
+    // nominator and denominator are reduced at once
+    std::vector<double> dots = {_residuals.dot(residualDeltas),
+                                residualDeltas.dot(residualDeltas)};
+    utils::MasterSlave::allreduceSum(dots);
+    _aitkenFactor = -_aitkenFactor * (dots[0] / dots[1]);
   }
 
   preciceDebug("AitkenFactor: " << _aitkenFactor);
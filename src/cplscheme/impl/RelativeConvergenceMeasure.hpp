@@ -12,6 +12,7 @@
 #include "tarch/logging/Log.h"
 #include "utils/MasterSlave.hpp"
 #include "tarch/la/ScalarOperations.h"
+#include <cmath>
 
 namespace precice {
    namespace cplscheme {
@@ -71,8 +72,13 @@ public:
      std::cout<<"-------\n"<<std::endl;
 */
 
-     _normDiff = utils::MasterSlave::l2norm((newValues - oldValues) - designSpecification);
-     _norm = utils::MasterSlave::l2norm(newValues + designSpecification);
+     // Both norms are reduced at once
+     std::vector<double> norms = {
+         ((newValues - oldValues) - designSpecification).squaredNorm(),
+         (newValues + designSpecification).squaredNorm()};
+     utils::MasterSlave::allreduceSum(norms);
+     _normDiff = std::sqrt(norms[0]);
+     _norm = std::sqrt(norms[1]);
      _isConvergence = _normDiff <= _norm * _convergenceLimitPercent;
 //      preciceInfo ( "measure()", "Relative convergence measure: "
 //                    << "two-norm differences = " << normDiff
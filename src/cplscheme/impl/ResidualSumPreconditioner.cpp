@@ -32,13 +32,13 @@ void ResidualSumPreconditioner::_update_(bool timestepComplete, const Eigen::Vec
 
     int offset = 0;
     for(size_t k=0; k<_dimensions.size(); k++){
-      Eigen::VectorXd part = Eigen::VectorXd::Zero(_dimensions[k]*_sizeOfSubVector);
-      for(int i=0; i<_dimensions[k]*_sizeOfSubVector; i++){
-        part(i) = res(i+offset);
-      }
-      norms[k] = utils::MasterSlave::dot(part,part);
-      sum += norms[k];
+      norms[k] = res.segment(offset, _dimensions[k]*_sizeOfSubVector).squaredNorm();
       offset += _dimensions[k]*_sizeOfSubVector;
+    }
+    // The norms of all sub-vectors are reduced at once
+    utils::MasterSlave::allreduceSum(norms);
+    for(size_t k=0; k<_dimensions.size(); k++){
+      sum += norms[k];
       norms[k] = std::sqrt(norms[k]);
     }
     sum = std::sqrt(sum);
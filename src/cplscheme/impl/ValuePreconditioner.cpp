@@ -3,6 +3,7 @@
 // use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
 #include "ValuePreconditioner.hpp"
 #include "utils/MasterSlave.hpp"
+#include <cmath>
 
 namespace precice {
 namespace cplscheme {
@@ -30,12 +31,13 @@ void ValuePreconditioner::_update_(bool timestepComplete, const Eigen::VectorXd&
 
     int offset = 0;
     for(size_t k=0; k<_dimensions.size(); k++){
-      Eigen::VectorXd part = Eigen::VectorXd::Zero(_dimensions[k]*_sizeOfSubVector);
-      for(int i=0; i<_dimensions[k]*_sizeOfSubVector; i++){
-        part(i) = oldValues(i+offset);
-      }
-      norms[k] = utils::MasterSlave::l2norm(part);
+      norms[k] = oldValues.segment(offset, _dimensions[k]*_sizeOfSubVector).squaredNorm();
       offset += _dimensions[k]*_sizeOfSubVector;
+    }
+    // The norms of all sub-vectors are reduced at once
+    utils::MasterSlave::allreduceSum(norms);
+    for(size_t k=0; k<_dimensions.size(); k++){
+      norms[k] = std::sqrt(norms[k]);
       assertion(norms[k]>0.0);
     }
 
@@ -61,6 +61,7 @@ void ExplicitCouplingSchemeTest:: run ()
       testMethod(testExplicitCouplingFirstParticipantSetsDt);
       testMethod(testSerialDataInitialization);
       testMethod(testParallelDataInitialization);
+      testMethod(testParallelSplitAdvance);
       testMethod(testExplicitCouplingWithSubcycling);
       testMethod(testConfiguredExplicitCouplingWithSubcycling);
       Par::setGlobalCommunicator(Par::getCommunicatorWorld());
@@ -396,6 +397,82 @@ void ExplicitCouplingSchemeTest:: testParallelDataInitialization()
 }
 
 
+void ExplicitCouplingSchemeTest:: testParallelSplitAdvance()
+{
+  preciceTrace("testParallelSplitAdvance()");
+  using namespace mesh;
+  utils::Parallel::synchronizeProcesses();
+  assertion(utils::Parallel::getCommunicatorSize() > 1);
+  mesh::PropertyContainer::resetPropertyIDCounter();
+
+  std::string configurationPath(_pathToTests + "parallel-explicit-coupling-datainit.xml");
+
+  std::string localParticipant("");
+  if (utils::Parallel::getProcessRank() == 0){
+    localParticipant = "participant0";
+  }
+  else if (utils::Parallel::getProcessRank() == 1){
+    localParticipant = "participant1";
+  }
+  utils::XMLTag root = utils::getRootTag();
+  PtrDataConfiguration dataConfig(new DataConfiguration(root));
+  dataConfig->setDimensions(2);
+  PtrMeshConfiguration meshConfig(new MeshConfiguration(root, dataConfig));
+  meshConfig->setDimensions(2);
+  m2n::M2NConfiguration::SharedPointer m2nConfig(new m2n::M2NConfiguration(root));
+  geometry::GeometryConfiguration geoConfig(root, meshConfig);
+  geoConfig.setDimensions(2);
+  CouplingSchemeConfiguration cplSchemeConfig(root, meshConfig, m2nConfig);
+
+  utils::configure(root, configurationPath);
+  meshConfig->setMeshSubIDs();
+  m2n::M2N::SharedPointer m2n = m2nConfig->getM2N("participant0", "participant1");
+
+  geoConfig.geometries()[0]->create(*meshConfig->meshes()[0]);
+  connect("participant0", "participant1", localParticipant, m2n);
+  CouplingScheme& cplScheme = *cplSchemeConfig.getCouplingScheme(localParticipant);
+
+  mesh::PtrMesh mesh = meshConfig->meshes()[0];
+  auto& dataValues0 = mesh->data()[0]->values();
+  auto& dataValues1 = mesh->data()[1]->values();
+  auto& dataValues2 = mesh->data()[2]->values();
+
+  if (localParticipant == std::string("participant0")){
+    cplScheme.initialize(0.0, 1);
+    dataValues2(0) = 3.0;
+    cplScheme.performedAction(constants::actionWriteInitialData());
+    cplScheme.initializeData();
+    validateNumericalEquals(dataValues1(0), 1.0);
+    dataValues2(0) = 2.0;
+    cplScheme.addComputedTime(cplScheme.getNextTimestepMaxLength());
+    cplScheme.startAdvance();
+    validate(not cplScheme.hasDataBeenExchanged());
+    cplScheme.finishAdvance();
+    validate(cplScheme.hasDataBeenExchanged());
+    validate(cplScheme.isCouplingTimestepComplete());
+    validateNumericalEquals(dataValues0(0), 4.0);
+    validate(not cplScheme.isCouplingOngoing());
+    cplScheme.finalize();
+  }
+  else if (localParticipant == std::string("participant1")){
+    cplScheme.initialize(0.0, 1);
+    dataValues1(0) = 1.0;
+    cplScheme.performedAction(constants::actionWriteInitialData());
+    cplScheme.initializeData();
+    validateNumericalEquals(dataValues2(0), 3.0);
+    dataValues0(0) = 4.0;
+    cplScheme.addComputedTime(cplScheme.getNextTimestepMaxLength());
+    cplScheme.startAdvance();
+    cplScheme.finishAdvance();
+    validate(cplScheme.hasDataBeenExchanged());
+    validateNumericalEquals(dataValues2(0), 2.0);
+    validate(not cplScheme.isCouplingOngoing());
+    cplScheme.finalize();
+  }
+  utils::Parallel::clearGroups();
+}
+
+
 void ExplicitCouplingSchemeTest:: runSimpleExplicitCoupling
 (
   CouplingScheme&                cplScheme,
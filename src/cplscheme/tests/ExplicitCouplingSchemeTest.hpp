@@ -97,6 +97,12 @@ private:
     */
    void testParallelDataInitialization();
 
+   /**
+    * @brief Parallel coupling advanced in two phases with startAdvance() and
+    * finishAdvance().
+    */
+   void testParallelSplitAdvance();
+
    /**
     * @brief Configured test with second participant setting timestep length.
     */
@@ -237,6 +237,12 @@ void ParallelMatrixOperationsTest::testParVectorOperations()
     validate (tarch::la::equals(ires1, 10));
   }
   delete[] aa; delete[] res2; delete[] res3;
+
+  std::vector<double> values = {a, 2.0 * a, 1.0};
+  utils::MasterSlave::allreduceSum(values);
+  validate (tarch::la::equals(values[0], 10.));
+  validate (tarch::la::equals(values[1], 20.));
+  validate (tarch::la::equals(values[2], 4.));
   // ---------------------------------------------------------
 
   Eigen::VectorXd vec1_local(n_local);
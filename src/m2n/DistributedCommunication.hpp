@@ -5,6 +5,7 @@
 #define PRECICE_M2N_DISTRIBUTED_COMMUNICATION_HPP_
 
 #include "mesh/SharedPointer.hpp"
+#include <vector>
 
 namespace precice {
 namespace m2n {
@@ -35,6 +36,15 @@ class DistributedCommunication
 public:
   using SharedPointer = std::shared_ptr<DistributedCommunication>;
 
+  /**
+   * @brief Values of one data, several of them can be communicated at once.
+   */
+  struct DataValues {
+    double* values;
+    size_t  size;
+    int     valueDimension;
+  };
+
 public:
 
   DistributedCommunication(mesh::PtrMesh mesh)
@@ -95,11 +105,72 @@ public:
     size_t     size,
     int     valueDimension) =0;
 
+  /**
+   * @brief Sends the values of several data of the mesh.
+   *
+   * Implementations may fuse all values into one message per remote rank, the
+   * default sends every data separately.
+   */
+  virtual void send ( std::vector<DataValues> const& data )
+  {
+    for (DataValues const& values : data) {
+      send(values.values, values.size, values.valueDimension);
+    }
+  }
+
+  /**
+   * @brief Receives the values of several data sent by send(std::vector<DataValues>).
+   */
+  virtual void receive ( std::vector<DataValues> const& data )
+  {
+    for (DataValues const& values : data) {
+      receive(values.values, values.size, values.valueDimension);
+    }
+  }
+
+  /**
+   * @brief Starts to send the values of several data of the mesh.
+   *
+   * The values may be changed after the call. The default sends blocking.
+   */
+  virtual void startSend ( std::vector<DataValues> const& data )
+  {
+    send(data);
+  }
+
+  /// @brief Completes the send started by startSend().
+  virtual void finishSend()
+  {}
+
+  /**
+   * @brief Starts to receive the values of several data of the mesh.
+   *
+   * The values are only valid after finishReceive(). The default defers the
+   * blocking receive to finishReceive().
+   */
+  virtual void startReceive ( std::vector<DataValues> const& data )
+  {
+    _deferredReceiveData = data;
+  }
+
+  /// @brief Completes the receive started by startReceive().
+  virtual void finishReceive()
+  {
+    if (not _deferredReceiveData.empty()) {
+      receive(_deferredReceiveData);
+      _deferredReceiveData.clear();
+    }
+  }
+
 protected:
   /**
    * @brief mesh that dictates the distribution of this mapping TODO maybe change this directly to vertexDistribution
    */
   mesh::PtrMesh _mesh;
+
+private:
+  /// Data to be received in finishReceive() by the default implementation.
+  std::vector<DataValues> _deferredReceiveData;
 };
 
 
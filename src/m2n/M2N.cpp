@@ -180,6 +180,11 @@ void M2N:: send (
     assertion(_distComs.find(meshID) != _distComs.end());
     assertion(_distComs[meshID].get() != nullptr);
 
+    if(not utils::MasterSlave::_slaveMode){
+      // The remote master may wait for held back sends before serving the slaves
+      _masterCom->flushSendPackage();
+    }
+
 #ifdef M2N_PRE_SYNCHRONIZE
     if(not precice::testMode){
 //      Event e("M2N::send/synchronize", true);
@@ -202,6 +207,60 @@ void M2N:: send (
   }
 }
 
+void M2N:: send (
+  std::vector<DistributedCommunication::DataValues> const& data,
+  int meshID )
+{
+  startSend(data, meshID);
+  finishSend();
+}
+
+void M2N:: startSend (
+  std::vector<DistributedCommunication::DataValues> const& data,
+  int meshID )
+{
+  if(utils::MasterSlave::_slaveMode || utils::MasterSlave::_masterMode){
+    assertion(_areSlavesConnected);
+    assertion(_distComs.find(meshID) != _distComs.end());
+    assertion(_distComs[meshID].get() != nullptr);
+
+    if(not utils::MasterSlave::_slaveMode){
+      // The remote master may wait for held back sends before serving the slaves
+      _masterCom->flushSendPackage();
+    }
+
+#ifdef M2N_PRE_SYNCHRONIZE
+    if(not precice::testMode){
+      if(not utils::MasterSlave::_slaveMode){
+        bool ack;
+
+        _masterCom->send(ack, 0);
+        _masterCom->receive(ack, 0);
+        _masterCom->send(ack, 0);
+      }
+    }
+#endif
+
+    _distComs[meshID]->startSend(data);
+  }
+  else{//coupling mode
+    assertion(_isMasterConnected);
+    // The master communication is blocking, the data is sent right away
+    for (DistributedCommunication::DataValues const& values : data){
+      _masterCom->send(values.values, values.size, 0);
+    }
+  }
+}
+
+void M2N:: finishSend()
+{
+  if(utils::MasterSlave::_slaveMode || utils::MasterSlave::_masterMode){
+    for (auto& pair : _distComs){
+      pair.second->finishSend();
+    }
+  }
+}
+
 void M2N:: send (
   bool   itemToSend)
 {
@@ -232,6 +291,11 @@ void M2N:: receive (
     assertion(_distComs.find(meshID) != _distComs.end());
     assertion(_distComs[meshID].get() != nullptr);
 
+    if(not utils::MasterSlave::_slaveMode){
+      // The remote master may wait for held back sends before serving the slaves
+      _masterCom->flushSendPackage();
+    }
+
 #ifdef M2N_PRE_SYNCHRONIZE
     if(not precice::testMode){
 //      Event e("M2N::receive/synchronize", true);
@@ -254,6 +318,65 @@ void M2N:: receive (
   }
 }
 
+void M2N:: receive (
+  std::vector<DistributedCommunication::DataValues> const& data,
+  int meshID )
+{
+  startReceive(data, meshID);
+  finishReceive();
+}
+
+void M2N:: startReceive (
+  std::vector<DistributedCommunication::DataValues> const& data,
+  int meshID )
+{
+  if(utils::MasterSlave::_slaveMode || utils::MasterSlave::_masterMode){
+    assertion(_areSlavesConnected);
+    assertion(_distComs.find(meshID) != _distComs.end());
+    assertion(_distComs[meshID].get() != nullptr);
+
+    if(not utils::MasterSlave::_slaveMode){
+      // The remote master may wait for held back sends before serving the slaves
+      _masterCom->flushSendPackage();
+    }
+
+#ifdef M2N_PRE_SYNCHRONIZE
+    if(not precice::testMode){
+      if(not utils::MasterSlave::_slaveMode){
+        bool ack;
+
+        _masterCom->receive(ack, 0);
+        _masterCom->send(ack, 0);
+        _masterCom->receive(ack, 0);
+      }
+    }
+#endif
+
+    _distComs[meshID]->startReceive(data);
+  }
+  else{//coupling mode
+    assertion(_isMasterConnected);
+    // Receiving is deferred, as messages of the master communication have to
+    // be received in order
+    _deferredReceiveData.insert(_deferredReceiveData.end(), data.begin(), data.end());
+  }
+}
+
+void M2N:: finishReceive()
+{
+  if(utils::MasterSlave::_slaveMode || utils::MasterSlave::_masterMode){
+    for (auto& pair : _distComs){
+      pair.second->finishReceive();
+    }
+  }
+  else{//coupling mode
+    for (DistributedCommunication::DataValues const& values : _deferredReceiveData){
+      _masterCom->receive(values.values, values.size, 0);
+    }
+    _deferredReceiveData.clear();
+  }
+}
+
 void M2N:: receive (
   bool&  itemToReceive )
 {
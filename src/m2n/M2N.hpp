@@ -11,6 +11,7 @@
 #include "tarch/logging/Log.h"
 
 #include <map>
+#include <vector>
 
 namespace precice {
 namespace m2n {
@@ -119,6 +120,28 @@ public:
     int     meshID,
     int     valueDimension );
 
+  /**
+   * @brief Sends the values of several data of one mesh from all slaves.
+   *
+   * The distributed communication packs them into one message per remote rank.
+   */
+  void send (
+    std::vector<DistributedCommunication::DataValues> const& data,
+    int meshID );
+
+  /**
+   * @brief Starts to send the values of several data of one mesh from all slaves.
+   *
+   * The values may be changed after the call, the sends are completed by
+   * finishSend().
+   */
+  void startSend (
+    std::vector<DistributedCommunication::DataValues> const& data,
+    int meshID );
+
+  /// @brief Completes all sends started by startSend().
+  void finishSend();
+
   /**
    * @brief The master sends a bool to the other master, for performance reasons, we
    * neglect the gathering and checking step.
@@ -143,6 +166,25 @@ public:
     int     meshID,
     int     valueDimension );
 
+  /**
+   * @brief All slaves receive the values of several data of one mesh.
+   */
+  void receive (
+    std::vector<DistributedCommunication::DataValues> const& data,
+    int meshID );
+
+  /**
+   * @brief Starts to receive the values of several data of one mesh.
+   *
+   * The values are only valid after finishReceive() has been called.
+   */
+  void startReceive (
+    std::vector<DistributedCommunication::DataValues> const& data,
+    int meshID );
+
+  /// @brief Completes all receives started by startReceive().
+  void finishReceive();
+
   /**
    * @brief All slaves receive a bool (the same for each slave).
    */
@@ -169,6 +211,9 @@ private:
 
   bool _areSlavesConnected;
 
+  /// Data received in finishReceive(), if no slaves are used.
+  std::vector<DistributedCommunication::DataValues> _deferredReceiveData;
+
 
 };
 
@@ -10,14 +10,16 @@
 namespace precice {
 namespace m2n {
 PointToPointComFactory::PointToPointComFactory(
-    com::CommunicationFactory::SharedPointer comFactory)
-    : _comFactory(comFactory) {
+    com::CommunicationFactory::SharedPointer comFactory,
+    bool singlePrecision)
+    : _comFactory(comFactory)
+    , _singlePrecision(singlePrecision) {
 }
 
 DistributedCommunication::SharedPointer
 PointToPointComFactory::newDistributedCommunication(mesh::PtrMesh mesh) {
   return DistributedCommunication::SharedPointer(
-      new PointToPointCommunication(_comFactory, mesh));
+      new PointToPointCommunication(_comFactory, mesh, _singlePrecision));
 }
 }
 } // namespace precice, m2n
@@ -14,8 +14,11 @@ class PointToPointComFactory : public DistributedComFactory {
 public:
   /**
    * @brief Constructor.
+   *
+   * @param singlePrecision [IN] Transfer data values as float instead of double.
    */
-  PointToPointComFactory(com::CommunicationFactory::SharedPointer comFactory);
+  PointToPointComFactory(com::CommunicationFactory::SharedPointer comFactory,
+                         bool singlePrecision = false);
 
   DistributedCommunication::SharedPointer newDistributedCommunication(
       mesh::PtrMesh mesh);
@@ -23,6 +26,8 @@ public:
 private:
   // @brief communication factory for 1:M communications
   com::CommunicationFactory::SharedPointer _comFactory;
+
+  bool _singlePrecision;
 };
 }
 } // namespace precice, m2n
@@ -11,6 +11,8 @@
 #include "utils/MasterSlave.hpp"
 #include "utils/Publisher.hpp"
 
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 
 using precice::utils::Event;
@@ -283,9 +285,10 @@ printLocalIndexCountStats(std::map<int, std::vector<int>> const& m) {
   }
 }
 
-// The approximate complexity of this function is O((number of local data
-// indices for the current rank in `thisVertexDistribution') * (total number of
-// data indices for all ranks in `otherVertexDistribution')).
+// The local indices are hashed once, such that the complexity of this function
+// is O((number of local data indices for the current rank in
+// `thisVertexDistribution') + (total number of data indices for all ranks in
+// `otherVertexDistribution')), plus sorting the matches of every remote rank.
 std::map<int, std::vector<int>>
 buildCommunicationMap(
     // `localIndexCount' is the number of unique local indices for the current
@@ -297,7 +300,7 @@ buildCommunicationMap(
     // `otherVertexDistribution' is input vertex distribution from other
     // participant.
     std::map<int, std::vector<int>> const& otherVertexDistribution,
-    int thisRank = utils::MasterSlave::_rank) {
+    int thisRank) {
 
   localIndexCount = 0;
   
@@ -310,18 +313,46 @@ buildCommunicationMap(
   
   auto const& indices = iterator->second;
 
-  int index = 0;
+  // Maps a global data index to its positions in `indices'.
+  std::unordered_map<int, std::vector<int>> positions;
 
-  for (int thisIndex : indices) {
-    for (auto &other : otherVertexDistribution) {
-      for (auto &otherIndex : other.second) {
-        if (thisIndex == otherIndex) {
-          communicationMap[other.first].push_back(index);
-          break;
+  positions.reserve(indices.size());
+
+  for (int index = 0; index < static_cast<int>(indices.size()); ++index) {
+    positions[indices[index]].push_back(index);
+  }
+
+  // A local position is added at most once per remote rank, even if the
+  // remote rank holds its global index several times.
+  std::vector<bool> isMatched(indices.size(), false);
+
+  for (auto const& other : otherVertexDistribution) {
+    std::vector<int> matches;
+
+    for (int otherIndex : other.second) {
+      auto found = positions.find(otherIndex);
+
+      if (found == positions.end())
+        continue;
+
+      for (int index : found->second) {
+        if (not isMatched[index]) {
+          isMatched[index] = true;
+          matches.push_back(index);
         }
       }
     }
-    ++index;
+
+    if (matches.empty())
+      continue;
+
+    for (int index : matches) {
+      isMatched[index] = false;
+    }
+
+    std::sort(matches.begin(), matches.end());
+
+    communicationMap[other.first] = std::move(matches);
   }
   
   // CAUTION:
@@ -360,17 +391,84 @@ PointToPointCommunication::eventNamePrefix() {
   return _prefix;
 }
 
+/// Grows buffer to at least size values, sizes set at connection are kept.
+template<typename T>
+void
+reserveBuffer(std::vector<T>& buffer, size_t size) {
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+}
+
+/// Gathers the values of the given local indices into a contiguous buffer.
+template<typename T>
+void
+pack(double const* values,
+     std::vector<int> const& indices,
+     int valueDimension,
+     T* buffer) {
+  size_t count = indices.size();
+  int const* index = indices.data();
+
+  if (valueDimension == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      buffer[i] = static_cast<T>(values[index[i]]);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    double const* source = values + index[i] * valueDimension;
+    T* target = buffer + i * valueDimension;
+
+    for (int d = 0; d < valueDimension; ++d) {
+      target[d] = static_cast<T>(source[d]);
+    }
+  }
+}
+
+/// Adds the values of a contiguous buffer to the values of the given local indices.
+template<typename T>
+void
+unpack(T const* buffer,
+       std::vector<int> const& indices,
+       int valueDimension,
+       double* values) {
+  size_t count = indices.size();
+  int const* index = indices.data();
+
+  if (valueDimension == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      values[index[i]] += buffer[i];
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    T const* source = buffer + i * valueDimension;
+    double* target = values + index[i] * valueDimension;
+
+    for (int d = 0; d < valueDimension; ++d) {
+      target[d] += source[d];
+    }
+  }
+}
+
 tarch::logging::Log PointToPointCommunication::_log(
     "precice::m2n::PointToPointCommunication");
 
 PointToPointCommunication::PointToPointCommunication(
     com::CommunicationFactory::SharedPointer communicationFactory,
-    mesh::PtrMesh mesh)
+    mesh::PtrMesh mesh,
+    bool singlePrecision)
     : DistributedCommunication(mesh)
     , _communicationFactory(communicationFactory)
+    , _singlePrecision(singlePrecision)
     , _localIndexCount(0)
     , _totalIndexCount(0)
-    , _isConnected(false) {
+    , _isConnected(false)
+    , _isSendPending(false)
+    , _isReceivePending(false) {
 }
 
 PointToPointCommunication::~PointToPointCommunication() {
@@ -435,7 +533,8 @@ PointToPointCommunication::acceptConnection(std::string const& nameAcceptor,
   // - has to communicate (send/receive) data with local indices 0 and 2 with
   //   the remote process with rank 4.
   std::map<int, std::vector<int>> communicationMap = m2n::buildCommunicationMap(
-      _localIndexCount, vertexDistribution, requesterVertexDistribution);
+      _localIndexCount, vertexDistribution, requesterVertexDistribution,
+      utils::MasterSlave::_rank);
 
 // Print `communicationMap'.
 #ifdef P2P_LCM_PRINT
@@ -499,11 +598,24 @@ PointToPointCommunication::acceptConnection(std::string const& nameAcceptor,
 
   _mappings.reserve(communicationMap.size());
 
+  // Receive the ranks of all requesters at once, such that a slow requester
+  // does not delay the others.
+  std::vector<int> globalRequesterRanks(communicationMap.size(), -1);
+  std::vector<com::Request::SharedPointer> requests;
+
+  requests.reserve(communicationMap.size());
+
   for (size_t localRequesterRank = 0; localRequesterRank < communicationMap.size();
        ++localRequesterRank) {
-    int globalRequesterRank = -1;
+    requests.push_back(
+        c->aReceive(&globalRequesterRanks[localRequesterRank], localRequesterRank));
+  }
 
-    c->receive(globalRequesterRank, localRequesterRank);
+  com::Request::wait(requests);
+
+  for (size_t localRequesterRank = 0; localRequesterRank < communicationMap.size();
+       ++localRequesterRank) {
+    int globalRequesterRank = globalRequesterRanks[localRequesterRank];
 
     auto indices = std::move(communicationMap[globalRequesterRank]);
 
@@ -526,7 +638,7 @@ PointToPointCommunication::acceptConnection(std::string const& nameAcceptor,
          c});
   }
 
-  _buffer.reserve(_totalIndexCount * _mesh->getDimensions());
+  allocateBuffers();
 
   _isConnected = true;
 }
@@ -592,7 +704,8 @@ PointToPointCommunication::requestConnection(std::string const& nameAcceptor,
   // - has to communicate (send/receive) data with local indices 0 and 2 with
   //   the remote process with rank 4.
   std::map<int, std::vector<int>> communicationMap = m2n::buildCommunicationMap(
-      _localIndexCount, vertexDistribution, acceptorVertexDistribution);
+      _localIndexCount, vertexDistribution, acceptorVertexDistribution,
+      utils::MasterSlave::_rank);
 
 // Print `communicationMap'.
 #ifdef P2P_LCM_PRINT
@@ -681,7 +794,7 @@ PointToPointCommunication::requestConnection(std::string const& nameAcceptor,
 
   com::Request::wait(requests);
 
-  _buffer.reserve(_totalIndexCount * _mesh->getDimensions());
+  allocateBuffers();
 
   _isConnected = true;
 }
@@ -699,8 +812,6 @@ PointToPointCommunication::closeConnection() {
 
   _mappings.clear();
 
-  _buffer.clear();
-
   _localIndexCount = 0;
 
   _totalIndexCount = 0;
@@ -712,82 +823,194 @@ void
 PointToPointCommunication::send(double* itemsToSend,
                                 size_t size,
                                 int valueDimension) {
+  DataValues data = {itemsToSend, size, valueDimension};
+  startSend(&data, 1);
+  finishSend();
+}
 
-  if (_mappings.size() == 0) {
-    preciceCheck(size==0, "send()", "preCICE trys to communicate data to/from a processor that has no surface "
-                                 << "overlay with the connected participant. Please check the definition of your "
-                                 << "coupling surfaces.");
-    assertion(_localIndexCount==0);
+void
+PointToPointCommunication::receive(double* itemsToReceive,
+                                   size_t size,
+                                   int valueDimension) {
+  DataValues data = {itemsToReceive, size, valueDimension};
+  startReceive(&data, 1);
+  finishReceive();
+}
+
+void
+PointToPointCommunication::send(std::vector<DataValues> const& data) {
+  startSend(data.data(), data.size());
+  finishSend();
+}
+
+void
+PointToPointCommunication::receive(std::vector<DataValues> const& data) {
+  startReceive(data.data(), data.size());
+  finishReceive();
+}
+
+void
+PointToPointCommunication::startSend(std::vector<DataValues> const& data) {
+  startSend(data.data(), data.size());
+}
+
+void
+PointToPointCommunication::finishSend() {
+  if (not _isSendPending) {
     return;
   }
 
-  assertion(size == _localIndexCount * valueDimension, size,_localIndexCount * valueDimension);
-
   for (auto& mapping : _mappings) {
-    mapping.offset = _buffer.size();
+    mapping.sendRequest->wait();
+    mapping.sendRequest.reset();
+  }
 
-    for (auto index : mapping.indices) {
-      for (int d = 0; d < valueDimension; ++d) {
-        _buffer.push_back(itemsToSend[index * valueDimension + d]);
-      }
-    }
+  _isSendPending = false;
+}
 
-    mapping.request =
-        mapping.communication->aSend(_buffer.data() + mapping.offset,
-                                     mapping.indices.size() * valueDimension,
-                                     mapping.localRemoteRank);
+void
+PointToPointCommunication::startReceive(std::vector<DataValues> const& data) {
+  startReceive(data.data(), data.size());
+}
+
+void
+PointToPointCommunication::finishReceive() {
+  if (not _isReceivePending) {
+    return;
   }
 
+  // The values are kept until here, as they may still be read while the
+  // receives are pending
+  for (DataValues const& data : _pendingReceiveData) {
+    std::fill(data.values, data.values + data.size, 0);
+  }
+
+  // Values are accumulated in double precision
   for (auto& mapping : _mappings) {
-    mapping.request->wait();
+    mapping.receiveRequest->wait();
+    mapping.receiveRequest.reset();
+    size_t offset = 0;
+
+    for (DataValues const& data : _pendingReceiveData) {
+      if (_singlePrecision) {
+        unpack(mapping.floatReceiveBuffer.data() + offset, mapping.indices,
+               data.valueDimension, data.values);
+      } else {
+        unpack(mapping.receiveBuffer.data() + offset, mapping.indices,
+               data.valueDimension, data.values);
+      }
+      offset += mapping.indices.size() * data.valueDimension;
+    }
   }
 
-  _buffer.clear();
+  _isReceivePending = false;
 }
 
 void
-PointToPointCommunication::receive(double* itemsToReceive,
-                                   size_t size,
-                                   int valueDimension) {
+PointToPointCommunication::startSend(DataValues const* data, size_t dataCount) {
+  assertion(not _isSendPending);
+  int totalDimension = 0;
+
+  for (size_t i = 0; i < dataCount; ++i) {
+    if (_mappings.size() == 0) {
+      preciceCheck(data[i].size==0, "send()", "preCICE trys to communicate data to/from a processor that has no surface "
+                                   << "overlay with the connected participant. Please check the definition of your "
+                                   << "coupling surfaces.");
+    }
+    assertion(data[i].size == _localIndexCount * data[i].valueDimension,
+              data[i].size, _localIndexCount * data[i].valueDimension);
+    totalDimension += data[i].valueDimension;
+  }
+
   if (_mappings.size() == 0) {
-    preciceCheck(size==0, "send()", "preCICE trys to communicate data to/from a processor that has no surface "
-                                     << "overlay with the connected participant. Please check the definition of your "
-                                     << "coupling surfaces.");
     assertion(_localIndexCount==0);
     return;
   }
 
-  assertion(size == _localIndexCount * valueDimension, size,_localIndexCount * valueDimension);
-
-  std::fill(itemsToReceive, itemsToReceive + size, 0);
-
+  // Every mapping packs all data into its own send buffer, such that buffers
+  // of pending sends are never touched and only one message per remote rank
+  // is sent
   for (auto& mapping : _mappings) {
-    mapping.offset = _buffer.size();
+    size_t count = mapping.indices.size() * totalDimension;
+    size_t offset = 0;
+
+    if (_singlePrecision) {
+      reserveBuffer(mapping.floatSendBuffer, count);
+      for (size_t i = 0; i < dataCount; ++i) {
+        pack(data[i].values, mapping.indices, data[i].valueDimension,
+             mapping.floatSendBuffer.data() + offset);
+        offset += mapping.indices.size() * data[i].valueDimension;
+      }
+      mapping.sendRequest = mapping.communication->aSend(
+          mapping.floatSendBuffer.data(), count, mapping.localRemoteRank);
+    } else {
+      reserveBuffer(mapping.sendBuffer, count);
+      for (size_t i = 0; i < dataCount; ++i) {
+        pack(data[i].values, mapping.indices, data[i].valueDimension,
+             mapping.sendBuffer.data() + offset);
+        offset += mapping.indices.size() * data[i].valueDimension;
+      }
+      mapping.sendRequest = mapping.communication->aSend(
+          mapping.sendBuffer.data(), count, mapping.localRemoteRank);
+    }
+  }
 
-    _buffer.resize(_buffer.size() + mapping.indices.size() * valueDimension);
+  _isSendPending = true;
+}
+
+void
+PointToPointCommunication::startReceive(DataValues const* data, size_t dataCount) {
+  assertion(not _isReceivePending);
+  int totalDimension = 0;
+
+  for (size_t i = 0; i < dataCount; ++i) {
+    if (_mappings.size() == 0) {
+      preciceCheck(data[i].size==0, "receive()", "preCICE trys to communicate data to/from a processor that has no surface "
+                                       << "overlay with the connected participant. Please check the definition of your "
+                                       << "coupling surfaces.");
+    }
+    assertion(data[i].size == _localIndexCount * data[i].valueDimension,
+              data[i].size, _localIndexCount * data[i].valueDimension);
+    totalDimension += data[i].valueDimension;
+  }
 
-    mapping.request =
-        mapping.communication->aReceive(_buffer.data() + mapping.offset,
-                                        mapping.indices.size() * valueDimension,
-                                        mapping.localRemoteRank);
+  if (_mappings.size() == 0) {
+    assertion(_localIndexCount==0);
+    return;
   }
 
   for (auto& mapping : _mappings) {
-    mapping.request->wait();
-
-    int i = 0;
+    size_t count = mapping.indices.size() * totalDimension;
+
+    if (_singlePrecision) {
+      reserveBuffer(mapping.floatReceiveBuffer, count);
+      mapping.receiveRequest = mapping.communication->aReceive(
+          mapping.floatReceiveBuffer.data(), count, mapping.localRemoteRank);
+    } else {
+      reserveBuffer(mapping.receiveBuffer, count);
+      mapping.receiveRequest = mapping.communication->aReceive(
+          mapping.receiveBuffer.data(), count, mapping.localRemoteRank);
+    }
+  }
 
-    for (auto index : mapping.indices) {
-      for (int d = 0; d < valueDimension; ++d) {
-        itemsToReceive[index * valueDimension + d] +=
-            _buffer[mapping.offset + i * valueDimension + d];
-      }
+  _pendingReceiveData.assign(data, data + dataCount);
+  _isReceivePending = true;
+}
 
-      i++;
+void
+PointToPointCommunication::allocateBuffers() {
+  // Data is at most vector valued, i.e. has the dimensions of the mesh
+  for (auto& mapping : _mappings) {
+    size_t count = mapping.indices.size() * _mesh->getDimensions();
+
+    if (_singlePrecision) {
+      mapping.floatSendBuffer.resize(count);
+      mapping.floatReceiveBuffer.resize(count);
+    } else {
+      mapping.sendBuffer.resize(count);
+      mapping.receiveBuffer.resize(count);
     }
   }
-
-  _buffer.clear();
 }
 }
 } // namespace precice, m2n
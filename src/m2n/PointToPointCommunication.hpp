@@ -13,8 +13,27 @@
 #include "mesh/SharedPointer.hpp"
 #include "tarch/logging/Log.h"
 
+#include <map>
+#include <vector>
+
 namespace precice {
 namespace m2n {
+
+/**
+ * @brief Builds the local communication map of rank thisRank.
+ *
+ * Maps every rank of the remote participant to the (sorted) positions of
+ * those local indices of thisRank, which the remote rank holds as well.
+ *
+ * @param localIndexCount [OUT] Number of local indices of thisRank, zero if
+ *        there is no communication partner.
+ */
+std::map<int, std::vector<int>>
+buildCommunicationMap(size_t& localIndexCount,
+                      std::map<int, std::vector<int>> const& thisVertexDistribution,
+                      std::map<int, std::vector<int>> const& otherVertexDistribution,
+                      int thisRank);
+
 /**
  * @brief Point-to-point communication implementation of
  *        DistributedCommunication.
@@ -25,6 +44,10 @@ namespace m2n {
  * supplied via their corresponding instantiation factories
  * SocketCommunicationFactory and MPIPortsCommunicationFactory.
  *
+ * With single precision enabled, data values are converted to float for the
+ * transfer only, halving the number of bytes sent. Received values are still
+ * accumulated in double precision.
+ *
  * For the detailed implementation documentation refer to
  * PointToPointCommunication.cpp.
  */
@@ -47,10 +70,13 @@ public:
 public:
   /**
    * @brief Constructor.
+   *
+   * @param singlePrecision [IN] Transfer data values as float instead of double.
    */
   PointToPointCommunication(
       com::CommunicationFactory::SharedPointer communicationFactory,
-      mesh::PtrMesh mesh);
+      mesh::PtrMesh mesh,
+      bool singlePrecision = false);
 
   /**
    * @brief Destructor.
@@ -104,6 +130,41 @@ public:
                        size_t size,
                        int valueDimension = 1);
 
+  /**
+   * @brief Sends the values of several data, all of them are packed into one
+   *        message per remote process rank.
+   */
+  virtual void send(std::vector<DataValues> const& data);
+
+  /**
+   * @brief Receives the values of several data, which arrive packed in one
+   *        message per remote process rank.
+   */
+  virtual void receive(std::vector<DataValues> const& data);
+
+  /**
+   * @brief Packs the values of several data and posts one non-blocking send
+   *        per remote process rank.
+   *
+   * The values may be changed right after the call, the send buffers are only
+   * reused after finishSend().
+   */
+  virtual void startSend(std::vector<DataValues> const& data);
+
+  /// Waits until the sends posted by startSend() are completed.
+  virtual void finishSend();
+
+  /**
+   * @brief Posts one non-blocking receive per remote process rank for the
+   *        values of several data.
+   *
+   * The values must not be accessed before finishReceive() is called.
+   */
+  virtual void startReceive(std::vector<DataValues> const& data);
+
+  /// Waits for the receives posted by startReceive() and unpacks the values.
+  virtual void finishReceive();
+
 private:
   static tarch::logging::Log _log;
 
@@ -120,15 +181,23 @@ private:
    *           rank in the current participant) data to be communicated between
    *           the current process rank and the remote process rank;
    *        4. communication object (provides point-to-point communication
-   *           routines).
+   *           routines);
+   *        5. transfer buffers, allocated at connection and reused by all
+   *           send() and receive() calls. Sends and receives have their own
+   *           requests and buffers, such that both can be pending at once.
    */
   struct Mapping {
     int localRemoteRank;
     int globalRemoteRank;
     std::vector<int> indices;
     com::Communication::SharedPointer communication;
-    com::Request::SharedPointer request;
-    size_t offset;
+    com::Request::SharedPointer sendRequest;
+    com::Request::SharedPointer receiveRequest;
+    std::vector<double> sendBuffer;
+    std::vector<double> receiveBuffer;
+    /// Used instead of the buffers above, if data is transferred in single precision.
+    std::vector<float> floatSendBuffer;
+    std::vector<float> floatReceiveBuffer;
   };
 
   /**
@@ -137,13 +206,27 @@ private:
    */
   std::vector<Mapping> _mappings;
 
-  std::vector<double> _buffer;
+  bool _singlePrecision;
 
   size_t _localIndexCount;
 
   size_t _totalIndexCount;
 
   bool _isConnected;
+
+  bool _isSendPending;
+
+  bool _isReceivePending;
+
+  /// Data of the pending receive, unpacked in finishReceive().
+  std::vector<DataValues> _pendingReceiveData;
+
+  /// Sizes the transfer buffers of all mappings for vector valued data.
+  void allocateBuffers();
+
+  void startSend(DataValues const* data, size_t dataCount);
+
+  void startReceive(DataValues const* data, size_t dataCount);
 };
 }
 } // namespace precice, m2n
@@ -7,6 +7,8 @@
 #include "m2n/GatherScatterComFactory.hpp"
 #include "m2n/PointToPointComFactory.hpp"
 #include "com/SocketCommunicationFactory.hpp"
+#include "com/SocketIOService.hpp"
+#include "com/SharedMemoryCommunicationFactory.hpp"
 #include "com/MPIPortsCommunicationFactory.hpp"
 #include "com/FileCommunication.hpp"
 #include "com/MPIDirectCommunication.hpp"
@@ -33,10 +35,14 @@ M2NConfiguration:: M2NConfiguration
   ATTR_PORT("port"),
   ATTR_NETWORK("network"),
   ATTR_EXCHANGE_DIRECTORY("exchange-directory"),
+  ATTR_SINGLE_PRECISION("single-precision"),
+  ATTR_BUFFER_SIZE("buffer-size"),
+  ATTR_IO_THREADS("io-threads"),
   VALUE_MPI("mpi"),
   VALUE_MPI_SINGLE("mpi-single"),
   VALUE_FILES("files"),
   VALUE_SOCKETS("sockets"),
+  VALUE_SHARED_MEMORY("shared-memory"),
   VALUE_GATHER_SCATTER("gather-scatter"),
   VALUE_POINT_TO_POINT("point-to-point"),
   _m2ns()
@@ -66,6 +72,45 @@ M2NConfiguration:: M2NConfiguration
     attrNetwork.setDefaultValue("lo");
     tag.addAttribute(attrNetwork);
 
+    XMLAttribute<int> attrBufferSize(ATTR_BUFFER_SIZE);
+    doc = "Size in bytes of the send and receive buffers the operating system ";
+    doc += "keeps per socket. The default is \"0\", what means that the system ";
+    doc += "defaults are used, which are adapted automatically on Linux.";
+    attrBufferSize.setDocumentation(doc);
+    attrBufferSize.setDefaultValue(0);
+    tag.addAttribute(attrBufferSize);
+
+    XMLAttribute<int> attrIOThreads(ATTR_IO_THREADS);
+    doc = "Number of threads running the asynchronous operations of all socket ";
+    doc += "connections of a process. If several socket connections are ";
+    doc += "configured, the largest number is used.";
+    attrIOThreads.setDocumentation(doc);
+    attrIOThreads.setDefaultValue(1);
+    tag.addAttribute(attrIOThreads);
+
+    XMLAttribute<std::string> attrExchangeDirectory(ATTR_EXCHANGE_DIRECTORY);
+    doc = "Directory where connection information is exchanged. By default, the ";
+    doc += "directory of startup is chosen, and both solvers have to be started ";
+    doc += "in the same directory.";
+    attrExchangeDirectory.setDocumentation(doc);
+    attrExchangeDirectory.setDefaultValue("");
+    tag.addAttribute(attrExchangeDirectory);
+
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_SHARED_MEMORY, occ, TAG);
+    doc = "Communication via POSIX shared memory. Can only be used, if both ";
+    doc += "participants run on the same node.";
+    tag.setDocumentation(doc);
+
+    XMLAttribute<int> attrBufferSize(ATTR_BUFFER_SIZE);
+    doc = "Size in bytes of the ring buffer per direction and pair of connected ";
+    doc += "processes. Larger messages are transferred in several pieces.";
+    attrBufferSize.setDocumentation(doc);
+    attrBufferSize.setDefaultValue(1 << 20);
+    tag.addAttribute(attrBufferSize);
+
     XMLAttribute<std::string> attrExchangeDirectory(ATTR_EXCHANGE_DIRECTORY);
     doc = "Directory where connection information is exchanged. By default, the ";
     doc += "directory of startup is chosen, and both solvers have to be started ";
@@ -128,6 +173,13 @@ M2NConfiguration:: M2NConfiguration
   attrDistrTypeOnly.setValidator ( validDistrGatherScatter );
   attrDistrTypeOnly.setDefaultValue(VALUE_GATHER_SCATTER);
 
+  XMLAttribute<bool> attrSinglePrecision(ATTR_SINGLE_PRECISION);
+  doc = "If true, data values are exchanged in single precision, which halves ";
+  doc += "the amount of transferred bytes. Values are still stored and accumulated ";
+  doc += "in double precision. Requires distribution type \"point-to-point\".";
+  attrSinglePrecision.setDocumentation(doc);
+  attrSinglePrecision.setDefaultValue(false);
+
   XMLAttribute<std::string> attrFrom ( ATTR_FROM );
   doc = "First participant name involved in communication.";
   attrFrom.setDocumentation(doc);
@@ -138,8 +190,10 @@ M2NConfiguration:: M2NConfiguration
   for (XMLTag& tag : tags) {
     tag.addAttribute(attrFrom);
     tag.addAttribute(attrTo);
-    if(tag.getName() == VALUE_MPI || tag.getName() == VALUE_SOCKETS){
+    if(tag.getName() == VALUE_MPI || tag.getName() == VALUE_SOCKETS
+       || tag.getName() == VALUE_SHARED_MEMORY){
       tag.addAttribute(attrDistrTypeBoth);
+      tag.addAttribute(attrSinglePrecision);
     }
     else{
       tag.addAttribute(attrDistrTypeOnly);
@@ -195,11 +249,45 @@ void M2NConfiguration:: xmlTagCallback
                      "The value given for the \"port\" attribute is not a "
                      "16-bit unsigned integer: " << port);
 
+        int bufferSize = tag.getIntAttributeValue(ATTR_BUFFER_SIZE);
+
+        preciceCheck(bufferSize >= 0, "xmlTagCallback()",
+                     "The value given for the \"buffer-size\" attribute must "
+                     "not be negative: " << bufferSize);
+
+        int ioThreads = tag.getIntAttributeValue(ATTR_IO_THREADS);
+
+        preciceCheck(ioThreads > 0, "xmlTagCallback()",
+                     "The value given for the \"io-threads\" attribute has to "
+                     "be positive: " << ioThreads);
+
+        com::SocketIOService::setThreadCount(ioThreads);
+
         std::string dir = tag.getStringAttributeValue(ATTR_EXCHANGE_DIRECTORY);
         comFactory = com::CommunicationFactory::SharedPointer(
-            new com::SocketCommunicationFactory(port, false, network, dir));
+            new com::SocketCommunicationFactory(port, false, network, dir,
+                                                bufferSize));
         com = comFactory->newCommunication();
 #     endif // PRECICE_NO_SOCKETS
+    }
+    else if (tag.getName() == VALUE_SHARED_MEMORY){
+#     ifdef PRECICE_NO_SHARED_MEMORY
+        std::ostringstream error;
+        error << "M2N type \"" << VALUE_SHARED_MEMORY << "\" can only be used "
+              << "when preCICE is compiled with argument \"sharedmemory=on\" on Linux";
+        throw error.str();
+#     else
+        int bufferSize = tag.getIntAttributeValue(ATTR_BUFFER_SIZE);
+
+        preciceCheck(bufferSize > 0, "xmlTagCallback()",
+                     "The value given for the \"buffer-size\" attribute has to "
+                     "be positive: " << bufferSize);
+
+        std::string dir = tag.getStringAttributeValue(ATTR_EXCHANGE_DIRECTORY);
+        comFactory = com::CommunicationFactory::SharedPointer(
+            new com::SharedMemoryCommunicationFactory(dir, bufferSize));
+        com = comFactory->newCommunication();
+#     endif // PRECICE_NO_SHARED_MEMORY
     }
     else if (tag.getName() == VALUE_MPI){
       std::string dir = tag.getStringAttributeValue(ATTR_EXCHANGE_DIRECTORY);
@@ -235,11 +323,18 @@ void M2NConfiguration:: xmlTagCallback
     DistributedComFactory::SharedPointer distrFactory;
     if(tag.getName() == VALUE_MPI_SINGLE || tag.getName() == VALUE_FILES || distrType == VALUE_GATHER_SCATTER){
       assertion(distrType == VALUE_GATHER_SCATTER);
+      preciceCheck(not (tag.hasAttribute(ATTR_SINGLE_PRECISION)
+                        && tag.getBooleanAttributeValue(ATTR_SINGLE_PRECISION)),
+                   "xmlTagCallback()", "Attribute \"" << ATTR_SINGLE_PRECISION
+                   << "\" requires distribution type \"" << VALUE_POINT_TO_POINT << "\"!");
       distrFactory = DistributedComFactory::SharedPointer(new GatherScatterComFactory(com));
     }
     else if(distrType == VALUE_POINT_TO_POINT){
-      assertion(tag.getName() == VALUE_MPI || tag.getName() == VALUE_SOCKETS);
-      distrFactory = DistributedComFactory::SharedPointer(new PointToPointComFactory(comFactory));
+      assertion(tag.getName() == VALUE_MPI || tag.getName() == VALUE_SOCKETS
+                || tag.getName() == VALUE_SHARED_MEMORY);
+      bool singlePrecision = tag.getBooleanAttributeValue(ATTR_SINGLE_PRECISION);
+      distrFactory = DistributedComFactory::SharedPointer(
+          new PointToPointComFactory(comFactory, singlePrecision));
     }
     assertion(distrFactory.get() != nullptr);
 
@@ -15,6 +15,8 @@
 
 #include "tarch/tests/TestCaseFactory.h"
 
+#include <algorithm>
+#include <random>
 #include <vector>
 
 using precice::utils::Parallel;
@@ -50,6 +52,45 @@ equal(vector<double> const& data, vector<double> const& expectedData) {
   return valid;
 }
 
+// Matches every local index against all remote indices, as done before
+// buildCommunicationMap() used hashing.
+std::map<int, std::vector<int>>
+buildCommunicationMapBruteForce(
+    size_t& localIndexCount,
+    std::map<int, std::vector<int>> const& thisVertexDistribution,
+    std::map<int, std::vector<int>> const& otherVertexDistribution,
+    int thisRank) {
+  localIndexCount = 0;
+
+  std::map<int, std::vector<int>> communicationMap;
+
+  auto iterator = thisVertexDistribution.find(thisRank);
+
+  if (iterator == thisVertexDistribution.end())
+    return communicationMap;
+
+  auto const& indices = iterator->second;
+
+  int index = 0;
+
+  for (int thisIndex : indices) {
+    for (auto& other : otherVertexDistribution) {
+      for (auto& otherIndex : other.second) {
+        if (thisIndex == otherIndex) {
+          communicationMap[other.first].push_back(index);
+          break;
+        }
+      }
+    }
+    ++index;
+  }
+
+  if (communicationMap.size() > 0)
+    localIndexCount = indices.size();
+
+  return communicationMap;
+}
+
 tarch::logging::Log PointToPointCommunicationTest::_log(
     "precice::m2n::tests::PointToPointCommunicationTest");
 
@@ -61,6 +102,10 @@ void
 PointToPointCommunicationTest::run() {
   preciceTrace("run");
 
+  if (Parallel::getProcessRank() == 0) {
+    testMethod(testBuildCommunicationMap);
+  }
+
   Parallel::synchronizeProcesses();
 
   if (Parallel::getCommunicatorSize() > 3) {
@@ -72,6 +117,7 @@ PointToPointCommunicationTest::run() {
       testMethod(testSocketCommunication);
       #endif
       testMethod(testMPIPortsCommunication);
+      testMethod(testSinglePrecision);
       Parallel::setGlobalCommunicator(Parallel::getCommunicatorWorld());
     }
   }
@@ -99,9 +145,75 @@ PointToPointCommunicationTest::testMPIPortsCommunication() {
   test(cf);
 }
 
+void
+PointToPointCommunicationTest::testSinglePrecision() {
+  preciceTrace("testSinglePrecision");
+
+  com::CommunicationFactory::SharedPointer cf(
+      new com::MPIPortsCommunicationFactory);
+
+  // All values are exactly representable as float
+  test(cf, true);
+}
+
+void
+PointToPointCommunicationTest::testBuildCommunicationMap() {
+  preciceTrace("testBuildCommunicationMap");
+
+  std::mt19937 generator(42);
+  int thisSize = 8;
+  int otherSize = 12;
+  int globalIndexCount = 5000;
+
+  // Every index is held by up to two ranks per participant, some ranks hold an
+  // index twice, and some indices are missing in the other participant
+  std::map<int, std::vector<int>> thisVertexDistribution;
+  std::map<int, std::vector<int>> otherVertexDistribution;
+  std::uniform_int_distribution<int> thisRanks(0, thisSize - 1);
+  std::uniform_int_distribution<int> otherRanks(0, otherSize - 1);
+  std::uniform_int_distribution<int> percent(0, 99);
+
+  for (int index = 0; index < globalIndexCount; ++index) {
+    thisVertexDistribution[thisRanks(generator)].push_back(index);
+
+    if (percent(generator) < 20)
+      thisVertexDistribution[thisRanks(generator)].push_back(index);
+
+    if (percent(generator) < 5)
+      continue;
+
+    int otherRank = otherRanks(generator);
+    otherVertexDistribution[otherRank].push_back(index);
+
+    if (percent(generator) < 20)
+      otherVertexDistribution[otherRanks(generator)].push_back(index);
+
+    if (percent(generator) < 2)
+      otherVertexDistribution[otherRank].push_back(index);
+  }
+
+  for (auto& ranks : otherVertexDistribution) {
+    std::shuffle(ranks.second.begin(), ranks.second.end(), generator);
+  }
+
+  // Rank thisSize holds no indices
+  for (int rank = 0; rank <= thisSize; ++rank) {
+    size_t localIndexCount = 1;
+    size_t expectedLocalIndexCount = 1;
+    auto communicationMap = m2n::buildCommunicationMap(
+        localIndexCount, thisVertexDistribution, otherVertexDistribution, rank);
+    auto expectedCommunicationMap = buildCommunicationMapBruteForce(
+        expectedLocalIndexCount, thisVertexDistribution, otherVertexDistribution, rank);
+
+    validateEquals(localIndexCount, expectedLocalIndexCount);
+    validate(communicationMap == expectedCommunicationMap);
+  }
+}
+
 void
 PointToPointCommunicationTest::test(
-    com::CommunicationFactory::SharedPointer cf) {
+    com::CommunicationFactory::SharedPointer cf,
+    bool singlePrecision) {
   assertion(Parallel::getCommunicatorSize() == 4);
 
   validateEquals(Parallel::getCommunicatorSize(), 4);
@@ -111,7 +223,7 @@ PointToPointCommunicationTest::test(
 
   mesh::PtrMesh mesh(new mesh::Mesh("Mesh", 2, true));
 
-  m2n::PointToPointCommunication c(cf, mesh);
+  m2n::PointToPointCommunication c(cf, mesh, singlePrecision);
 
   vector<double> data;
   vector<double> expectedData;
@@ -209,7 +321,20 @@ PointToPointCommunicationTest::test(
   }
   }
 
+  // Scalar and vector valued data, which are fused into one message
+  vector<double> scalarData(data.size());
+  vector<double> vectorData(2 * data.size());
+  vector<DistributedCommunication::DataValues> fusedData = {
+    {scalarData.data(), scalarData.size(), 1},
+    {vectorData.data(), vectorData.size(), 2}};
+
   if (Parallel::getProcessRank() < 2) {
+    scalarData = data;
+    for (size_t i = 0; i < data.size(); ++i) {
+      vectorData[2 * i] = data[i];
+      vectorData[2 * i + 1] = -data[i];
+    }
+
     c.requestConnection("B", "A");
 
     c.send(data.data(), data.size());
@@ -217,6 +342,8 @@ PointToPointCommunicationTest::test(
     c.receive(data.data(), data.size());
 
     validate(equal(data, expectedData));
+
+    c.send(fusedData);
   } else {
     c.acceptConnection("B", "A");
 
@@ -227,6 +354,14 @@ PointToPointCommunicationTest::test(
     process(data);
 
     c.send(data.data(), data.size());
+
+    c.receive(fusedData);
+
+    validate(equal(scalarData, expectedData));
+    for (size_t i = 0; i < expectedData.size(); ++i) {
+      validateEquals(vectorData[2 * i], expectedData[i]);
+      validateEquals(vectorData[2 * i + 1], -expectedData[i]);
+    }
   }
 
   MasterSlave::_communication.reset();
@@ -42,7 +42,14 @@ private:
 
   void testMPIPortsCommunication();
 
-  void test(com::CommunicationFactory::SharedPointer cf);
+  /// Transfers data values in single precision.
+  void testSinglePrecision();
+
+  void test(com::CommunicationFactory::SharedPointer cf,
+            bool singlePrecision = false);
+
+  /// Compares buildCommunicationMap() to a brute force search.
+  void testBuildCommunicationMap();
 };
 }
 }
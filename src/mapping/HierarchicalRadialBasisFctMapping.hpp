@@ -0,0 +1,477 @@
+#pragma once
+
+#include "Mapping.hpp"
+#include "impl/BasisFunctions.hpp"
+#include "impl/HMatrix.hpp"
+#include "utils/MasterSlave.hpp"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Eigen/Core"
+
+namespace precice {
+namespace mapping {
+
+/**
+ * @brief Mapping with radial basis functions, using hierarchical matrices.
+ *
+ * Builds the same interpolant as RadialBasisFctMapping, but the kernel parts
+ * of the interpolation matrix C and the evaluation matrix A are approximated
+ * by hierarchical matrices (see HMatrix), such that storage and products cost
+ * about O(n log n) instead of O(n^2). The polynomial parts are applied directly.
+ *
+ * C is not factorized, the interpolation system is solved by restarted GMRES,
+ * which needs products with C only. The solution of the previous map() call
+ * is used as initial guess. The number of iterations depends on the
+ * conditioning of C, i.e., on the basis function and its shape parameter.
+ *
+ * Intended for basis functions with global support, which lead to dense
+ * matrices otherwise.
+ */
+template<typename RADIAL_BASIS_FUNCTION_T>
+class HierarchicalRadialBasisFctMapping : public Mapping
+{
+public:
+
+  /**
+   * @brief Constructor.
+   *
+   * @param constraint [IN] Specifies mapping to be consistent or conservative.
+   * @param function [IN] Radial basis function used for mapping.
+   * @param tolerance [IN] Relative accuracy of the low-rank blocks of C and A.
+   * @param solverRtol [IN] Relative residual norm at which GMRES stops.
+   * @param threads [IN] Number of threads used to approximate C and A.
+   */
+  HierarchicalRadialBasisFctMapping (
+    Constraint              constraint,
+    int                     dimensions,
+    RADIAL_BASIS_FUNCTION_T function,
+    bool                    xDead,
+    bool                    yDead,
+    bool                    zDead,
+    double                  tolerance = 1e-6,
+    double                  solverRtol = 1e-9,
+    int                     threads = 1 );
+
+  virtual ~HierarchicalRadialBasisFctMapping() {}
+
+  /// Approximates C and A from the in- and output mesh.
+  virtual void computeMapping() override;
+
+  /// Returns true, if computeMapping() has been called.
+  virtual bool hasComputedMapping() const override;
+
+  /// Removes a computed mapping.
+  virtual void clear() override;
+
+  /// Maps input data to output data from input mesh to output mesh.
+  virtual void map (
+    int inputDataID,
+    int outputDataID ) override;
+
+  /// Maps all components of all given data.
+  virtual void map ( const DataPairs& dataPairs ) override;
+
+  /// Returns the number of stored entries of C and A, for testing and statistics.
+  size_t storageSize() const;
+
+private:
+
+  static tarch::logging::Log _log;
+
+  /// Number of Krylov vectors before GMRES is restarted.
+  static const int _restart = 100;
+
+  /// Maximal number of GMRES iterations per right-hand side.
+  static const int _maxIterations = 10000;
+
+  RADIAL_BASIS_FUNCTION_T _basisFunction;
+
+  double _tolerance;
+
+  double _solverRtol;
+
+  int _threads;
+
+  /// true if the mapping along some axis should be ignored
+  std::vector<bool> _deadAxis;
+
+  /// Kernel part of C.
+  std::unique_ptr<HMatrix<RADIAL_BASIS_FUNCTION_T>> _matrixC;
+
+  /// Kernel part of A.
+  std::unique_ptr<HMatrix<RADIAL_BASIS_FUNCTION_T>> _matrixA;
+
+  /// Polynomial parts of C and A, rows [1, x] of the in- and output points of C.
+  Eigen::MatrixXd _polynomialC;
+  Eigen::MatrixXd _polynomialA;
+
+  /// Solutions of the previous map() calls per output data ID, initial guesses for the next ones.
+  std::map<int, Eigen::MatrixXd> _previousSolutions;
+
+  /// Returns the coordinates of all vertices without dead axes, one column per vertex.
+  Eigen::MatrixXd getPoints ( const mesh::Mesh& mesh ) const;
+
+  /// Computes out = C * in.
+  void multiplyC (
+    const Eigen::MatrixXd& in,
+    Eigen::MatrixXd&       out ) const;
+
+  /// Solves C * X = rhs by GMRES for all columns of rhs, the solution overwrites rhs.
+  void solveC (
+    const DataPairs& dataPairs,
+    Eigen::MatrixXd& rhs );
+
+  /// Solves C * x = b by restarted GMRES, x holds the initial guess.
+  void gmres (
+    const Eigen::VectorXd& b,
+    Eigen::VectorXd&       x ) const;
+};
+
+// --------------------------------------------------- HEADER IMPLEMENTATIONS
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+tarch::logging::Log HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::
+_log ( "precice::mapping::HierarchicalRadialBasisFctMapping" );
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+const int HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: _restart;
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+const int HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: _maxIterations;
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: HierarchicalRadialBasisFctMapping
+(
+  Constraint              constraint,
+  int                     dimensions,
+  RADIAL_BASIS_FUNCTION_T function,
+  bool                    xDead,
+  bool                    yDead,
+  bool                    zDead,
+  double                  tolerance,
+  double                  solverRtol,
+  int                     threads )
+:
+  Mapping ( constraint, dimensions ),
+  _basisFunction ( function ),
+  _tolerance ( tolerance ),
+  _solverRtol ( solverRtol ),
+  _threads ( threads ),
+  _deadAxis ( dimensions, false ),
+  _matrixC (),
+  _matrixA (),
+  _polynomialC (),
+  _polynomialA (),
+  _previousSolutions ()
+{
+  setInputRequirement(VERTEX);
+  setOutputRequirement(VERTEX);
+  preciceCheck(tolerance > 0.0, "HierarchicalRadialBasisFctMapping()",
+               "Tolerance of hierarchical RBF mapping has to be larger than zero!");
+  preciceCheck(threads > 0, "HierarchicalRadialBasisFctMapping()",
+               "Number of threads for RBF mapping has to be larger than zero!");
+  _deadAxis[0] = xDead;
+  _deadAxis[1] = yDead;
+  if (dimensions == 2) {
+    preciceCheck(not (xDead && yDead), "HierarchicalRadialBasisFctMapping()",
+                 "You cannot choose all axis to be dead for a RBF mapping");
+    if (zDead) preciceWarning("HierarchicalRadialBasisFctMapping()", "Setting the z-axis "
+                              << "to dead on a 2 dimensional problem has not effect and will be ignored.");
+  }
+  else {
+    assertion(dimensions == 3, dimensions);
+    _deadAxis[2] = zDead;
+    preciceCheck(not (xDead && yDead && zDead), "HierarchicalRadialBasisFctMapping()",
+                 "You cannot choose all axis to be dead for a RBF mapping");
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
+{
+  preciceTrace("computeMapping()");
+  preciceCheck(not utils::MasterSlave::_slaveMode && not utils::MasterSlave::_masterMode,
+               "computeMapping()", "RBF mapping  "
+               << " is not yet supported for a participant in master mode");
+  assertion(input()->getDimensions() == output()->getDimensions(),
+             input()->getDimensions(), output()->getDimensions());
+  mesh::PtrMesh inMesh;
+  mesh::PtrMesh outMesh;
+  if (getConstraint() == CONSERVATIVE){
+    inMesh = output();
+    outMesh = input();
+  }
+  else {
+    inMesh = input();
+    outMesh = output();
+  }
+  Eigen::MatrixXd inPoints = getPoints(*inMesh);
+  Eigen::MatrixXd outPoints = getPoints(*outMesh);
+  int polyparams = 1 + inPoints.rows();
+  assertion(inPoints.cols() >= 1 + polyparams, inPoints.cols());
+
+  _matrixC.reset(new HMatrix<RADIAL_BASIS_FUNCTION_T>(inPoints, inPoints,
+                 _basisFunction, _tolerance, _threads));
+  _matrixA.reset(new HMatrix<RADIAL_BASIS_FUNCTION_T>(outPoints, inPoints,
+                 _basisFunction, _tolerance, _threads));
+  _polynomialC.resize(inPoints.cols(), polyparams);
+  _polynomialC.col(0).setOnes();
+  _polynomialC.rightCols(polyparams - 1) = inPoints.transpose();
+  _polynomialA.resize(outPoints.cols(), polyparams);
+  _polynomialA.col(0).setOnes();
+  _polynomialA.rightCols(polyparams - 1) = outPoints.transpose();
+
+  preciceDebug("Stored entries of C and A: " << storageSize() << ", dense: "
+               << inPoints.cols() * (inPoints.cols() + outPoints.cols()));
+
+  // Previous solutions are kept as initial guesses, if the size of C is unchanged
+  if ((not _previousSolutions.empty())
+      && (_previousSolutions.begin()->second.rows() != inPoints.cols() + polyparams)){
+    _previousSolutions.clear();
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: hasComputedMapping() const
+{
+  return _matrixC.get() != nullptr;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: clear()
+{
+  preciceTrace("clear()");
+  _matrixC.reset();
+  _matrixA.reset();
+  _polynomialC.resize(0, 0);
+  _polynomialA.resize(0, 0);
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+size_t HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: storageSize() const
+{
+  assertion(hasComputedMapping());
+  return _matrixC->storageSize() + _matrixA->storageSize();
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
+(
+  int inputDataID,
+  int outputDataID )
+{
+  preciceTrace2("map()", inputDataID, outputDataID);
+  output()->data(outputDataID)->values().setZero();
+  map(DataPairs(1, std::make_pair(inputDataID, outputDataID)));
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
+(
+  const DataPairs& dataPairs )
+{
+  preciceTrace1("map()", dataPairs.size());
+  assertion(hasComputedMapping());
+  // Data values are viewed as matrices with one row per vertex
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> ValuesMatrix;
+  int columns = 0;
+  for (const std::pair<int,int>& dataPair : dataPairs) {
+    int valueDim = input()->data(dataPair.first)->getDimensions();
+    assertion(valueDim == output()->data(dataPair.second)->getDimensions(),
+               valueDim, output()->data(dataPair.second)->getDimensions());
+    columns += valueDim;
+  }
+  int vertices = _polynomialC.rows();
+  int polyparams = _polynomialC.cols();
+  int rowsA = _polynomialA.rows();
+  Eigen::MatrixXd coefficients(vertices + polyparams, columns);
+  Eigen::MatrixXd values(rowsA, columns);
+
+  if (getConstraint() == CONSERVATIVE){
+    preciceDebug("Map conservative");
+    int column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      const Eigen::VectorXd& inValues = input()->data(dataPair.first)->values();
+      int valueDim = input()->data(dataPair.first)->getDimensions();
+      values.middleCols(column, valueDim) =
+          Eigen::Map<const ValuesMatrix>(inValues.data(), rowsA, valueDim);
+      column += valueDim;
+    }
+    Eigen::MatrixXd kernelPart;
+    _matrixA->multiplyTransposed(values, kernelPart);
+    coefficients.topRows(vertices) = kernelPart;
+    coefficients.bottomRows(polyparams).noalias() = _polynomialA.transpose() * values;
+    solveC(dataPairs, coefficients);
+    column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      Eigen::VectorXd& outValues = output()->data(dataPair.second)->values();
+      int valueDim = output()->data(dataPair.second)->getDimensions();
+      Eigen::Map<ValuesMatrix>(outValues.data(), vertices, valueDim) +=
+          coefficients.topRows(vertices).middleCols(column, valueDim);
+      column += valueDim;
+    }
+  }
+  else { // Map consistent
+    preciceDebug("Map consistent");
+    coefficients.bottomRows(polyparams).setZero();
+    int column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      const Eigen::VectorXd& inValues = input()->data(dataPair.first)->values();
+      int valueDim = input()->data(dataPair.first)->getDimensions();
+      coefficients.topRows(vertices).middleCols(column, valueDim) =
+          Eigen::Map<const ValuesMatrix>(inValues.data(), vertices, valueDim);
+      column += valueDim;
+    }
+    solveC(dataPairs, coefficients);
+    _matrixA->multiply(coefficients.topRows(vertices), values);
+    values.noalias() += _polynomialA * coefficients.bottomRows(polyparams);
+    column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      Eigen::VectorXd& outValues = output()->data(dataPair.second)->values();
+      int valueDim = output()->data(dataPair.second)->getDimensions();
+      Eigen::Map<ValuesMatrix>(outValues.data(), rowsA, valueDim) +=
+          values.middleCols(column, valueDim);
+      column += valueDim;
+    }
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+Eigen::MatrixXd HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: getPoints
+(
+  const mesh::Mesh& mesh ) const
+{
+  int liveDimensions = 0;
+  for (bool dead : _deadAxis) {
+    if (not dead) liveDimensions++;
+  }
+  Eigen::MatrixXd points(liveDimensions, mesh.vertices().size());
+  for (const mesh::Vertex& vertex : mesh.vertices()) {
+    const utils::DynVector& coords = vertex.getCoords();
+    int row = 0;
+    for (int d=0; d < (int)_deadAxis.size(); d++) {
+      if (not _deadAxis[d]) {
+        points(row, vertex.getID()) = coords[d];
+        row++;
+      }
+    }
+  }
+  return points;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: multiplyC
+(
+  const Eigen::MatrixXd& in,
+  Eigen::MatrixXd&       out ) const
+{
+  int vertices = _polynomialC.rows();
+  int polyparams = _polynomialC.cols();
+  Eigen::MatrixXd kernelPart;
+  _matrixC->multiply(in.topRows(vertices), kernelPart);
+  out.resize(in.rows(), in.cols());
+  out.topRows(vertices) = kernelPart;
+  out.topRows(vertices).noalias() += _polynomialC * in.bottomRows(polyparams);
+  out.bottomRows(polyparams).noalias() = _polynomialC.transpose() * in.topRows(vertices);
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: solveC
+(
+  const DataPairs& dataPairs,
+  Eigen::MatrixXd& rhs )
+{
+  preciceTrace("solveC()");
+  int column = 0;
+  for (const std::pair<int,int>& dataPair : dataPairs) {
+    int valueDim = output()->data(dataPair.second)->getDimensions();
+    Eigen::MatrixXd& solutions = _previousSolutions[dataPair.second];
+    if ((solutions.rows() != rhs.rows()) || (solutions.cols() != valueDim)){
+      solutions = Eigen::MatrixXd::Zero(rhs.rows(), valueDim);
+    }
+    for (int dim=0; dim < valueDim; dim++){
+      Eigen::VectorXd x = solutions.col(dim);
+      gmres(rhs.col(column), x);
+      solutions.col(dim) = x;
+      rhs.col(column) = x;
+      column++;
+    }
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HierarchicalRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: gmres
+(
+  const Eigen::VectorXd& b,
+  Eigen::VectorXd&       x ) const
+{
+  preciceTrace1("gmres()", b.size());
+  int size = b.size();
+  double bNorm = b.norm();
+  if (bNorm == 0.0){
+    x.setZero();
+    return;
+  }
+  double threshold = _solverRtol * bNorm;
+  int restart = std::min(_restart, size);
+  Eigen::MatrixXd V(size, restart + 1);
+  Eigen::MatrixXd H(restart + 1, restart);
+  Eigen::VectorXd g(restart + 1);
+  Eigen::VectorXd cs(restart);
+  Eigen::VectorXd sn(restart);
+  Eigen::MatrixXd w;
+  int iterations = 0;
+  while (true){
+    multiplyC(x, w);
+    Eigen::VectorXd r = b - w.col(0);
+    double beta = r.norm();
+    if (beta <= threshold){
+      preciceDebug("GMRES converged in " << iterations << " iterations");
+      return;
+    }
+    preciceCheck(iterations < _maxIterations, "gmres()",
+                 "RBF linear system has not converged.");
+    V.col(0) = r / beta;
+    H.setZero();
+    g.setZero();
+    g(0) = beta;
+    int k = 0;
+    while ((k < restart) && (iterations < _maxIterations)){
+      multiplyC(V.col(k), w);
+      // Modified Gram-Schmidt orthogonalization
+      for (int i=0; i <= k; i++){
+        H(i,k) = w.col(0).dot(V.col(i));
+        w.col(0) -= H(i,k) * V.col(i);
+      }
+      H(k+1,k) = w.col(0).norm();
+      if (H(k+1,k) > 0.0){
+        V.col(k+1) = w.col(0) / H(k+1,k);
+      }
+      // Apply previous and compute new Givens rotation
+      for (int i=0; i < k; i++){
+        double temp = cs(i) * H(i,k) + sn(i) * H(i+1,k);
+        H(i+1,k) = - sn(i) * H(i,k) + cs(i) * H(i+1,k);
+        H(i,k) = temp;
+      }
+      double denominator = std::hypot(H(k,k), H(k+1,k));
+      cs(k) = H(k,k) / denominator;
+      sn(k) = H(k+1,k) / denominator;
+      H(k,k) = denominator;
+      H(k+1,k) = 0.0;
+      g(k+1) = - sn(k) * g(k);
+      g(k) = cs(k) * g(k);
+      k++;
+      iterations++;
+      if (std::abs(g(k)) <= threshold){
+        break;
+      }
+    }
+    Eigen::VectorXd y = H.topLeftCorner(k,k).template triangularView<Eigen::Upper>().solve(g.head(k));
+    x.noalias() += V.leftCols(k) * y;
+  }
+}
+
+}} // namespace precice, mapping
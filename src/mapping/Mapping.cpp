@@ -1,4 +1,6 @@
 #include "Mapping.hpp"
+#include <istream>
+#include <ostream>
 
 namespace precice {
 namespace mapping {
@@ -15,7 +17,8 @@ Mapping:: Mapping
   _outputRequirement(UNDEFINED),
   _input(),
   _output(),
-  _dimensions(dimensions)
+  _dimensions(dimensions),
+  _isOutdated(false)
 {}
 
 void Mapping:: setMeshes
@@ -74,6 +77,49 @@ void Mapping:: setOutputRequirement
   _outputRequirement = requirement;
 }
 
+void Mapping:: updateMapping()
+{
+  preciceTrace("updateMapping()");
+  clear();
+  computeMapping();
+}
+
+void Mapping:: setIsOutdated
+(
+  bool isOutdated )
+{
+  _isOutdated = isOutdated;
+}
+
+bool Mapping:: isOutdated() const
+{
+  return _isOutdated;
+}
+
+void Mapping:: map
+(
+  const DataPairs& dataPairs )
+{
+  preciceTrace1("map()", dataPairs.size());
+  for (const std::pair<int,int>& dataPair : dataPairs) {
+    map(dataPair.first, dataPair.second);
+  }
+}
+
+bool Mapping:: writeCache
+(
+  std::ostream& stream ) const
+{
+  return false;
+}
+
+bool Mapping:: readCache
+(
+  std::istream& stream )
+{
+  return false;
+}
+
 bool Mapping:: doesVertexContribute(
   int vertexID) const
 {
@@ -91,5 +137,150 @@ int Mapping:: getDimensions(){
   return _dimensions;
 }
 
+void Mapping:: applyOperator
+(
+  const Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator,
+  const DataPairs&                                    dataPairs )
+{
+  preciceTrace1("applyOperator()", dataPairs.size());
+  // Values are viewed as matrices with one row per vertex
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> ValuesMatrix;
+  size_t inSize = _input->vertices().size();
+  size_t outSize = _output->vertices().size();
+  if (_constraint == CONSISTENT) {
+    assertion(mappingOperator.rows() == (int)outSize, mappingOperator.rows(), outSize);
+    assertion(mappingOperator.cols() == (int)inSize, mappingOperator.cols(), inSize);
+  }
+  else {
+    assertion(_constraint == CONSERVATIVE, _constraint);
+    assertion(mappingOperator.rows() == (int)inSize, mappingOperator.rows(), inSize);
+    assertion(mappingOperator.cols() == (int)outSize, mappingOperator.cols(), outSize);
+  }
+
+  if (dataPairs.size() == 1) { // Work directly on the data values
+    const Eigen::VectorXd& inValues = _input->data(dataPairs[0].first)->values();
+    Eigen::VectorXd& outValues = _output->data(dataPairs[0].second)->values();
+    int valueDimensions = _input->data(dataPairs[0].first)->getDimensions();
+    assertion(inValues.size() == (int)inSize * valueDimensions, inValues.size(), inSize);
+    assertion(outValues.size() == (int)outSize * valueDimensions, outValues.size(), outSize);
+    Eigen::Map<const ValuesMatrix> in(inValues.data(), inSize, valueDimensions);
+    Eigen::Map<ValuesMatrix> out(outValues.data(), outSize, valueDimensions);
+    if (_constraint == CONSISTENT) {
+      out.noalias() += mappingOperator * in;
+    }
+    else {
+      out.noalias() += mappingOperator.transpose() * in;
+    }
+    return;
+  }
+
+  // Combine the values of all data column-wise
+  int columns = 0;
+  for (const std::pair<int,int>& dataPair : dataPairs) {
+    int valueDimensions = _input->data(dataPair.first)->getDimensions();
+    assertion(valueDimensions == _output->data(dataPair.second)->getDimensions(),
+              valueDimensions, _output->data(dataPair.second)->getDimensions());
+    columns += valueDimensions;
+  }
+  ValuesMatrix in(inSize, columns);
+  int column = 0;
+  for (const std::pair<int,int>& dataPair : dataPairs) {
+    const Eigen::VectorXd& inValues = _input->data(dataPair.first)->values();
+    int valueDimensions = _input->data(dataPair.first)->getDimensions();
+    assertion(inValues.size() == (int)inSize * valueDimensions, inValues.size(), inSize);
+    in.middleCols(column, valueDimensions) =
+        Eigen::Map<const ValuesMatrix>(inValues.data(), inSize, valueDimensions);
+    column += valueDimensions;
+  }
+  ValuesMatrix out;
+  if (_constraint == CONSISTENT) {
+    out = mappingOperator * in;
+  }
+  else {
+    out = mappingOperator.transpose() * in;
+  }
+  column = 0;
+  for (const std::pair<int,int>& dataPair : dataPairs) {
+    Eigen::VectorXd& outValues = _output->data(dataPair.second)->values();
+    int valueDimensions = _output->data(dataPair.second)->getDimensions();
+    assertion(outValues.size() == (int)outSize * valueDimensions, outValues.size(), outSize);
+    Eigen::Map<ValuesMatrix>(outValues.data(), outSize, valueDimensions) +=
+        out.middleCols(column, valueDimensions);
+    column += valueDimensions;
+  }
+}
+
+void Mapping:: writeOperator
+(
+  std::ostream&                                       stream,
+  const Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator )
+{
+  assertion(mappingOperator.isCompressed());
+  int sizes[3] = { (int)mappingOperator.rows(), (int)mappingOperator.cols(),
+                   (int)mappingOperator.nonZeros() };
+  stream.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+  stream.write(reinterpret_cast<const char*>(mappingOperator.outerIndexPtr()),
+               (sizes[0] + 1) * sizeof(int));
+  stream.write(reinterpret_cast<const char*>(mappingOperator.innerIndexPtr()),
+               sizes[2] * sizeof(int));
+  stream.write(reinterpret_cast<const char*>(mappingOperator.valuePtr()),
+               sizes[2] * sizeof(double));
+}
+
+bool Mapping:: readOperator
+(
+  std::istream&                                 stream,
+  Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator ) const
+{
+  int sizes[3] = { 0, 0, 0 };
+  stream.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+  int inputSize = _input->vertices().size();
+  int outputSize = _output->vertices().size();
+  bool isConsistent = _constraint == CONSISTENT;
+  if ((not stream) || (sizes[0] != (isConsistent ? outputSize : inputSize))
+      || (sizes[1] != (isConsistent ? inputSize : outputSize)) || (sizes[2] < 0)
+      || ((long)sizes[2] > (long)sizes[0] * sizes[1]))
+  {
+    return false;
+  }
+  // Reads the compressed storage directly, no entries are inserted
+  mappingOperator.resize(sizes[0], sizes[1]);
+  mappingOperator.resizeNonZeros(sizes[2]);
+  stream.read(reinterpret_cast<char*>(mappingOperator.outerIndexPtr()),
+              (sizes[0] + 1) * sizeof(int));
+  stream.read(reinterpret_cast<char*>(mappingOperator.innerIndexPtr()),
+              sizes[2] * sizeof(int));
+  stream.read(reinterpret_cast<char*>(mappingOperator.valuePtr()),
+              sizes[2] * sizeof(double));
+  if (not (stream && isValidOperator(mappingOperator))){
+    mappingOperator.resize(0, 0);
+    return false;
+  }
+  return true;
+}
+
+bool Mapping:: isValidOperator
+(
+  const Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator )
+{
+  const int* outer = mappingOperator.outerIndexPtr();
+  const int* inner = mappingOperator.innerIndexPtr();
+  int rows = mappingOperator.rows();
+  if ((outer[0] != 0) || (outer[rows] != mappingOperator.nonZeros())){
+    return false;
+  }
+  for (int row=0; row < rows; row++){
+    if (outer[row] > outer[row+1]){
+      return false;
+    }
+  }
+  for (int i=0; i < outer[rows]; i++){
+    if ((inner[i] < 0) || (inner[i] >= mappingOperator.cols())){
+      return false;
+    }
+  }
+  return true;
+}
+
 }} // namespace precice, mapping
 
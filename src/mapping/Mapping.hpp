@@ -9,6 +9,9 @@
 #include "utils/Dimensions.hpp"
 #include "utils/Helpers.hpp"
 #include "tarch/logging/Log.h"
+#include "Eigen/SparseCore"
+#include <iosfwd>
+#include <utility>
 #include <vector>
 
 namespace precice {
@@ -63,6 +66,11 @@ public:
     FULL = 2
   };
 
+  /**
+   * @brief Pairs of input and output data IDs, mapped together by map(const DataPairs&).
+   */
+  typedef std::vector<std::pair<int,int> > DataPairs;
+
   /**
    * @brief Constructor, takes mapping constraint.
    */
@@ -119,6 +127,24 @@ public:
    */
   virtual void clear() = 0;
 
+  /**
+   * @brief Updates a computed mapping after vertices of the meshes have moved.
+   *
+   * The default implementation clears and computes the mapping again. Mappings
+   * which can restrict the update to the moved vertices override this.
+   */
+  virtual void updateMapping();
+
+  /**
+   * @brief Sets whether the meshes may have changed since the mapping has been computed.
+   *
+   * Kept here, since all contexts referring to the mapping share this object.
+   */
+  void setIsOutdated ( bool isOutdated );
+
+  /// Returns true, if the meshes may have changed since the mapping has been computed.
+  bool isOutdated() const;
+
   /**
    * @brief Maps input data to output data from input mesh to output mesh.
    *
@@ -132,6 +158,31 @@ public:
     int inputDataID,
     int outputDataID ) =0;
 
+  /**
+   * @brief Maps several data fields from input mesh to output mesh at once.
+   *
+   * The output values are added to the current output values, which have to
+   * be zero. The default implementation calls map() for every pair of data IDs,
+   * mappings override this to traverse their mapping only once for all data.
+   */
+  virtual void map ( const DataPairs& dataPairs );
+
+  /**
+   * @brief Writes the computed mapping in binary form to stream.
+   *
+   * Used by MappingCache to store computed mappings on disk.
+   *
+   * @return False, if the mapping does not support caching (default).
+   */
+  virtual bool writeCache ( std::ostream& stream ) const;
+
+  /**
+   * @brief Restores a computed mapping written by writeCache().
+   *
+   * @return True, if successful. hasComputedMapping() returns true afterwards.
+   */
+  virtual bool readCache ( std::istream& stream );
+
   /**
    * @brief Returns true if the vertex actually contributes to the mapping.
    */
@@ -166,6 +217,34 @@ protected:
 
   int getDimensions();
 
+  /**
+   * @brief Adds operator times input values to the output values of all data pairs.
+   *
+   * The rows of the operator belong to the output vertices for consistent
+   * mappings, to the input vertices for conservative mappings, where the
+   * transposed operator is applied. The values of all data are combined
+   * into one matrix, such that the operator is traversed only once.
+   */
+  void applyOperator (
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator,
+    const DataPairs&                                    dataPairs );
+
+  /// Writes a sparse mapping operator in binary form to stream.
+  static void writeOperator (
+    std::ostream&                                       stream,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator );
+
+  /**
+   * @brief Reads a sparse mapping operator written by writeOperator().
+   *
+   * Returns false if the stream ends early, the stored indices are out of
+   * range or the operator does not fit to the meshes, as described for
+   * applyOperator().
+   */
+  bool readOperator (
+    std::istream&                                 stream,
+    Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator ) const;
+
 private:
 
   // @brief Logging device.
@@ -187,6 +266,13 @@ private:
   mesh::PtrMesh _output;
 
   int _dimensions;
+
+  // @brief True, if the meshes may have changed since the mapping has been computed.
+  bool _isOutdated;
+
+  /// Checks that the compressed storage of a read operator is consistent.
+  static bool isValidOperator (
+    const Eigen::SparseMatrix<double, Eigen::RowMajor>& mappingOperator );
 };
 
 }} // namespace precice, mapping
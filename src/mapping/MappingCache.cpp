@@ -0,0 +1,212 @@
+#include "MappingCache.hpp"
+#include "Mapping.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Vertex.hpp"
+#include "mesh/Edge.hpp"
+#include "mesh/Triangle.hpp"
+#include "mesh/Quad.hpp"
+#include "utils/MasterSlave.hpp"
+#include "utils/Globals.hpp"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace precice {
+namespace mapping {
+
+namespace {
+
+/// Identifies cache files, the version is increased on format changes.
+const char CACHE_MAGIC[8] = {'p','r','e','C','I','C','E','m'};
+const std::uint32_t CACHE_VERSION = 1;
+
+/// FNV-1a hash, accumulated over raw bytes.
+class Hash
+{
+public:
+
+  Hash() : _value(14695981039346656037ULL) {}
+
+  void add ( const void* data, size_t size )
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i=0; i < size; i++){
+      _value ^= bytes[i];
+      _value *= 1099511628211ULL;
+    }
+  }
+
+  template<typename T>
+  void add ( const T& value )
+  {
+    add(&value, sizeof(T));
+  }
+
+  void add ( const std::string& value )
+  {
+    add(value.size());
+    add(value.data(), value.size());
+  }
+
+  std::uint64_t value() const
+  {
+    return _value;
+  }
+
+private:
+
+  std::uint64_t _value;
+};
+
+void addMesh ( Hash& hash, const mesh::Mesh& mesh )
+{
+  hash.add(mesh.getName());
+  hash.add(mesh.getDimensions());
+  hash.add(mesh.vertices().size());
+  for (const mesh::Vertex& vertex : mesh.vertices()){
+    const utils::DynVector& coords = vertex.getCoords();
+    for (int dim=0; dim < coords.size(); dim++){
+      hash.add(coords[dim]);
+    }
+  }
+  hash.add(mesh.edges().size());
+  for (const mesh::Edge& edge : mesh.edges()){
+    hash.add(edge.vertex(0).getID());
+    hash.add(edge.vertex(1).getID());
+  }
+  hash.add(mesh.triangles().size());
+  for (const mesh::Triangle& triangle : mesh.triangles()){
+    for (int i=0; i < 3; i++){
+      hash.add(triangle.vertex(i).getID());
+    }
+  }
+  hash.add(mesh.quads().size());
+  for (const mesh::Quad& quad : mesh.quads()){
+    for (int i=0; i < 4; i++){
+      hash.add(quad.vertex(i).getID());
+    }
+  }
+}
+
+}
+
+tarch::logging::Log MappingCache:: _log ( "precice::mapping::MappingCache" );
+
+MappingCache:: MappingCache
+(
+  const std::string& directory,
+  const std::string& configuration )
+:
+  _directory(directory),
+  _configuration(configuration)
+{
+  assertion(not _directory.empty());
+}
+
+bool MappingCache:: load
+(
+  Mapping& mapping ) const
+{
+  preciceTrace1("load()", _configuration);
+  std::uint64_t expectedHash = computeHash(mapping);
+  std::string fileName = getFileName(expectedHash);
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (not file){
+    preciceDebug("No cache file " << fileName);
+    return false;
+  }
+  char magic[sizeof(CACHE_MAGIC)];
+  std::uint32_t version = 0;
+  std::uint64_t hash = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+  if ((not file) || (not std::equal(magic, magic + sizeof(magic), CACHE_MAGIC))
+      || (version != CACHE_VERSION) || (hash != expectedHash))
+  {
+    preciceWarning("load()", "Ignoring invalid mapping cache file " << fileName);
+    return false;
+  }
+  if (not mapping.readCache(file)){
+    preciceWarning("load()", "Failed to read mapping cache file " << fileName
+                   << ", the mapping is computed instead");
+    mapping.clear();
+    return false;
+  }
+  preciceInfo("load()", "Restored mapping from cache file " << fileName);
+  return true;
+}
+
+void MappingCache:: store
+(
+  const Mapping& mapping ) const
+{
+  preciceTrace1("store()", _configuration);
+  assertion(mapping.hasComputedMapping());
+  std::uint64_t hash = computeHash(mapping);
+  std::string fileName = getFileName(hash);
+  boost::system::error_code error;
+  boost::filesystem::create_directories(_directory, error);
+  // Write to a temporary file first, such that no partial cache files are read
+  std::ostringstream tmpFileName;
+  tmpFileName << fileName << ".tmp" << utils::MasterSlave::_rank;
+  std::ofstream file(tmpFileName.str().c_str(),
+                     std::ios::out | std::ios::binary | std::ios::trunc);
+  if (not file){
+    preciceWarning("store()", "Could not open mapping cache file " << tmpFileName.str());
+    return;
+  }
+  file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  file.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+  file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+  if (not mapping.writeCache(file)){
+    preciceDebug("Mapping does not support caching");
+    file.close();
+    std::remove(tmpFileName.str().c_str());
+    return;
+  }
+  file.close();
+  if (file.fail() || (std::rename(tmpFileName.str().c_str(), fileName.c_str()) != 0)){
+    preciceWarning("store()", "Could not write mapping cache file " << fileName);
+    std::remove(tmpFileName.str().c_str());
+    return;
+  }
+  preciceDebug("Stored mapping in cache file " << fileName);
+}
+
+std::string MappingCache:: getFileName
+(
+  const Mapping& mapping ) const
+{
+  return getFileName(computeHash(mapping));
+}
+
+std::string MappingCache:: getFileName
+(
+  std::uint64_t hash ) const
+{
+  std::ostringstream fileName;
+  fileName << _directory << "/mapping-" << std::hex << std::setw(16)
+           << std::setfill('0') << hash << ".cache";
+  return fileName.str();
+}
+
+std::uint64_t MappingCache:: computeHash
+(
+  const Mapping& mapping ) const
+{
+  assertion(mapping.getInputMesh().get() != nullptr);
+  assertion(mapping.getOutputMesh().get() != nullptr);
+  Hash hash;
+  hash.add(_configuration);
+  hash.add(utils::MasterSlave::_rank);
+  hash.add(utils::MasterSlave::_size);
+  addMesh(hash, *mapping.getInputMesh());
+  addMesh(hash, *mapping.getOutputMesh());
+  return hash.value();
+}
+
+}} // namespace precice, mapping
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "tarch/logging/Log.h"
+#include <cstdint>
+#include <string>
+
+namespace precice {
+namespace mapping {
+
+class Mapping;
+
+/**
+ * @brief Stores computed mappings on disk and restores them in later runs.
+ *
+ * A cache file is identified by a hash over the mapping configuration, the
+ * rank of the process, and the vertex coordinates and connectivity of the
+ * input and output mesh of the mapping. Hence, a cached mapping is only
+ * restored, if the meshes are exactly the same as when it was stored.
+ *
+ * Mappings which do not support caching (see Mapping::writeCache()) are
+ * computed as usual and not stored.
+ */
+class MappingCache
+{
+public:
+
+  /**
+   * @brief Constructor.
+   *
+   * @param directory [IN] Directory holding the cache files, created if missing.
+   * @param configuration [IN] Identifies the type and parameters of the mapping.
+   */
+  MappingCache (
+    const std::string& directory,
+    const std::string& configuration );
+
+  /**
+   * @brief Restores a computed mapping from a matching cache file.
+   *
+   * @return True, if a matching cache file has been found and read.
+   */
+  bool load ( Mapping& mapping ) const;
+
+  /**
+   * @brief Writes a computed mapping to a cache file.
+   *
+   * Failures to write the file are reported as warnings only.
+   */
+  void store ( const Mapping& mapping ) const;
+
+  /**
+   * @brief Returns the cache file name for the current meshes of the mapping.
+   */
+  std::string getFileName ( const Mapping& mapping ) const;
+
+private:
+
+  static tarch::logging::Log _log;
+
+  std::string _directory;
+
+  std::string _configuration;
+
+  std::uint64_t computeHash ( const Mapping& mapping ) const;
+
+  std::string getFileName ( std::uint64_t hash ) const;
+};
+
+}} // namespace precice, mapping
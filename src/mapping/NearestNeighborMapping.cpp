@@ -1,59 +1,219 @@
 #include "NearestNeighborMapping.hpp"
-#include "query/FindClosestVertex.hpp"
+#include "query/KDTree.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Vertex.hpp"
+#include "tarch/la/VectorOperations.h"
 #include "Eigen/Dense"
+#include <algorithm>
 
 namespace precice {
 namespace mapping {
 
+namespace {
+
+/// Copies the coordinates of all vertices of mesh to coords.
+void storeCoords (
+  const mesh::Mesh&    mesh,
+  std::vector<double>& coords )
+{
+  int dimensions = mesh.getDimensions();
+  coords.resize(mesh.vertices().size() * dimensions);
+  for (const mesh::Vertex& vertex : mesh.vertices()){
+    for (int dim=0; dim < dimensions; dim++){
+      coords[vertex.getID()*dimensions + dim] = vertex.getCoords()[dim];
+    }
+  }
+}
+
+/// Returns the IDs of all vertices moved farther than tolerance from coords.
+std::vector<int> findMovedVertices (
+  const mesh::Mesh&          mesh,
+  const std::vector<double>& coords,
+  double                     tolerance )
+{
+  int dimensions = mesh.getDimensions();
+  std::vector<int> moved;
+  for (const mesh::Vertex& vertex : mesh.vertices()){
+    double squaredDistance = 0.0;
+    for (int dim=0; dim < dimensions; dim++){
+      double difference = vertex.getCoords()[dim] - coords[vertex.getID()*dimensions + dim];
+      squaredDistance += difference * difference;
+    }
+    if (squaredDistance > tolerance * tolerance){
+      moved.push_back(vertex.getID());
+    }
+  }
+  return moved;
+}
+
+}
+
 tarch::logging::Log NearestNeighborMapping::
   _log ( "precice::mapping::NearestNeighborMapping" );
 
 NearestNeighborMapping:: NearestNeighborMapping
 (
   Constraint constraint,
-  int        dimensions)
+  int        dimensions,
+  double     updateTolerance )
 :
   Mapping(constraint, dimensions),
   _hasComputedMapping(false),
-  _vertexIndices()
+  _operator(),
+  _updateTolerance(updateTolerance),
+  _searchTree(),
+  _otherTree(),
+  _searchCoords(),
+  _otherCoords(),
+  _distances()
 {
   setInputRequirement(VERTEX);
   setOutputRequirement(VERTEX);
 }
 
+NearestNeighborMapping:: ~NearestNeighborMapping()
+{}
+
 void NearestNeighborMapping:: computeMapping()
 {
   preciceTrace1("computeMapping()", input()->vertices().size());
+  mesh::PtrMesh searchMesh; // Mesh searched for nearest neighbors
+  mesh::PtrMesh otherMesh;  // Mesh giving the rows of the operator
+  getMeshes(searchMesh, otherMesh);
+  size_t verticesSize = otherMesh->vertices().size();
+  // Index the searched mesh once ...
+  _searchTree.reset(new query::KDTree(searchMesh->vertices()));
+  storeCoords(*searchMesh, _searchCoords);
+  storeCoords(*otherMesh, _otherCoords);
+  _distances.resize(verticesSize);
+  _operator.resize(verticesSize, searchMesh->vertices().size());
+  _operator.reserve(Eigen::VectorXi::Constant(verticesSize, 1));
+  for ( size_t i=0; i < verticesSize; i++ ){
+    _operator.insert(i, 0) = 1.0;
+  }
+  _operator.makeCompressed();
+  for ( size_t i=0; i < verticesSize; i++ ){
+    searchNeighbor(*otherMesh, i); // ... and search every other vertex
+  }
+  _hasComputedMapping = true;
+}
+
+void NearestNeighborMapping:: updateMapping()
+{
+  preciceTrace("updateMapping()");
+  mesh::PtrMesh searchMesh;
+  mesh::PtrMesh otherMesh;
+  getMeshes(searchMesh, otherMesh);
+  int dimensions = searchMesh->getDimensions();
+  size_t searchSize = searchMesh->vertices().size();
+  size_t otherSize = otherMesh->vertices().size();
+  if ((not _hasComputedMapping) || (_searchCoords.size() != searchSize * dimensions)
+      || (_otherCoords.size() != otherSize * dimensions))
+  {
+    clear();
+    computeMapping();
+    return;
+  }
+
+  std::vector<bool> searchAgain(otherSize, false);
+  for (int id : findMovedVertices(*otherMesh, _otherCoords, _updateTolerance)){
+    searchAgain[id] = true;
+  }
+  std::vector<int> movedSearchVertices =
+      findMovedVertices(*searchMesh, _searchCoords, _updateTolerance);
+  if ((not movedSearchVertices.empty()) && (otherSize > 0)){
+    _searchTree->update();
+    std::vector<bool> isMoved(searchSize, false);
+    for (int id : movedSearchVertices){
+      isMoved[id] = true;
+    }
+    const int* neighbors = _operator.innerIndexPtr();
+    for (size_t i=0; i < otherSize; i++){
+      if (isMoved[neighbors[i]]){
+        searchAgain[i] = true;
+      }
+    }
+    // Other vertices can be closer to a moved vertex than to their neighbor,
+    // whose distance has grown by less than twice the tolerance.
+    double radius = *std::max_element(_distances.begin(), _distances.end())
+                    + 2.0 * _updateTolerance;
+    if (_otherTree.get() == nullptr){
+      _otherTree.reset(new query::KDTree(otherMesh->vertices()));
+    }
+    else {
+      _otherTree->update();
+    }
+    std::vector<mesh::Vertex*> candidates;
+    utils::DynVector difference(dimensions);
+    for (int id : movedSearchVertices){
+      const utils::DynVector& coords = searchMesh->vertices()[id].getCoords();
+      candidates.clear();
+      _otherTree->findVerticesInRadius(coords, radius, candidates);
+      for (mesh::Vertex* candidate : candidates){
+        int i = candidate->getID();
+        if (searchAgain[i]){
+          continue;
+        }
+        difference = candidate->getCoords();
+        difference -= searchMesh->vertices()[neighbors[i]].getCoords();
+        double neighborDistance = tarch::la::norm2(difference);
+        difference = candidate->getCoords();
+        difference -= coords;
+        if (tarch::la::norm2(difference) <= neighborDistance){
+          searchAgain[i] = true;
+        }
+      }
+      for (int dim=0; dim < dimensions; dim++){
+        _searchCoords[id*dimensions + dim] = coords[dim];
+      }
+    }
+  }
+
+  int count = 0;
+  for (size_t i=0; i < otherSize; i++){
+    if (searchAgain[i]){
+      searchNeighbor(*otherMesh, i);
+      const utils::DynVector& coords = otherMesh->vertices()[i].getCoords();
+      for (int dim=0; dim < dimensions; dim++){
+        _otherCoords[i*dimensions + dim] = coords[dim];
+      }
+      count++;
+    }
+  }
+  preciceDebug("Searched neighbors again for " << count << " of " << otherSize << " vertices");
+}
+
+void NearestNeighborMapping:: getMeshes
+(
+  mesh::PtrMesh& searchMesh,
+  mesh::PtrMesh& otherMesh )
+{
+  preciceTrace("getMeshes()");
   assertion(input().get() != nullptr);
   assertion(output().get() != nullptr);
   if (getConstraint() == CONSISTENT){
     preciceDebug("Compute consistent mapping");
-    size_t verticesSize = output()->vertices().size();
-    _vertexIndices.resize(verticesSize);
-    const mesh::Mesh::VertexContainer& outputVertices = output()->vertices();
-    for ( size_t i=0; i < verticesSize; i++ ){
-      const utils::DynVector& coords = outputVertices[i].getCoords();
-      query::FindClosestVertex find(coords); // Search for the output vertex ...
-      find(*input()); // ... inside the input mesh
-      assertion(find.hasFound());
-      _vertexIndices[i] = find.getClosestVertex().getID();
-    }
+    searchMesh = input();
+    otherMesh = output();
   }
   else {
     assertion(getConstraint() == CONSERVATIVE, getConstraint());
     preciceDebug("Compute conservative mapping");
-    size_t verticesSize = input()->vertices().size();
-    _vertexIndices.resize(verticesSize);
-    const mesh::Mesh::VertexContainer& inputVertices = input()->vertices();
-    for ( size_t i=0; i < verticesSize; i++ ){
-      const utils::DynVector& coords = inputVertices[i].getCoords();
-      query::FindClosestVertex find(coords); // Search for the input vertex ...
-      find(*output()); // ... inside the output mesh
-      assertion(find.hasFound());
-      _vertexIndices[i] = find.getClosestVertex().getID();
-    }
+    searchMesh = output();
+    otherMesh = input();
   }
-  _hasComputedMapping = true;
+}
+
+void NearestNeighborMapping:: searchNeighbor
+(
+  const mesh::Mesh& otherMesh,
+  int               i )
+{
+  const utils::DynVector& coords = otherMesh.vertices()[i].getCoords();
+  mesh::Vertex* closest = _searchTree->findClosestVertex(coords, &_distances[i]);
+  assertion(closest != nullptr);
+  // Every row holds exactly one entry, which is replaced
+  _operator.innerIndexPtr()[_operator.outerIndexPtr()[i]] = closest->getID();
 }
 
 bool NearestNeighborMapping:: hasComputedMapping() const
@@ -65,7 +225,12 @@ bool NearestNeighborMapping:: hasComputedMapping() const
 void NearestNeighborMapping:: clear()
 {
   preciceTrace("clear()");
-  _vertexIndices.clear();
+  _operator.resize(0, 0);
+  _searchTree.reset();
+  _otherTree.reset();
+  _searchCoords.clear();
+  _otherCoords.clear();
+  _distances.clear();
   _hasComputedMapping = false;
 }
 
@@ -75,9 +240,10 @@ void NearestNeighborMapping:: map
   int outputDataID )
 {
   preciceTrace2 ( "map()", inputDataID, outputDataID );
-  const Eigen::VectorXd& inputValues = input()->data(inputDataID)->values();
   Eigen::VectorXd& outputValues = output()->data(outputDataID)->values();
   //assign(outputValues) = 0.0;
+# ifndef NDEBUG
+  const Eigen::VectorXd& inputValues = input()->data(inputDataID)->values();
   int valueDimensions = input()->data(inputDataID)->getDimensions();
   assertion ( valueDimensions == output()->data(outputDataID)->getDimensions(),
               valueDimensions, output()->data(outputDataID)->getDimensions() );
@@ -85,33 +251,47 @@ void NearestNeighborMapping:: map
                inputValues.size(), valueDimensions, input()->vertices().size() );
   assertion ( outputValues.size() / valueDimensions == (int)output()->vertices().size(),
                outputValues.size(), valueDimensions, output()->vertices().size() );
+# endif
   if (getConstraint() == CONSISTENT){
     preciceDebug("Map consistent");
-    size_t outSize = output()->vertices().size();
-    for ( size_t i=0; i < outSize; i++ ){
-      int inputIndex = _vertexIndices[i] * valueDimensions;
-      for ( int dim=0; dim < valueDimensions; dim++ ){
-        outputValues((i*valueDimensions)+dim) = inputValues(inputIndex+dim);
-      }
-    }
-  }
-  else {
-    assertion(getConstraint() == CONSERVATIVE, getConstraint());
-    preciceDebug("Map conservative");
-    size_t inSize = input()->vertices().size();
-    for ( size_t i=0; i < inSize; i++ ){
-      int outputIndex = _vertexIndices[i] * valueDimensions;
-      for ( int dim=0; dim < valueDimensions; dim++ ){
-        outputValues(outputIndex+dim) += inputValues((i*valueDimensions)+dim);
-      }
-    }
+    outputValues.setZero(); // Every output value is assigned exactly one input value
   }
+  map(DataPairs(1, std::make_pair(inputDataID, outputDataID)));
+}
+
+void NearestNeighborMapping:: map
+(
+  const DataPairs& dataPairs )
+{
+  preciceTrace1 ( "map()", dataPairs.size() );
+  assertion ( _hasComputedMapping );
+  applyOperator(_operator, dataPairs);
+}
+
+bool NearestNeighborMapping:: writeCache
+(
+  std::ostream& stream ) const
+{
+  assertion ( _hasComputedMapping );
+  writeOperator(stream, _operator);
+  return true;
+}
+
+bool NearestNeighborMapping:: readCache
+(
+  std::istream& stream )
+{
+  preciceTrace ( "readCache()" );
+  _hasComputedMapping = readOperator(stream, _operator);
+  return _hasComputedMapping;
 }
 
 bool NearestNeighborMapping::doesVertexContribute(
   int vertexID) const
 {
-  return utils::contained(vertexID,_vertexIndices);
+  const int* columns = _operator.innerIndexPtr();
+  return std::find(columns, columns + _operator.nonZeros(), vertexID)
+         != columns + _operator.nonZeros();
 }
 
 bool NearestNeighborMapping:: isProjectionMapping() const
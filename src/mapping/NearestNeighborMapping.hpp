@@ -2,13 +2,29 @@
 
 #include "mapping/Mapping.hpp"
 #include "tarch/logging/Log.h"
+#include "Eigen/SparseCore"
+#include <memory>
 #include <vector>
 
+namespace precice {
+  namespace query {
+    class KDTree;
+  }
+}
+
 namespace precice {
 namespace mapping {
 
 /**
  * @brief Mapping using nearest neighboring vertices.
+ *
+ * computeMapping() compiles the found neighbors into a sparse operator with
+ * one unit entry per row, such that map() is a sparse matrix product for all
+ * data dimensions at once.
+ *
+ * The spatial indices of both meshes are kept and updated in place, such that
+ * updateMapping() searches only for vertices affected by moved vertices and
+ * patches the operator in place.
  */
 class NearestNeighborMapping : public Mapping
 {
@@ -18,11 +34,15 @@ public:
    * @brief Constructor.
    *
    * @param[in] constraint Specifies mapping to be consistent or conservative.
+   * @param[in] updateTolerance Vertices moving less than this distance keep
+   *            their neighbor in updateMapping().
    */
-  NearestNeighborMapping ( Constraint constraint, int dimensions );
+  NearestNeighborMapping (
+    Constraint constraint,
+    int        dimensions,
+    double     updateTolerance = 0.0 );
 
-  /// Destructor, empty.
-  virtual ~NearestNeighborMapping() {}
+  virtual ~NearestNeighborMapping();
 
   /// Computes the mapping coefficients from the in- and output mesh.
   virtual void computeMapping();
@@ -33,11 +53,23 @@ public:
   /// Removes a computed mapping.
   virtual void clear();
 
+  /// Searches new neighbors for vertices affected by moved vertices only.
+  virtual void updateMapping();
+
   /// Maps input data to output data from input mesh to output mesh.
   virtual void map (
     int inputDataID,
     int outputDataID );
 
+  /// Maps all given data in one sparse product.
+  virtual void map ( const DataPairs& dataPairs );
+
+  /// Writes the computed operator to stream.
+  virtual bool writeCache ( std::ostream& stream ) const;
+
+  /// Restores an operator written by writeCache().
+  virtual bool readCache ( std::istream& stream );
+
   virtual bool doesVertexContribute(int vertexID) const;
   virtual bool isProjectionMapping() const;
 
@@ -49,8 +81,37 @@ private:
   // @brief Flag to indicate whether computeMapping() has been called.
   bool _hasComputedMapping;
 
-  // @brief Computed output vertex indices to map data from input vertices to.
-  std::vector<int> _vertexIndices;
+  // @brief Computed mapping operator, maps input to output vertices if consistent.
+  //
+  // For conservative mappings, the rows belong to the input vertices and the
+  // transposed operator is applied.
+  Eigen::SparseMatrix<double, Eigen::RowMajor> _operator;
+
+  // @brief Vertices moving less than this distance are not searched again.
+  double _updateTolerance;
+
+  // @brief Index of the searched mesh, kept for updateMapping().
+  std::unique_ptr<query::KDTree> _searchTree;
+
+  // @brief Index of the other mesh, built when search vertices move first.
+  std::unique_ptr<query::KDTree> _otherTree;
+
+  // @brief Coordinates of the searched and other vertices at their last search.
+  std::vector<double> _searchCoords;
+  std::vector<double> _otherCoords;
+
+  // @brief Distance of every other vertex to its neighbor at the last search.
+  std::vector<double> _distances;
+
+  // @brief Searched mesh and mesh giving the rows of the operator.
+  void getMeshes (
+    mesh::PtrMesh& searchMesh,
+    mesh::PtrMesh& otherMesh );
+
+  // @brief Searches the neighbor of other vertex i and sets it in the operator.
+  void searchNeighbor (
+    const mesh::Mesh& otherMesh,
+    int               i );
 };
 
 }} // namespace precice, mapping
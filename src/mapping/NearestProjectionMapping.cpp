@@ -1,5 +1,6 @@
 #include "NearestProjectionMapping.hpp"
 #include "query/FindClosest.hpp"
+#include "query/AABBTree.hpp"
 #include "Eigen/Dense"
 
 namespace precice {
@@ -14,7 +15,7 @@ NearestProjectionMapping:: NearestProjectionMapping
   int        dimensions)
 :
   Mapping(constraint, dimensions),
-  _weights(),
+  _operator(),
   _hasComputedMapping(false)
 {
   if (constraint == CONSISTENT){
@@ -32,35 +33,35 @@ void NearestProjectionMapping:: computeMapping()
 {
   preciceTrace2("computeMapping()", input()->vertices().size(),
                 output()->vertices().size());
+  mesh::PtrMesh searchMesh; // Mesh searched for projections
+  mesh::PtrMesh otherMesh;  // Mesh giving the rows of the operator
   if (getConstraint() == CONSISTENT){
     preciceDebug("Compute consistent mapping");
-    _weights.resize(output()->vertices().size());
-    for ( size_t i=0; i < output()->vertices().size(); i++ ){
-      query::FindClosest findClosest(output()->vertices()[i].getCoords());
-      findClosest(*input()); // Search inside the input mesh for the output vertex
-      assertion(findClosest.hasFound());
-      const query::ClosestElement& closest = findClosest.getClosest();
-      _weights[i].clear();
-      for (const query::InterpolationElement& elem : closest.interpolationElements) {
-        _weights[i].push_back(elem);
-      }
-    }
+    searchMesh = input();
+    otherMesh = output();
   }
   else {
     assertion(getConstraint() == CONSERVATIVE, getConstraint());
     preciceDebug("Compute conservative mapping");
-    _weights.resize(input()->vertices().size());
-    for ( size_t i=0; i < input()->vertices().size(); i++ ){
-      query::FindClosest findClosest(input()->vertices()[i].getCoords());
-      findClosest(*output());
-      assertion(findClosest.hasFound());
-      const query::ClosestElement& closest = findClosest.getClosest();
-      _weights[i].clear();
-      for (const query::InterpolationElement& elem : closest.interpolationElements) {
-        _weights[i].push_back(elem);
-      }
+    searchMesh = output();
+    otherMesh = input();
+  }
+  typedef Eigen::Triplet<double> Triplet;
+  std::vector<Triplet> weights;
+  query::AABBTree tree(*searchMesh);
+  for ( size_t i=0; i < otherMesh->vertices().size(); i++ ){
+    query::FindClosest findClosest(otherMesh->vertices()[i].getCoords());
+    tree.searchDistance(findClosest); // Search inside the searched mesh for the other vertex
+    assertion(findClosest.hasFound());
+    const query::ClosestElement& closest = findClosest.getClosest();
+    for (const query::InterpolationElement& elem : closest.interpolationElements) {
+      weights.push_back(Triplet(i, elem.element->getID(), elem.weight));
     }
   }
+  // Zero weights are kept as explicit entries, see doesVertexContribute()
+  _operator.resize(otherMesh->vertices().size(), searchMesh->vertices().size());
+  _operator.setFromTriplets(weights.begin(), weights.end());
+  _operator.makeCompressed();
   _hasComputedMapping = true;
 }
 
@@ -72,7 +73,7 @@ bool NearestProjectionMapping:: hasComputedMapping() const
 void NearestProjectionMapping:: clear()
 {
   preciceTrace("clear()");
-  _weights.clear();
+  _operator.resize(0, 0);
   _hasComputedMapping = false;
 }
 
@@ -82,73 +83,49 @@ void NearestProjectionMapping:: map
   int outputDataID )
 {
   preciceTrace2("map()", inputDataID, outputDataID);
-  mesh::PtrData inData = input()->data(inputDataID);
-  mesh::PtrData outData = output()->data(outputDataID);
-  const Eigen::VectorXd& inValues = inData->values();
-  Eigen::VectorXd& outValues = outData->values();
-  //assign(outValues) = 0.0;
-  int dimensions = inData->getDimensions();
-  assertion(dimensions == outData->getDimensions());
+  assertion(input()->data(inputDataID)->getDimensions()
+            == output()->data(outputDataID)->getDimensions());
+  map(DataPairs(1, std::make_pair(inputDataID, outputDataID)));
+}
 
-  if (getConstraint() == CONSISTENT){
-    preciceDebug("Map consistent");
-    assertion(_weights.size() == output()->vertices().size(),
-               _weights.size(), output()->vertices().size());
-    for (size_t i=0; i < output()->vertices().size(); i++){
-      InterpolationElements& elems = _weights[i];
-      size_t outOffset = i * dimensions;
-      for (query::InterpolationElement& elem : elems) {
-        size_t inOffset = (size_t)elem.element->getID() * dimensions;
-        for (int dim=0; dim < dimensions; dim++){
-          assertion(outOffset + dim < (size_t)outValues.size());
-          assertion(inOffset + dim < (size_t)inValues.size());
-          outValues(outOffset + dim) += elem.weight * inValues(inOffset + dim);
-        }
-      }
-    }
-  }
-  else {
-    assertion(getConstraint() == CONSERVATIVE, getConstraint());
-    preciceDebug("Map conservative");
-    assertion(_weights.size() == input()->vertices().size(),
-               _weights.size(), input()->vertices().size());
-    for (size_t i=0; i < input()->vertices().size(); i++){
-      size_t inOffset = i * dimensions;
-      InterpolationElements& elems = _weights[i];
-      for (query::InterpolationElement& elem : elems) {
-        size_t outOffset = (size_t)elem.element->getID() * dimensions;
-        for ( int dim=0; dim < dimensions; dim++ ){
-          assertion(outOffset + dim < (size_t)outValues.size());
-          assertion(inOffset + dim < (size_t)inValues.size());
-          outValues(outOffset + dim) += elem.weight * inValues(inOffset + dim);
-        }
-      }
-    }
-  }
+void NearestProjectionMapping:: map
+(
+  const DataPairs& dataPairs )
+{
+  preciceTrace1("map()", dataPairs.size());
+  assertion(_hasComputedMapping);
+  applyOperator(_operator, dataPairs);
+}
+
+bool NearestProjectionMapping:: writeCache
+(
+  std::ostream& stream ) const
+{
+  assertion(_hasComputedMapping);
+  writeOperator(stream, _operator);
+  return true;
+}
+
+bool NearestProjectionMapping:: readCache
+(
+  std::istream& stream )
+{
+  preciceTrace("readCache()");
+  _hasComputedMapping = readOperator(stream, _operator);
+  return _hasComputedMapping;
 }
 
 bool NearestProjectionMapping::doesVertexContribute(
   int vertexID) const
 {
   preciceTrace1("doesVertexContribute()", vertexID);
-  if (getConstraint() == CONSISTENT) {
-    for (size_t i=0; i < output()->vertices().size(); i++) {
-      const InterpolationElements& elems = _weights[i];
-      for (const query::InterpolationElement& elem : elems) {
-        if (elem.element->getID()==vertexID && elem.weight!=0.0) {
-          return true;
-        }
-      }
-    }
-  }
-  else {
-    assertion(getConstraint() == CONSERVATIVE, getConstraint());
-    for (size_t i=0; i < input()->vertices().size(); i++) {
-      const InterpolationElements& elems = _weights[i];
-      for (const query::InterpolationElement& elem : elems) {
-        if (elem.element->getID()==vertexID){ // && elem.weight!=0.0){
-          return true;
-        }
+  const int* columns = _operator.innerIndexPtr();
+  const double* weights = _operator.valuePtr();
+  for (int i=0; i < _operator.nonZeros(); i++) {
+    if (columns[i] == vertexID) {
+      // Zero weights count for conservative mappings only
+      if ((getConstraint() == CONSERVATIVE) || (weights[i] != 0.0)) {
+        return true;
       }
     }
   }
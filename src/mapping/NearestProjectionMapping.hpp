@@ -1,8 +1,7 @@
 #pragma once
 
 #include "Mapping.hpp"
-#include <list>
-#include <vector>
+#include "Eigen/SparseCore"
 
 namespace precice {
 namespace mapping {
@@ -10,6 +9,10 @@ namespace mapping {
 /**
  * @brief Mapping using orthogonal projection to nearest triangle/edge/vertex and
  *        linear interpolation from projected point.
+ *
+ * The interpolation weights are compiled into a sparse operator by
+ * computeMapping(), map() is then a sparse matrix product for all data
+ * dimensions at once.
  */
 class NearestProjectionMapping : public Mapping
 {
@@ -50,6 +53,21 @@ public:
     int inputDataID,
     int outputDataID );
 
+  /**
+   * @brief Maps all given data in one sparse product.
+   */
+  virtual void map ( const DataPairs& dataPairs );
+
+  /**
+   * @brief Writes the computed interpolation weights to stream.
+   */
+  virtual bool writeCache ( std::ostream& stream ) const;
+
+  /**
+   * @brief Restores interpolation weights written by writeCache().
+   */
+  virtual bool readCache ( std::istream& stream );
+
   virtual bool doesVertexContribute(int vertexID) const;
   virtual bool isProjectionMapping() const;
 
@@ -57,8 +75,11 @@ private:
 
   static tarch::logging::Log _log;
 
-  typedef std::list<query::InterpolationElement> InterpolationElements;
-  std::vector<InterpolationElements> _weights;
+  // @brief Interpolation weights, maps input to output vertices if consistent.
+  //
+  // For conservative mappings, the rows belong to the input vertices and the
+  // transposed operator is applied.
+  Eigen::SparseMatrix<double, Eigen::RowMajor> _operator;
 
   bool _hasComputedMapping;
 };
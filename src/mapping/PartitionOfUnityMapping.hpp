@@ -0,0 +1,479 @@
+#pragma once
+
+#include "Mapping.hpp"
+#include "impl/BasisFunctions.hpp"
+#include "query/KDTree.hpp"
+#include "utils/Globals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "Eigen/Core"
+#include "Eigen/QR"
+#include "Eigen/SparseCore"
+
+namespace precice {
+namespace mapping {
+
+/**
+ * @brief Localized radial basis function mapping, using a partition of unity.
+ *
+ * The input mesh is split into overlapping spherical patches by recursive
+ * bisection. For every patch, a small RBF interpolation system (with a linear
+ * polynomial) is built from the input vertices within the patch, and evaluated
+ * at the output vertices within the patch. The patch interpolants are blended
+ * with weights w_p(x) = phi(|x - c_p| / r_p) / sum_q phi(|x - c_q| / r_q), where
+ * phi is the compactly supported Wendland C2 function.
+ *
+ * In contrast to RadialBasisFctMapping, memory and computation costs scale
+ * linearly with the number of vertices for a fixed number of vertices per patch.
+ * Since the patch systems are independent, they are solved in parallel by a
+ * configurable number of threads, if preCICE is built with OpenMP.
+ *
+ * The blended interpolants are compiled into one sparse operator, which is
+ * applied in map(). Output vertices not covered by any patch are extrapolated
+ * by the patch with the closest center.
+ */
+template<typename RADIAL_BASIS_FUNCTION_T>
+class PartitionOfUnityMapping : public Mapping
+{
+public:
+
+  /**
+   * @brief Constructor.
+   *
+   * @param constraint [IN] Specifies mapping to be consistent or conservative.
+   * @param function [IN] Radial basis function used in every patch.
+   * @param verticesPerPatch [IN] Maximal number of input vertices a patch is
+   *        created from, the overlap adds further vertices.
+   * @param relativeOverlap [IN] Enlargement of patch radii relative to the radius
+   *        needed to cover the vertices a patch is created from.
+   * @param threads [IN] Number of threads used to compute the patches.
+   */
+  PartitionOfUnityMapping (
+    Constraint              constraint,
+    int                     dimensions,
+    RADIAL_BASIS_FUNCTION_T function,
+    int                     verticesPerPatch = 50,
+    double                  relativeOverlap = 0.3,
+    int                     threads = 1 );
+
+  virtual ~PartitionOfUnityMapping() {}
+
+  /// Creates the patches and computes the blended mapping operator.
+  virtual void computeMapping() override;
+
+  /// Returns true, if computeMapping() has been called.
+  virtual bool hasComputedMapping() const override;
+
+  /// Removes a computed mapping.
+  virtual void clear() override;
+
+  /// Maps input data to output data from input mesh to output mesh.
+  virtual void map (
+    int inputDataID,
+    int outputDataID ) override;
+
+  /// Maps all given data in one sparse product.
+  virtual void map ( const DataPairs& dataPairs ) override;
+
+  /// Writes the computed operator to stream.
+  virtual bool writeCache ( std::ostream& stream ) const override;
+
+  /// Restores an operator written by writeCache().
+  virtual bool readCache ( std::istream& stream ) override;
+
+private:
+
+  static tarch::logging::Log _log;
+
+  /// Spherical patch, covering a part of the input mesh.
+  struct Patch
+  {
+    Patch ( const utils::DynVector& center, double radius )
+      : center(center), radius(radius), outVertices(), weights() {}
+
+    utils::DynVector center;
+    double radius;
+    /// Output vertices (IDs) within the patch and their blending weights.
+    std::vector<int> outVertices;
+    std::vector<double> weights;
+  };
+
+  bool _hasComputedMapping;
+
+  RADIAL_BASIS_FUNCTION_T _basisFunction;
+
+  int _verticesPerPatch;
+
+  double _relativeOverlap;
+
+  /// Number of threads used to compute the patches, effective with OpenMP only.
+  int _threads;
+
+  /// Blended mapping operator, maps input to output vertices if consistent.
+  ///
+  /// For conservative mappings, the rows belong to the input vertices and the
+  /// transposed operator is applied.
+  Eigen::SparseMatrix<double, Eigen::RowMajor> _operator;
+
+  /// Splits the vertices at positions [begin, end) of indices into patches.
+  void createPatches (
+    const mesh::Mesh&   inMesh,
+    std::vector<int>&   indices,
+    int                 begin,
+    int                 end,
+    std::vector<Patch>& patches ) const;
+
+  /// Assigns the output vertices with blending weights to the patches.
+  void assignOutputVertices (
+    const mesh::Mesh&   outMesh,
+    std::vector<Patch>& patches ) const;
+
+  /// Computes the local RBF interpolant of a patch and adds it to triplets.
+  void computePatch (
+    const mesh::Mesh&                     inMesh,
+    const mesh::Mesh&                     outMesh,
+    const query::KDTree&                  inTree,
+    const Patch&                          patch,
+    std::vector<Eigen::Triplet<double> >& triplets ) const;
+
+  /// Wendland C2 function, used to construct the blending weights.
+  static double evaluateWeight ( double relativeDistance );
+};
+
+// --------------------------------------------------- HEADER IMPLEMENTATIONS
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+tarch::logging::Log PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>::
+_log ( "precice::mapping::PartitionOfUnityMapping" );
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: PartitionOfUnityMapping
+(
+  Constraint              constraint,
+  int                     dimensions,
+  RADIAL_BASIS_FUNCTION_T function,
+  int                     verticesPerPatch,
+  double                  relativeOverlap,
+  int                     threads )
+:
+  Mapping ( constraint, dimensions ),
+  _hasComputedMapping ( false ),
+  _basisFunction ( function ),
+  _verticesPerPatch ( verticesPerPatch ),
+  _relativeOverlap ( relativeOverlap ),
+  _threads ( threads ),
+  _operator()
+{
+  setInputRequirement(VERTEX);
+  setOutputRequirement(VERTEX);
+  preciceCheck(verticesPerPatch > 2 * (dimensions + 1), "PartitionOfUnityMapping()",
+               "Number of vertices per patch has to be larger than "
+               << 2 * (dimensions + 1) << "!");
+  preciceCheck(relativeOverlap > 0.0, "PartitionOfUnityMapping()",
+               "Relative overlap of patches has to be larger than zero!");
+  preciceCheck(threads > 0, "PartitionOfUnityMapping()",
+               "Number of threads for partition of unity mapping has to be larger than zero!");
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
+{
+  preciceTrace2("computeMapping()", input()->vertices().size(), output()->vertices().size());
+  assertion(input()->getDimensions() == output()->getDimensions(),
+            input()->getDimensions(), output()->getDimensions());
+  mesh::PtrMesh inMesh;
+  mesh::PtrMesh outMesh;
+  if (getConstraint() == CONSERVATIVE){
+    inMesh = output();
+    outMesh = input();
+  }
+  else {
+    inMesh = input();
+    outMesh = output();
+  }
+  int inputSize = (int)inMesh->vertices().size();
+  int outputSize = (int)outMesh->vertices().size();
+  preciceCheck(inputSize > getDimensions() + 1, "computeMapping()",
+               "Mesh \"" << inMesh->getName() << "\" has too few vertices for a "
+               << "partition of unity mapping!");
+
+  std::vector<int> indices(inputSize);
+  for (int i=0; i < inputSize; i++){
+    indices[i] = i;
+  }
+  std::vector<Patch> patches;
+  createPatches(*inMesh, indices, 0, inputSize, patches);
+  assignOutputVertices(*outMesh, patches);
+  preciceDebug("Created " << patches.size() << " patches");
+
+  query::KDTree inTree(inMesh->vertices());
+  std::vector<Eigen::Triplet<double> > triplets;
+# ifdef _OPENMP
+# pragma omp parallel num_threads(_threads)
+# endif
+  {
+    std::vector<Eigen::Triplet<double> > localTriplets;
+#   ifdef _OPENMP
+#   pragma omp for schedule(dynamic)
+#   endif
+    for (int p=0; p < (int)patches.size(); p++){
+      computePatch(*inMesh, *outMesh, inTree, patches[p], localTriplets);
+    }
+#   ifdef _OPENMP
+#   pragma omp critical
+#   endif
+    triplets.insert(triplets.end(), localTriplets.begin(), localTriplets.end());
+  }
+  _operator.resize(outputSize, inputSize);
+  _operator.setFromTriplets(triplets.begin(), triplets.end());
+  _operator.makeCompressed();
+  preciceDebug("Operator nonzeros = " << _operator.nonZeros());
+  _hasComputedMapping = true;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: hasComputedMapping() const
+{
+  return _hasComputedMapping;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: clear()
+{
+  preciceTrace("clear()");
+  _operator.resize(0, 0);
+  _hasComputedMapping = false;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: map
+(
+  int inputDataID,
+  int outputDataID )
+{
+  preciceTrace2("map()", inputDataID, outputDataID);
+  assertion(input()->data(inputDataID)->getDimensions()
+            == output()->data(outputDataID)->getDimensions());
+  output()->data(outputDataID)->values().setZero();
+  map(DataPairs(1, std::make_pair(inputDataID, outputDataID)));
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: map
+(
+  const DataPairs& dataPairs )
+{
+  preciceTrace1("map()", dataPairs.size());
+  assertion(_hasComputedMapping);
+  applyOperator(_operator, dataPairs);
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: writeCache
+(
+  std::ostream& stream ) const
+{
+  assertion(_hasComputedMapping);
+  writeOperator(stream, _operator);
+  return true;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: readCache
+(
+  std::istream& stream )
+{
+  preciceTrace("readCache()");
+  _hasComputedMapping = readOperator(stream, _operator);
+  return _hasComputedMapping;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: createPatches
+(
+  const mesh::Mesh&   inMesh,
+  std::vector<int>&   indices,
+  int                 begin,
+  int                 end,
+  std::vector<Patch>& patches ) const
+{
+  int dimensions = inMesh.getDimensions();
+  const mesh::Mesh::VertexContainer& vertices = inMesh.vertices();
+  if (end - begin <= _verticesPerPatch){
+    utils::DynVector center(dimensions, 0.0);
+    for (int i=begin; i < end; i++){
+      center += vertices[indices[i]].getCoords();
+    }
+    center /= (double)(end - begin);
+    double radius = 0.0;
+    for (int i=begin; i < end; i++){
+      utils::DynVector difference(center);
+      difference -= vertices[indices[i]].getCoords();
+      radius = std::max(radius, tarch::la::norm2(difference));
+    }
+    radius = std::max(radius, tarch::la::NUMERICAL_ZERO_DIFFERENCE);
+    patches.push_back(Patch(center, (1.0 + _relativeOverlap) * radius));
+    return;
+  }
+  // Bisect at the median along the axis of largest extent
+  int splitDimension = 0;
+  double maxExtent = -1.0;
+  for (int dim=0; dim < dimensions; dim++){
+    double lower = std::numeric_limits<double>::max();
+    double upper = - std::numeric_limits<double>::max();
+    for (int i=begin; i < end; i++){
+      double value = vertices[indices[i]].getCoords()[dim];
+      lower = std::min(lower, value);
+      upper = std::max(upper, value);
+    }
+    if (upper - lower > maxExtent){
+      maxExtent = upper - lower;
+      splitDimension = dim;
+    }
+  }
+  int middle = begin + (end - begin) / 2;
+  std::nth_element(indices.begin() + begin, indices.begin() + middle, indices.begin() + end,
+                   [&vertices, splitDimension] (int a, int b) {
+                     return vertices[a].getCoords()[splitDimension]
+                            < vertices[b].getCoords()[splitDimension]; });
+  createPatches(inMesh, indices, begin, middle, patches);
+  createPatches(inMesh, indices, middle, end, patches);
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: assignOutputVertices
+(
+  const mesh::Mesh&   outMesh,
+  std::vector<Patch>& patches ) const
+{
+  preciceTrace1("assignOutputVertices()", patches.size());
+  int outputSize = (int)outMesh.vertices().size();
+  std::vector<double> weightSums(outputSize, 0.0);
+  query::KDTree outTree(outMesh.vertices());
+  std::vector<mesh::Vertex*> found;
+  for (Patch& patch : patches){
+    found.clear();
+    outTree.findVerticesInRadius(patch.center, patch.radius, found);
+    for (mesh::Vertex* vertex : found){
+      utils::DynVector difference(vertex->getCoords());
+      difference -= patch.center;
+      double weight = evaluateWeight(tarch::la::norm2(difference) / patch.radius);
+      if (weight > 0.0){
+        patch.outVertices.push_back(vertex->getID());
+        patch.weights.push_back(weight);
+        weightSums[vertex->getID()] += weight;
+      }
+    }
+  }
+  for (Patch& patch : patches){
+    for (size_t i=0; i < patch.outVertices.size(); i++){
+      patch.weights[i] /= weightSums[patch.outVertices[i]];
+    }
+  }
+  // Extrapolate output vertices outside of all patches by the closest patch
+  for (int i=0; i < outputSize; i++){
+    if (weightSums[i] > 0.0){
+      continue;
+    }
+    const utils::DynVector& coords = outMesh.vertices()[i].getCoords();
+    int closest = -1;
+    double closestDistance = std::numeric_limits<double>::max();
+    for (int p=0; p < (int)patches.size(); p++){
+      utils::DynVector difference(coords);
+      difference -= patches[p].center;
+      double distance = tarch::la::norm2(difference);
+      if (distance < closestDistance){
+        closestDistance = distance;
+        closest = p;
+      }
+    }
+    assertion(closest >= 0);
+    preciceDebug("Extrapolate output vertex " << i << " by patch " << closest);
+    patches[closest].outVertices.push_back(i);
+    patches[closest].weights.push_back(1.0);
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: computePatch
+(
+  const mesh::Mesh&                     inMesh,
+  const mesh::Mesh&                     outMesh,
+  const query::KDTree&                  inTree,
+  const Patch&                          patch,
+  std::vector<Eigen::Triplet<double> >& triplets ) const
+{
+  if (patch.outVertices.empty()){
+    return;
+  }
+  int dimensions = inMesh.getDimensions();
+  std::vector<mesh::Vertex*> inVertices;
+  inTree.findVerticesInRadius(patch.center, patch.radius, inVertices);
+  int inputSize = (int)inVertices.size();
+  int outputSize = (int)patch.outVertices.size();
+  int polyparams = 1 + dimensions;
+  int n = inputSize + polyparams;
+  assertion(inputSize > polyparams, inputSize, polyparams);
+
+  // Local interpolation matrix C, coordinates are shifted to the patch center
+  Eigen::MatrixXd matrixC = Eigen::MatrixXd::Zero(n, n);
+  utils::DynVector difference(dimensions);
+  for (int i=0; i < inputSize; i++){
+    const utils::DynVector& iCoords = inVertices[i]->getCoords();
+    for (int j=i; j < inputSize; j++){
+      difference = iCoords;
+      difference -= inVertices[j]->getCoords();
+      matrixC(i,j) = _basisFunction.evaluate(tarch::la::norm2(difference));
+      matrixC(j,i) = matrixC(i,j);
+    }
+    matrixC(i,inputSize) = 1.0;
+    matrixC(inputSize,i) = 1.0;
+    for (int dim=0; dim < dimensions; dim++){
+      matrixC(i,inputSize+1+dim) = iCoords[dim] - patch.center[dim];
+      matrixC(inputSize+1+dim,i) = matrixC(i,inputSize+1+dim);
+    }
+  }
+
+  // Transposed local evaluation matrix A
+  Eigen::MatrixXd matrixAT(n, outputSize);
+  for (int i=0; i < outputSize; i++){
+    const utils::DynVector& iCoords = outMesh.vertices()[patch.outVertices[i]].getCoords();
+    for (int j=0; j < inputSize; j++){
+      difference = iCoords;
+      difference -= inVertices[j]->getCoords();
+      matrixAT(j,i) = _basisFunction.evaluate(tarch::la::norm2(difference));
+    }
+    matrixAT(inputSize,i) = 1.0;
+    for (int dim=0; dim < dimensions; dim++){
+      matrixAT(inputSize+1+dim,i) = iCoords[dim] - patch.center[dim];
+    }
+  }
+
+  // Local operator A * C^-1 = (C^-1 * A^T)^T, as C is symmetric. The QR
+  // decomposition also handles patches, where all vertices are coplanar.
+  Eigen::MatrixXd localOperator = matrixC.colPivHouseholderQr().solve(matrixAT);
+  for (int i=0; i < outputSize; i++){
+    for (int j=0; j < inputSize; j++){
+      triplets.push_back(Eigen::Triplet<double>(patch.outVertices[i], inVertices[j]->getID(),
+                                                patch.weights[i] * localOperator(j,i)));
+    }
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+double PartitionOfUnityMapping<RADIAL_BASIS_FUNCTION_T>:: evaluateWeight
+(
+  double relativeDistance )
+{
+  if (relativeDistance >= 1.0){
+    return 0.0;
+  }
+  return std::pow(1.0 - relativeDistance, 4) * (4.0 * relativeDistance + 1.0);
+}
+
+}} // namespace precice, mapping
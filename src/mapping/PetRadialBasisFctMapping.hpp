@@ -2,10 +2,13 @@
 #ifndef PRECICE_NO_PETSC
 
 #include <limits>
+#include <map>
 #include <typeinfo>
+#include <vector>
 
 #include "mapping/Mapping.hpp"
 #include "impl/BasisFunctions.hpp"
+#include "query/KDTree.hpp"
 #include "tarch/la/DynamicVector.h"
 #include "utils/MasterSlave.hpp"
 #include "utils/Petsc.hpp"
@@ -93,12 +96,37 @@ private:
 
   double _solverRtol;
 
+  /// Local number of rows of C the solver has been set up for, -1 if not yet set up.
+  PetscInt _solverLocalSize;
+
+  /**
+   * @brief Solutions of the previous map() calls, per output data ID and data dimension.
+   *
+   * Used as initial guess for the next solve, since coupling data changes
+   * smoothly from time step to time step.
+   */
+  std::map<int, std::vector<Vec>> _previousSolutions;
+
   /// true if the mapping along some axis should be ignored
   bool* _deadAxis;
 
+  /// Destroys all stored initial guesses.
+  void clearPreviousSolutions();
+
+  /// Solves C * x = rhs, using and updating the previous solution for outputDataID and dim.
+  void solve(Vec rhs, Vec x, int outputDataID, int dim);
+
   virtual bool doesVertexContribute(int vertexID) const override;
 
+  /// Increments diag, if column pos is within [begin, end), offDiag otherwise.
   void incPrealloc(PetscInt* diag, PetscInt* offDiag, int pos, int begin, int end);
+
+  /// Collects the input vertices within the support radius of point, all for global basis functions.
+  void findNeighbors(
+    const query::KDTree&        tree,
+    const mesh::PtrMesh&        inMesh,
+    const utils::DynVector&     point,
+    std::vector<mesh::Vertex*>& neighbors) const;
 };
 
 // --------------------------------------------------- HEADER IMPLEMENTATIONS
@@ -122,7 +150,8 @@ PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::PetRadialBasisFctMapping
   _basisFunction ( function ),
   _matrixC(PETSC_COMM_WORLD, "C"),
   _matrixA(PETSC_COMM_WORLD, "A"),
-  _solverRtol(solverRtol)
+  _solverRtol(solverRtol),
+  _solverLocalSize(-1)
 {
   setInputRequirement(VERTEX);
   setOutputRequirement(VERTEX);
@@ -148,6 +177,10 @@ PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::PetRadialBasisFctMapping
   }
 
   KSPCreate(PETSC_COMM_WORLD, &_solver);
+  // Block-Jacobi is the default, options can still override it in computeMapping
+  PC prec;
+  KSPGetPC(_solver, &prec);
+  PCSetType(prec, PCBJACOBI);
 }
 
 template<typename RADIAL_BASIS_FUNCTION_T>
@@ -158,6 +191,7 @@ PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::~PetRadialBasisFctMapping()
   PetscErrorCode ierr = 0;
   PetscInitialized(&petscIsInitialized);
   if (petscIsInitialized) {
+    clearPreviousSolutions();
     ierr = ISLocalToGlobalMappingDestroy(&_ISmapping); CHKERRV(ierr);
     ierr = KSPDestroy(&_solver); CHKERRV(ierr);
   }
@@ -217,20 +251,38 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::computeMapping()
   preciceDebug("outMesh->vertices().size() = " << outMesh->vertices().size());
 
   // Matrix C: Symmetric, sparse matrix with n x n local size.
+  // Both matrices are set up by the preallocation below.
   _matrixC.reset();
-  _matrixC.init(n, n, PETSC_DETERMINE, PETSC_DETERMINE, MATSBAIJ);
+  _matrixC.init(n, n, PETSC_DETERMINE, PETSC_DETERMINE, MATSBAIJ, false);
   preciceDebug("Set matrix C to local size " << n << " x " << n);
   ierr = MatSetOption(_matrixC.matrix, MAT_SYMMETRY_ETERNAL, PETSC_TRUE); CHKERRV(ierr);
 
   // Matrix A: Sparse matrix with outputSize x n local size.
   _matrixA.reset();
-  _matrixA.init(outputSize, n, PETSC_DETERMINE, PETSC_DETERMINE, MATAIJ);
+  _matrixA.init(outputSize, n, PETSC_DETERMINE, PETSC_DETERMINE, MATAIJ, false);
   preciceDebug("Set matrix A to local size " << outputSize << " x " << n);
 
-  KSPReset(_solver);
+  // Reset the solver and the initial guesses only when the layout of C changed,
+  // otherwise the previous solutions are still good initial guesses.
+  PetscInt localSizeChanged = (static_cast<PetscInt>(n) != _solverLocalSize) ? 1 : 0;
+  PetscInt sizeChanged = 0;
+  ierr = MPI_Allreduce(&localSizeChanged, &sizeChanged, 1, MPIU_INT, MPI_MAX, PETSC_COMM_WORLD); CHKERRV(ierr);
+  if (sizeChanged) {
+    preciceDebug("Layout of matrix C changed, resetting solver");
+    KSPReset(_solver);
+    clearPreviousSolutions();
+    _solverLocalSize = n;
+  }
 
-  const int ownerRangeABegin = _matrixA.ownerRange().first;
-  const int ownerRangeAEnd = _matrixA.ownerRange().second;
+  // The matrices are not set up yet and cannot tell their ownership ranges. Petsc
+  // distributes the rows contiguously in the order of the ranks, hence, we compute them here.
+  PetscInt localRowsC = n, localRowsA = outputSize;
+  PetscInt ownerRangeCEnd = 0, ownerRangeAEnd = 0, globalSizeC = 0;
+  ierr = MPI_Scan(&localRowsC, &ownerRangeCEnd, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD); CHKERRV(ierr);
+  ierr = MPI_Scan(&localRowsA, &ownerRangeAEnd, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD); CHKERRV(ierr);
+  ierr = MPI_Allreduce(&localRowsC, &globalSizeC, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD); CHKERRV(ierr);
+  const PetscInt ownerRangeCBegin = ownerRangeCEnd - localRowsC;
+  const PetscInt ownerRangeABegin = ownerRangeAEnd - localRowsA;
   
   IS ISlocal, ISlocalInv, ISglobal, ISidentity, ISidentityGlobal;
   ISLocalToGlobalMapping ISidentityMapping;
@@ -247,78 +299,152 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::computeMapping()
   ierr = ISAllGather(ISidentity, &ISidentityGlobal); CHKERRV(ierr);
   ierr = ISLocalToGlobalMappingCreateIS(ISidentityGlobal, &ISidentityMapping); CHKERRV(ierr);
 
-  ierr = MatSetLocalToGlobalMapping(_matrixC.matrix, _ISmapping, _ISmapping); CHKERRV(ierr); // Set mapping for rows and cols
-  ierr = MatSetLocalToGlobalMapping(_matrixA.matrix, ISidentityMapping, _ISmapping); CHKERRV(ierr); // Set mapping only for cols, use identity for rows
-
-  // Destroy all local index sets and mappings
+  // Destroy all local index sets
   ierr = ISDestroy(&ISlocal); CHKERRV(ierr);
   ierr = ISDestroy(&ISlocalInv); CHKERRV(ierr);
   ierr = ISDestroy(&ISglobal); CHKERRV(ierr);
   ierr = ISDestroy(&ISidentity); CHKERRV(ierr);
   ierr = ISDestroy(&ISidentityGlobal); CHKERRV(ierr);
-  ierr = ISLocalToGlobalMappingDestroy(&ISidentityMapping); CHKERRV(ierr);
+
+  // Petsc indices of the polynomial rows followed by the rows of all input vertices. They
+  // tell whether an entry is in the diagonal or off-diagonal block of the local rows.
+  std::vector<PetscInt> localIndices;
+  for (size_t i = 0; i < polyparams; i++)
+    localIndices.push_back(i);
+  for (const mesh::Vertex& v : inMesh->vertices())
+    localIndices.push_back(v.getGlobalIndex() + polyparams);
+  std::vector<PetscInt> petscIndices(localIndices.size());
+  ierr = ISLocalToGlobalMappingApply(_ISmapping, localIndices.size(), localIndices.data(),
+                                     petscIndices.data()); CHKERRV(ierr);
 
   utils::DynVector distance(dimensions);
+  std::vector<bool> deadAxes(_deadAxis, _deadAxis + dimensions);
+  query::KDTree tree(inMesh->vertices(), deadAxes);
+  std::vector<mesh::Vertex*> neighbors;
 
-  // We do preallocating of the matrices C and A. That means we traverse the input data once, just
-  // to know where we have entries in the sparse matrix. This information petsc can use to
-  // preallocate the matrix. In the second phase we actually fill the matrix.
+  // We do preallocating of the matrices C and A. That means we traverse the input data once,
+  // collect the nonzero entries row by row and count them per row, separately for the diagonal
+  // and off-diagonal block. This information petsc uses to preallocate the matrix. In the second
+  // phase we actually fill the matrix with the collected entries.
 
   // -- BEGIN PREALLOC LOOP FOR MATRIX C --
-  // TODO Testen ob Preallocation perfekt ist.
-  // MatSetOption(_matrixC.matrix, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
-  // MatSetOption(_matrixA.matrix, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
-  // {
-  //   preciceDebug("Begin preallocation matrix C");
-  //   int logPreallocCLoop = 1;  //   PetscLogEventRegister("Prealloc Matrix C", 0, &logPreallocCLoop);
-  //   PetscLogEventBegin(logPreallocCLoop, 0, 0, 0, 0);
-  //   PetscInt nnz[n]; // Number of non-zeros per row
-
-  //   if (utils::MasterSlave::_rank <= 0)
-  //     for (int i = 0; i < polyparams; i++)
-  //       nnz[i] = n; // The first rows are dense, except the part in upper right corner
-
-  //   for (const mesh::Vertex& inVertex : inMesh->vertices()) {
-  //     if (not inVertex.isOwner())
-  //       continue;
-
-  //     int row = inVertex.getGlobalIndex() + polyparams - _matrixC.ownerRange().first; // getGlobalIndex ist absolut, row[] ist zero based
-  //     // preciceDebug("Row = " << row << " n = " << n);
-  //     nnz[row] = 0;
-  
-  //     for (mesh::Vertex& vj : inMesh->vertices()) {
-  //       distance = inVertex.getCoords() - vj.getCoords();
-  //       for (int d = 0; d < dimensions; d++) {
-  //         if (_deadAxis[d]) {
-  //           distance[d] = 0;
-  //         }
-  //       }
-  //       double coeff = _basisFunction.evaluate(norm2(distance));
-  //       if (not tarch::la::equals(coeff, 0.0))
-  //         nnz[row]++;
-  //     }
-  //     // preciceDebug("Reserved for row = " << row << ", reserved = " << nnz[row]);
-  //   }
-  //   PetscLogEventEnd(logPreallocCLoop, 0, 0, 0, 0);
-  //   // -- END PREALLOC LOOP FOR MATRIX C --
-
-  //   ierr = MatMPISBAIJSetPreallocation(_matrixC.matrix, 1, 0, nnz, 0, nnz); CHKERRV(ierr);    
-  // }
+  preciceDebug("Begin preallocation matrix C");
+  precice::utils::Event ePreallocC("Preallocating Matrix C");
+  // Only the upper triangular part of the symmetric matrix C is stored.
+  std::vector<PetscInt> dnnzC(n, 0), onnzC(n, 0);
+  std::vector<PetscInt> rowOffsetsC(1, 0), colIdxC;
+  std::vector<PetscScalar> colValsC;
+  for (const mesh::Vertex& inVertex : inMesh->vertices()) {
+    if (not inVertex.isOwner())
+      continue;
+
+    const PetscInt petscRow = petscIndices[inVertex.getID() + polyparams];
+    const PetscInt localRow = petscRow - ownerRangeCBegin;
+    dnnzC[localRow]++; // Diagonal entry, set by MatDiagonalSet if zero
+
+    findNeighbors(tree, inMesh, inVertex.getCoords(), neighbors);
+    for (const mesh::Vertex* vj : neighbors) {
+      const PetscInt petscCol = petscIndices[vj->getID() + polyparams];
+      if (petscCol < petscRow)
+        continue; // lower triangular part
+      distance = inVertex.getCoords() - vj->getCoords();
+      for (int d = 0; d < dimensions; d++) {
+        if (_deadAxis[d]) {
+          distance[d] = 0;
+        }
+      }
+      double coeff = _basisFunction.evaluate(norm2(distance));
+      if (not tarch::la::equals(coeff, 0.0)) {
+        colValsC.push_back(coeff);
+        colIdxC.push_back(vj->getGlobalIndex() + polyparams); // column of entry is the globalIndex
+        if (petscCol != petscRow)
+          incPrealloc(&dnnzC[localRow], &onnzC[localRow], petscCol, ownerRangeCBegin, ownerRangeCEnd);
+      }
+    }
+    rowOffsetsC.push_back(colIdxC.size());
+  }
+  // The polynomial rows couple with the diagonal and all vertex columns
+  if (utils::MasterSlave::_rank <= 0) {
+    for (size_t i = 0; i < polyparams; i++) {
+      const PetscInt localRow = petscIndices[i] - ownerRangeCBegin;
+      dnnzC[localRow] = 1 + inputSize;
+      onnzC[localRow] = globalSizeC - localRowsC;
+    }
+  }
+  ierr = MatSeqSBAIJSetPreallocation(_matrixC.matrix, 1, 0, dnnzC.data()); CHKERRV(ierr);
+  ierr = MatMPISBAIJSetPreallocation(_matrixC.matrix, 1, 0, dnnzC.data(), 0, onnzC.data()); CHKERRV(ierr);
+  ePreallocC.stop();
+  // -- END PREALLOC LOOP FOR MATRIX C --
+
+  // -- BEGIN PREALLOC LOOP FOR MATRIX A --
+  preciceDebug("Begin preallocation matrix A");
+  precice::utils::Event ePreallocA("Preallocating Matrix A");
+  // The column ownership of A is the row ownership of C
+  std::vector<PetscInt> dnnzA(outputSize, 0), onnzA(outputSize, 0);
+  std::vector<PetscInt> rowOffsetsA(1, 0), colIdxA;
+  std::vector<PetscScalar> colValsA;
+  for (size_t i = 0; i < outputSize; i++) {
+    const mesh::Vertex& oVertex = outMesh->vertices()[i];
+
+    // -- THE POLYNOM PART OF THE MATRIX --
+    PetscInt polyCol = 0;
+    colIdxA.push_back(polyCol);
+    colValsA.push_back(1);
+    incPrealloc(&dnnzA[i], &onnzA[i], petscIndices[polyCol], ownerRangeCBegin, ownerRangeCEnd);
+    for (int dim = 0; dim < dimensions; dim++) {
+      if (not _deadAxis[dim]) {
+        polyCol++;
+        colIdxA.push_back(polyCol);
+        colValsA.push_back(oVertex.getCoords()[dim]);
+        incPrealloc(&dnnzA[i], &onnzA[i], petscIndices[polyCol], ownerRangeCBegin, ownerRangeCEnd);
+      }
+    }
+
+    // -- THE COEFFICIENTS --
+    findNeighbors(tree, inMesh, oVertex.getCoords(), neighbors);
+    for (const mesh::Vertex* inVertex : neighbors) {
+      distance = oVertex.getCoords() - inVertex->getCoords();
+      for (int d = 0; d < dimensions; d++) {
+        if (_deadAxis[d])
+          distance[d] = 0;
+      }
+      double coeff = _basisFunction.evaluate(norm2(distance));
+      if (not tarch::la::equals(coeff, 0.0)) {
+        colValsA.push_back(coeff);
+        colIdxA.push_back(inVertex->getGlobalIndex() + polyparams);
+        incPrealloc(&dnnzA[i], &onnzA[i], petscIndices[inVertex->getID() + polyparams],
+                    ownerRangeCBegin, ownerRangeCEnd);
+      }
+    }
+    rowOffsetsA.push_back(colIdxA.size());
+  }
+  ierr = MatSeqAIJSetPreallocation(_matrixA.matrix, 0, dnnzA.data()); CHKERRV(ierr);
+  ierr = MatMPIAIJSetPreallocation(_matrixA.matrix, 0, dnnzA.data(), 0, onnzA.data()); CHKERRV(ierr);
+  ePreallocA.stop();
+  // -- END PREALLOC LOOP FOR MATRIX A --
+
+  // Entries not counted above are still accepted, but show up as mallocs in the debug output below
+  ierr = MatSetOption(_matrixC.matrix, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE); CHKERRV(ierr);
+  ierr = MatSetOption(_matrixA.matrix, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE); CHKERRV(ierr);
+
+  ierr = MatSetLocalToGlobalMapping(_matrixC.matrix, _ISmapping, _ISmapping); CHKERRV(ierr); // Set mapping for rows and cols
+  ierr = MatSetLocalToGlobalMapping(_matrixA.matrix, ISidentityMapping, _ISmapping); CHKERRV(ierr); // Set mapping only for cols, use identity for rows
+  ierr = ISLocalToGlobalMappingDestroy(&ISidentityMapping); CHKERRV(ierr);
+
   // -- BEGIN FILL LOOP FOR MATRIX C --
   int logCLoop = 2;
   PetscLogEventRegister("Filling Matrix C", 0, &logCLoop);
   PetscLogEventBegin(logCLoop, 0, 0, 0, 0);
   precice::utils::Event eFillC("Filling Matrix C");
-  // We collect entries for each row and set them blockwise using MatSetValues.
+  // We set the collected entries of each row blockwise using MatSetValues.
+  int ownedRow = 0;
   for (const mesh::Vertex& inVertex : inMesh->vertices()) {
     if (not inVertex.isOwner())
       continue;
 
-    int row = inVertex.getGlobalIndex() + polyparams;
+    PetscInt row = inVertex.getGlobalIndex() + polyparams;
 
     // -- SETS THE POLYNOM PART OF THE MATRIX --
-    PetscInt colIdx[_matrixC.getSize().second];     // holds the columns indices of the entries
-    PetscScalar colVals[_matrixC.getSize().second]; // holds the values of the entries
     PetscInt polyRow = 0, polyCol = row;
     PetscScalar y = 1;
     ierr = MatSetValuesLocal(_matrixC.matrix, 1, &polyRow, 1, &polyCol, &y, INSERT_VALUES); CHKERRV(ierr);
@@ -333,23 +459,11 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::computeMapping()
     }
 
     // -- SETS THE COEFFICIENTS --
-    PetscInt colNum = 0;  // holds the number of columns
-    for (mesh::Vertex& vj : inMesh->vertices()) {
-      distance = inVertex.getCoords() - vj.getCoords();
-      for (int d = 0; d < dimensions; d++) {
-        if (_deadAxis[d]) {
-          distance[d] = 0;
-        }
-      }
-      double coeff = _basisFunction.evaluate(norm2(distance));
-      if (not tarch::la::equals(coeff, 0.0)) {
-        colVals[colNum] = coeff;
-        colIdx[colNum] = vj.getGlobalIndex() + polyparams; // column of entry is the globalIndex
-        colNum++;
-      }
-    }
-
-    ierr = MatSetValuesLocal(_matrixC.matrix, 1, &row, colNum, colIdx, colVals, INSERT_VALUES); CHKERRV(ierr);
+    PetscInt begin = rowOffsetsC[ownedRow];
+    PetscInt colNum = rowOffsetsC[ownedRow+1] - begin;
+    ierr = MatSetValuesLocal(_matrixC.matrix, 1, &row, colNum, colIdxC.data() + begin,
+                             colValsC.data() + begin, INSERT_VALUES); CHKERRV(ierr);
+    ownedRow++;
   }
   preciceDebug("Finished filling Matrix C");
   eFillC.stop();
@@ -364,51 +478,6 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::computeMapping()
   // Begin assembly here, all assembly is ended at the end of this function.
   ierr = MatAssemblyBegin(_matrixC.matrix, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
   
-  // -- BEGIN PREALLOC LOOP FOR MATRIX A --
-  // {
-  //   int localDiagColBegin = _matrixA.ownerRangeColumn().first;
-  //   int localDiagColEnd = _matrixA.ownerRangeColumn().second;
-  //   preciceDebug("Local Submatrix Rows = " << ownerRangeABegin << " / " << ownerRangeAEnd <<
-  //                ", Local Submatrix Cols = " << localDiagColBegin << " / " << localDiagColEnd);
-
-  //   preciceDebug("Begin preallocation matrix A.");
-  //   int logPreallocALoop = 3;
-  //   PetscLogEventRegister("Prealloc Matrix A", 0, &logPreallocALoop);
-  //   PetscLogEventBegin(logPreallocALoop, 0, 0, 0, 0);
-  //   PetscInt nnzA[outputSize]; // Number of non-zero entries, off-diagonal
-  //   PetscInt DnnzA[outputSize]; // Number of non-zero entries, diagonal
-  //   for (int i = 0; i < ownerRangeAEnd - ownerRangeABegin; i++) {
-  //     nnzA[i] = 0; DnnzA[i] = 0;
-  //     int polyCol = 1;
-  //     for (int dim = 0; dim < dimensions; dim++) {
-  //       if (not _deadAxis[dim]) {
-  //         incPrealloc(nnzA, DnnzA, polyCol, localDiagColBegin, localDiagColEnd);
-  //         ++polyCol;
-  //       }
-  //     }
-  //     const mesh::Vertex& oVertex = outMesh->vertices()[i];
-  //     for (const mesh::Vertex& inVertex : inMesh->vertices()) {
-  //       distance = oVertex.getCoords() - inVertex.getCoords();
-  //       for (int d = 0; d < dimensions; d++) {
-  //         if (_deadAxis[d])
-  //           distance[d] = 0;
-  //       }
-  //       double coeff = _basisFunction.evaluate(norm2(distance));
-  //       if (not tarch::la::equals(coeff, 0.0)) {
-  //         const int colPosition = inVertex.getGlobalIndex() + polyparams;
-  //         incPrealloc(nnzA, DnnzA, colPosition, localDiagColBegin, localDiagColEnd);
-  //       }
-  //       preciceDebug("Preallocating     diagonal row " << i << " with " << DnnzA[i] << " elements.");
-  //       preciceDebug("Preallocating off-diagonal row " << i << " with " << nnzA[i] << " elements.");
-  //     }
-  //   }
-  //   // -- END PREALLOC LOOP FOR MATRIX A --
-
-  //   // Preallocation: Number of diagonal non-zero entries equals outputSize, since diagonal is full
-  //   MatSetOption(_matrixA.matrix, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
-  //   ierr = MatMPIAIJSetPreallocation(_matrixA.matrix, 0, DnnzA, 0, nnzA); CHKERRV(ierr);
-  // }
-  
   // -- BEGIN FILL LOOP FOR MATRIX A --
   preciceDebug("Begin filling matrix A.");
   int logALoop = 4;
@@ -416,42 +485,11 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::computeMapping()
   PetscLogEventBegin(logALoop, 0, 0, 0, 0);
   precice::utils::Event eFillA("Filling Matrix A");
 
-  for (int it = ownerRangeABegin; it < ownerRangeAEnd; it++) {
-    // hier colIdx, colVals über inMesh->vertices.count dimensionieren?
-    PetscInt colNum = 0;
-    PetscInt colIdx[_matrixC.getSize().second];     // holds the columns indices of the entries MatrixC??
-    PetscScalar colVals[_matrixC.getSize().second]; // holds the values of the entries
-    const mesh::Vertex& oVertex = outMesh->vertices()[it - _matrixA.ownerRange().first];
-
-    // -- SET THE POLYNOM PART OF THE MATRIX --
-    PetscInt polyRow = it, polyCol = 0;
-    PetscScalar y = 1;
-    ierr = MatSetValuesLocal(_matrixA.matrix, 1, &polyRow, 1, &polyCol, &y, INSERT_VALUES); CHKERRV(ierr);
-    for (int dim = 0; dim < dimensions; dim++) {
-      if (not _deadAxis[dim]) {
-        y = oVertex.getCoords()[dim];
-        polyCol++;
-        // preciceDebug("Filling A with polyparams: polyRow = " << polyRow << ", polyCol = " << polyCol << " Preallocation = " << nnzA[polyRow]);
-        ierr = MatSetValuesLocal(_matrixA.matrix, 1, &polyRow, 1, &polyCol, &y, INSERT_VALUES); CHKERRV(ierr); // das zusammen mit den MatSetValuesLocal unten machen
-      }
-    }
-
-    // -- SETS THE COEFFICIENTS --
-    for (const mesh::Vertex& inVertex : inMesh->vertices()) {
-      distance = oVertex.getCoords() - inVertex.getCoords();
-      for (int d = 0; d < dimensions; d++) {
-        if (_deadAxis[d])
-          distance[d] = 0;
-      }
-      double coeff = _basisFunction.evaluate(norm2(distance));
-      if (not tarch::la::equals(coeff, 0.0)) {
-        colVals[colNum] = coeff;
-        colIdx[colNum] = inVertex.getGlobalIndex() + polyparams;
-        colNum++;
-      }
-    }
-    // preciceDebug("Filling A: row = " << it << ", col count = " << colNum);
-    ierr = MatSetValuesLocal(_matrixA.matrix, 1, &it, colNum, colIdx, colVals, INSERT_VALUES); CHKERRV(ierr);
+  for (PetscInt it = ownerRangeABegin; it < ownerRangeAEnd; it++) {
+    PetscInt begin = rowOffsetsA[it - ownerRangeABegin];
+    PetscInt colNum = rowOffsetsA[it - ownerRangeABegin + 1] - begin;
+    ierr = MatSetValuesLocal(_matrixA.matrix, 1, &it, colNum, colIdxA.data() + begin,
+                             colValsA.data() + begin, INSERT_VALUES); CHKERRV(ierr);
   }
   preciceDebug("Finished filling Matrix A");
   eFillA.stop();
@@ -461,8 +499,11 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::computeMapping()
   ierr = MatAssemblyBegin(_matrixA.matrix, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
   ierr = MatAssemblyEnd(_matrixC.matrix, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
   ierr = MatAssemblyEnd(_matrixA.matrix, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+  // The preconditioner is set up on the first solve and kept by KSPSolve as
+  // long as the operator is unchanged, i.e., until the next computeMapping().
   KSPSetOperators(_solver, _matrixC.matrix, _matrixC.matrix);
   KSPSetTolerances(_solver, _solverRtol, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT);
+  KSPSetInitialGuessNonzero(_solver, PETSC_TRUE);
   KSPSetFromOptions(_solver);
 
   // if (totalNNZ > static_cast<size_t>(20*n)) {
@@ -512,7 +553,6 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
              input()->getDimensions(), output()->getDimensions());
   using namespace tarch::la;
   PetscErrorCode ierr = 0;
-  KSPConvergedReason convReason;
   auto& inValues = input()->data(inputDataID)->values();
   auto& outValues = output()->data(outputDataID)->values();
 
@@ -542,11 +582,7 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
       
       in.assemble();
       ierr = MatMultTranspose(_matrixA.matrix, in.vector, Au.vector); CHKERRV(ierr);
-      ierr = KSPSolve(_solver, Au.vector, out.vector); CHKERRV(ierr);
-      ierr = KSPGetConvergedReason(_solver, &convReason); CHKERRV(ierr);
-      if (convReason < 0) {
-        preciceError(__func__, "RBF linear system has not converged.");
-      }
+      solve(Au.vector, out.vector, outputDataID, dim);
       
       // petsc::Vector res(_matrixC, "Residual");
       // PetscReal resNorm;
@@ -584,11 +620,7 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
         count++;
       }
       in.assemble();
-      ierr = KSPSolve(_solver, in.vector, p.vector); CHKERRV(ierr);
-      ierr = KSPGetConvergedReason(_solver, &convReason); CHKERRV(ierr);
-      if (convReason < 0) {
-        preciceError(__func__, "RBF linear system has not converged.");
-      }
+      solve(in.vector, p.vector, outputDataID, dim);
       ierr = MatMult(_matrixA.matrix, p.vector, out.vector); CHKERRV(ierr);
       VecChop(out.vector, 1e-9);
 
@@ -604,6 +636,56 @@ void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
 }
 
 
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::clearPreviousSolutions()
+{
+  for (auto& solutions : _previousSolutions) {
+    for (Vec& solution : solutions.second) {
+      VecDestroy(&solution);
+    }
+  }
+  _previousSolutions.clear();
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::solve
+(
+  Vec rhs,
+  Vec x,
+  int outputDataID,
+  int dim )
+{
+  preciceTrace2("solve()", outputDataID, dim);
+  PetscErrorCode ierr = 0;
+  KSPConvergedReason convReason;
+  std::vector<Vec>& solutions = _previousSolutions[outputDataID];
+  if (static_cast<int>(solutions.size()) <= dim) {
+    solutions.resize(dim + 1, nullptr);
+  }
+  Vec& previous = solutions[dim];
+  if (previous == nullptr) {
+    ierr = VecSet(x, 0.0); CHKERRV(ierr);
+  }
+  else {
+    ierr = VecCopy(previous, x); CHKERRV(ierr);
+  }
+
+  ierr = KSPSolve(_solver, rhs, x); CHKERRV(ierr);
+  ierr = KSPGetConvergedReason(_solver, &convReason); CHKERRV(ierr);
+  if (convReason < 0) {
+    preciceError(__func__, "RBF linear system has not converged.");
+  }
+  PetscInt iterations = 0;
+  KSPGetIterationNumber(_solver, &iterations);
+  preciceDebug("Solved RBF system for data " << outputDataID << ", dimension " << dim
+               << " in " << iterations << " iterations");
+
+  if (previous == nullptr) {
+    ierr = VecDuplicate(x, &previous); CHKERRV(ierr);
+  }
+  ierr = VecCopy(x, previous); CHKERRV(ierr);
+}
+
 template<typename RADIAL_BASIS_FUNCTION_T>
 bool PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::doesVertexContribute(int vertexID) const
 {
@@ -619,13 +701,30 @@ bool PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::doesVertexContribute(int
 template<typename RADIAL_BASIS_FUNCTION_T>
 void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::incPrealloc(PetscInt* diag, PetscInt* offDiag, int pos, int begin, int end)
 {
-  // Do some optimizatin here: inline, const, ...
-  if ((pos < begin) or (pos > end))
+  if ((pos < begin) or (pos >= end))
     (*offDiag)++; // vertex is off-diagonal
   else
     (*diag)++; // vertex is diagonal
 }
 
+template<typename RADIAL_BASIS_FUNCTION_T>
+void PetRadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>::findNeighbors
+(
+  const query::KDTree&        tree,
+  const mesh::PtrMesh&        inMesh,
+  const utils::DynVector&     point,
+  std::vector<mesh::Vertex*>& neighbors) const
+{
+  neighbors.clear();
+  if (_basisFunction.hasCompactSupport()) {
+    tree.findVerticesInRadius(point, _basisFunction.getSupportRadius(), neighbors);
+  }
+  else {
+    for (mesh::Vertex& vertex : inMesh->vertices())
+      neighbors.push_back(&vertex);
+  }
+}
+
 
 }} // namespace precice, mapping
 
@@ -4,11 +4,17 @@
 #include "impl/BasisFunctions.hpp"
 #include "utils/MasterSlave.hpp"
 #include "io/TXTWriter.hpp"
+#include "query/KDTree.hpp"
+#include <istream>
 #include <limits>
+#include <ostream>
 #include <typeinfo>
+#include <vector>
 
 #include "Eigen/Core"
 #include "Eigen/LU"
+#include "Eigen/SparseCore"
+#include "Eigen/SparseLU"
 
 namespace precice {
 namespace mapping {
@@ -23,6 +29,22 @@ namespace mapping {
  *
  * The radial basis function type has to be given as template parameter, and has
  * to be one of the defined types in this file.
+ *
+ * For basis functions with compact support, the interpolation matrix C and the
+ * evaluation matrix A are assembled as sparse matrices, using a KDTree to find
+ * all vertex pairs within the support radius, and C is factorized by a sparse
+ * LU decomposition. Memory and assembly costs then scale with the number of
+ * vertices times the number of neighbors within the support radius.
+ *
+ * Assembly of C and A and the products with A in map() are distributed among
+ * a configurable number of threads, if preCICE is built with OpenMP.
+ *
+ * With dense matrices, the computed mapping (A and the LU factors of C) can be
+ * stored and restored by a MappingCache.
+ *
+ * Optionally, the dense evaluation matrix A is stored in single precision,
+ * which halves the memory traffic of the products with A in map(). The products
+ * are still accumulated in double precision.
  */
 template<typename RADIAL_BASIS_FUNCTION_T>
 class RadialBasisFctMapping : public Mapping
@@ -34,6 +56,8 @@ public:
    *
    * @param constraint [IN] Specifies mapping to be consistent or conservative.
    * @param function [IN] Radial basis function used for mapping.
+   * @param threads [IN] Number of threads used for assembly and evaluation.
+   * @param singlePrecision [IN] Stores the dense evaluation matrix A as float.
    */
   RadialBasisFctMapping (
     Constraint              constraint,
@@ -41,7 +65,9 @@ public:
     RADIAL_BASIS_FUNCTION_T function,
     bool                    xDead,
     bool                    yDead,
-    bool                    zDead);
+    bool                    zDead,
+    int                     threads = 1,
+    bool                    singlePrecision = false);
 
 
   virtual ~RadialBasisFctMapping();
@@ -60,6 +86,15 @@ public:
     int inputDataID,
     int outputDataID ) override;
 
+  /// Maps all components of all given data with one blocked solve.
+  virtual void map ( const DataPairs& dataPairs ) override;
+
+  /// Writes A and the LU factors of C to stream, not supported with sparse matrices.
+  virtual bool writeCache ( std::ostream& stream ) const override;
+
+  /// Restores A and the LU factors of C written by writeCache().
+  virtual bool readCache ( std::istream& stream ) override;
+
 private:
 
   static tarch::logging::Log _log;
@@ -69,15 +104,59 @@ private:
   /// Radial basis function type used in interpolation.
   RADIAL_BASIS_FUNCTION_T _basisFunction;
 
+  /// True, if the basis function has compact support and sparse matrices are used.
+  bool _useSparse;
+
+  /// Number of threads used for assembly and evaluation, effective with OpenMP only.
+  int _threads;
+
   Eigen::MatrixXd _matrixA;
 
-  Eigen::PartialPivLU<Eigen::MatrixXd> _lu;
+  /// True, if the dense A is stored in _matrixAFloat instead of _matrixA.
+  bool _singlePrecision;
+
+  /// Evaluation matrix A, used instead of _matrixA if _singlePrecision is true.
+  Eigen::MatrixXf _matrixAFloat;
+
+  /// LU factors of C, stored explicitly such that they can be cached.
+  Eigen::MatrixXd _matrixLU;
+
+  /// Row permutation of the LU factorization of C.
+  Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> _permutation;
+
+  /// Evaluation matrix A, used instead of _matrixA if _useSparse is true.
+  Eigen::SparseMatrix<double, Eigen::RowMajor> _sparseMatrixA;
+
+  /// Factorization of C, used instead of _matrixLU if _useSparse is true.
+  Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> _sparseLU;
   
+
   /// true if the mapping along some axis should be ignored
   bool* _deadAxis;
 
   /// Deletes all dead directions from fullVector and returns a vector of reduced dimensionality.
   Eigen::VectorXd reduceVector(const utils::DynVector& fullVector);
+
+  /// Assembles and factorizes sparse C and A, neighbors are searched within the support radius.
+  void computeSparseMapping(
+    const mesh::PtrMesh& inMesh,
+    const mesh::PtrMesh& outMesh,
+    int                  polyparams);
+
+  /// Coefficients of the interpolant for all mapped data components (n x k).
+  Eigen::MatrixXd _coefficients;
+
+  /// Values of all mapped data components at the vertices of the rows of A.
+  Eigen::MatrixXd _values;
+
+  /// Solves C * X = rhs for all columns of rhs, the solution overwrites rhs.
+  void solveC(Eigen::MatrixXd& rhs) const;
+
+  /// Computes out = A * in, the rows of A are distributed among the threads.
+  void multiplyA(const Eigen::MatrixXd& in, Eigen::MatrixXd& out) const;
+
+  /// Computes out = A^T * in, the columns of A are distributed among the threads.
+  void multiplyATransposed(const Eigen::MatrixXd& in, Eigen::MatrixXd& out) const;
   
   void setDeadAxis(bool xDead, bool yDead, bool zDead)
   {
@@ -114,15 +193,28 @@ RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: RadialBasisFctMapping
   RADIAL_BASIS_FUNCTION_T function,
   bool                    xDead,
   bool                    yDead,
-  bool                    zDead)
+  bool                    zDead,
+  int                     threads,
+  bool                    singlePrecision)
   :
   Mapping ( constraint, dimensions ),
   _hasComputedMapping ( false ),
   _basisFunction ( function ),
-  _matrixA()
+  _useSparse ( function.hasCompactSupport() ),
+  _threads ( threads ),
+  _matrixA(),
+  _singlePrecision ( singlePrecision && (not function.hasCompactSupport()) ),
+  _matrixAFloat(),
+  _matrixLU(),
+  _permutation(),
+  _sparseMatrixA(),
+  _coefficients(),
+  _values()
 {
   setInputRequirement(VERTEX);
   setOutputRequirement(VERTEX);
+  preciceCheck(threads > 0, "RadialBasisFctMapping()",
+               "Number of threads for RBF mapping has to be larger than zero!");
   _deadAxis = new bool[dimensions];
   setDeadAxis(xDead,yDead,zDead);
 }
@@ -165,6 +257,14 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
   }
   int polyparams = 1 + dimensions - deadDimensions;
   assertion(inputSize >= 1 + polyparams, inputSize);
+  // Buffers of map() are sized for one vector valued data
+  _coefficients.resize(inputSize + polyparams, dimensions);
+  _values.resize(outputSize, dimensions);
+  if (_useSparse) {
+    computeSparseMapping(inMesh, outMesh, polyparams);
+    _hasComputedMapping = true;
+    return;
+  }
   int n = inputSize + polyparams; // Add linear polynom degrees
   Eigen::MatrixXd matrixCLU(n, n);
   matrixCLU.setZero();
@@ -172,9 +272,12 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
   _matrixA.setZero();
 
   // Fill upper right part (due to symmetry) of _matrixCLU with values
-  int i = 0;
-  utils::DynVector difference(dimensions);
-  for (const mesh::Vertex& iVertex : inMesh->vertices()) {
+# ifdef _OPENMP
+# pragma omp parallel for num_threads(_threads) schedule(dynamic, 16)
+# endif
+  for (int i = 0; i < inputSize; i++) {
+    const mesh::Vertex& iVertex = inMesh->vertices()[i];
+    utils::DynVector difference(dimensions);
     for (int j = iVertex.getID(); j < inputSize; j++) {
       difference = iVertex.getCoords();
       difference -= inMesh->vertices()[j].getCoords();
@@ -195,7 +298,6 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
     for (int dim=0; dim < dimensions-deadDimensions; dim++) {
       matrixCLU(i,inputSize+1+dim) = reduceVector(iVertex.getCoords())[dim];
     }
-    i++;
   }
   // Copy values of upper right part of C to lower left part
   for (int i = 0; i < n; i++) {
@@ -205,8 +307,12 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
   }
 
   // Fill _matrixA with values
-  i = 0;
-  for (const mesh::Vertex& iVertex : outMesh->vertices()) {
+# ifdef _OPENMP
+# pragma omp parallel for num_threads(_threads) schedule(static)
+# endif
+  for (int i = 0; i < outputSize; i++) {
+    const mesh::Vertex& iVertex = outMesh->vertices()[i];
+    utils::DynVector difference(dimensions);
     int j = 0;
     for (const mesh::Vertex& jVertex : inMesh->vertices()) {
       difference = iVertex.getCoords();
@@ -229,7 +335,6 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
     for (int dim=0; dim < dimensions-deadDimensions; dim++) {
       _matrixA(i,inputSize+1+dim) = reduceVector(iVertex.getCoords())[dim];
     }
-    i++;
   }
 
 # ifdef PRECICE_STATISTICS
@@ -253,9 +358,17 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeMapping()
   computeIndex++;
 # endif // PRECICE_STATISTICS
 
-  _lu = matrixCLU.partialPivLu();
-  
-  int determinant = _lu.determinant();
+  if (_singlePrecision) {
+    _matrixAFloat = _matrixA.cast<float>();
+    _matrixA.resize(0, 0);
+  }
+
+  Eigen::PartialPivLU<Eigen::MatrixXd> lu(matrixCLU);
+  matrixCLU.resize(0, 0);
+  _matrixLU = lu.matrixLU();
+  _permutation = lu.permutationP();
+
+  int determinant = lu.determinant();
 
   if (determinant == 0){
     preciceWarning("computeMapping()", "Interpolation matrix C has determinant of 0, e.g. is not regular.");
@@ -275,7 +388,12 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: clear()
 {
   preciceTrace("clear()");
   _matrixA = Eigen::MatrixXd();
-  _lu = Eigen::PartialPivLU<Eigen::MatrixXd>();
+  _matrixAFloat = Eigen::MatrixXf();
+  _matrixLU = Eigen::MatrixXd();
+  _permutation.resize(0);
+  _sparseMatrixA = Eigen::SparseMatrix<double, Eigen::RowMajor>();
+  _coefficients.resize(0, 0);
+  _values.resize(0, 0);
   _hasComputedMapping = false;
 }
 
@@ -286,85 +404,173 @@ void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
   int outputDataID )
 {
   preciceTrace2("map()", inputDataID, outputDataID);
+  output()->data(outputDataID)->values().setZero();
+  map(DataPairs(1, std::make_pair(inputDataID, outputDataID)));
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: map
+(
+  const DataPairs& dataPairs )
+{
+  preciceTrace1("map()", dataPairs.size());
   assertion(_hasComputedMapping);
   assertion(input()->getDimensions() == output()->getDimensions(),
              input()->getDimensions(), output()->getDimensions());
   assertion(getDimensions() == output()->getDimensions(),
              getDimensions(), output()->getDimensions());
-
-  Eigen::VectorXd& inValues = input()->data(inputDataID)->values();
-  Eigen::VectorXd& outValues = output()->data(outputDataID)->values();
-  int valueDim = input()->data(inputDataID)->getDimensions();
-  assertion(valueDim == output()->data(outputDataID)->getDimensions(),
-             valueDim, output()->data(outputDataID)->getDimensions());
+  // Data values are viewed as matrices with one row per vertex
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> ValuesMatrix;
+  int columns = 0;
+  for (const std::pair<int,int>& dataPair : dataPairs) {
+    int valueDim = input()->data(dataPair.first)->getDimensions();
+    assertion(valueDim == output()->data(dataPair.second)->getDimensions(),
+               valueDim, output()->data(dataPair.second)->getDimensions());
+    columns += valueDim;
+  }
   int deadDimensions = 0;
   for (int d = 0; d < getDimensions(); d++) {
     if (_deadAxis[d]) deadDimensions +=1;
   }
   int polyparams = 1 + getDimensions() - deadDimensions;
+  int rowsA = _useSparse ? _sparseMatrixA.rows()
+              : (_singlePrecision ? _matrixAFloat.rows() : _matrixA.rows());
+  int colsA = _useSparse ? _sparseMatrixA.cols()
+              : (_singlePrecision ? _matrixAFloat.cols() : _matrixA.cols());
+  int vertices = colsA - polyparams; // Vertices of the mesh C is built from
+  preciceDebug("A rows=" << rowsA << " cols=" << colsA << ", right-hand sides=" << columns);
 
   if (getConstraint() == CONSERVATIVE){
     preciceDebug("Map conservative");
-    static int mappingIndex = 0;
-    Eigen::VectorXd Au(_matrixA.cols());  // rows == n
-    Eigen::VectorXd in(_matrixA.rows());  // rows == outputSize
-    Eigen::VectorXd out(_matrixA.cols()); // rows == n
-
-    // preciceDebug("C rows=" << _matrixCLU.rows() << " cols=" << _matrixCLU.cols());
-    preciceDebug("A rows=" << _matrixA.rows() << " cols=" << _matrixA.cols());
-    preciceDebug("in size=" << in.size() << ", out size=" << out.size());
-
-    for (int dim = 0; dim < valueDim; dim++) {
-      for (int i = 0; i < in.size(); i++) { // Fill input data values
-        in[i] = inValues(i*valueDim + dim);
-      }
-#     ifdef PRECICE_STATISTICS
-      std::ostringstream stream;
-      stream << "invec-dim" << dim << "-" << mappingIndex << ".mat";
-      io::TXTWriter::write(in, stream.str());
-#     endif
-
-      Au = _matrixA.transpose() * in;
-      out = _lu.solve(Au);
-
-      // Copy mapped data to output data values
-#     ifdef PRECICE_STATISTICS
-      std::ostringstream stream2;
-      stream2 << "outvec-dim" << dim << "-" << mappingIndex << ".mat";
-      io::TXTWriter::write(out, stream2.str());
-#     endif
-      for (int i = 0; i < out.size()-polyparams; i++) {
-        outValues(i*valueDim + dim) = out[i];
-      }
+    // All components of all data are mapped at once, the buffers are
+    // preallocated for one vector valued data in computeMapping()
+    _values.resize(rowsA, columns);
+    int column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      const Eigen::VectorXd& inValues = input()->data(dataPair.first)->values();
+      int valueDim = input()->data(dataPair.first)->getDimensions();
+      _values.middleCols(column, valueDim) =
+          Eigen::Map<const ValuesMatrix>(inValues.data(), rowsA, valueDim);
+      column += valueDim;
+    }
+    multiplyATransposed(_values, _coefficients);
+    solveC(_coefficients);
+    column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      Eigen::VectorXd& outValues = output()->data(dataPair.second)->values();
+      int valueDim = output()->data(dataPair.second)->getDimensions();
+      Eigen::Map<ValuesMatrix>(outValues.data(), vertices, valueDim) +=
+          _coefficients.topRows(vertices).middleCols(column, valueDim);
+      column += valueDim;
     }
-    mappingIndex++;
   }
   else { // Map consistent
     preciceDebug("Map consistent");
-    Eigen::VectorXd p(_matrixA.cols());    // rows == n
-    Eigen::VectorXd in(_matrixA.cols());   // rows == n
-    Eigen::VectorXd out(_matrixA.rows());  // rows == outputSize
-    in.setZero();
-
-    // For every data dimension, perform mapping
-    for (int dim = 0; dim < valueDim; dim++) {
-      // Fill input from input data values (last polyparams entries remain zero)
-      for (int i = 0; i < in.size() - polyparams; i++) {
-        in[i] = inValues(i*valueDim + dim);
-      }
+    _coefficients.resize(colsA, columns);
+    _coefficients.bottomRows(polyparams).setZero();
+    int column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      const Eigen::VectorXd& inValues = input()->data(dataPair.first)->values();
+      int valueDim = input()->data(dataPair.first)->getDimensions();
+      _coefficients.topRows(vertices).middleCols(column, valueDim) =
+          Eigen::Map<const ValuesMatrix>(inValues.data(), vertices, valueDim);
+      column += valueDim;
+    }
+    solveC(_coefficients);
+    multiplyA(_coefficients, _values);
+    column = 0;
+    for (const std::pair<int,int>& dataPair : dataPairs) {
+      Eigen::VectorXd& outValues = output()->data(dataPair.second)->values();
+      int valueDim = output()->data(dataPair.second)->getDimensions();
+      Eigen::Map<ValuesMatrix>(outValues.data(), rowsA, valueDim) +=
+          _values.middleCols(column, valueDim);
+      column += valueDim;
+    }
+  }
+}
 
-      p = _lu.solve(in);
-      out = _matrixA * p;
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: writeCache
+(
+  std::ostream& stream) const
+{
+  assertion(_hasComputedMapping);
+  if (_useSparse) {
+    return false;
+  }
+  // A is written in the precision it is stored in
+  if (_singlePrecision) {
+    int sizes[3] = { (int)_matrixAFloat.rows(), (int)_matrixAFloat.cols(), (int)_matrixLU.rows() };
+    stream.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+    stream.write(reinterpret_cast<const char*>(_matrixAFloat.data()),
+                 _matrixAFloat.size() * sizeof(float));
+  }
+  else {
+    int sizes[3] = { (int)_matrixA.rows(), (int)_matrixA.cols(), (int)_matrixLU.rows() };
+    stream.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+    stream.write(reinterpret_cast<const char*>(_matrixA.data()),
+                 _matrixA.size() * sizeof(double));
+  }
+  stream.write(reinterpret_cast<const char*>(_matrixLU.data()),
+               _matrixLU.size() * sizeof(double));
+  stream.write(reinterpret_cast<const char*>(_permutation.indices().data()),
+               _permutation.size() * sizeof(int));
+  return true;
+}
 
-      // Copy mapped data to ouptut data values
-      for (int i = 0; i < out.size(); i++) {
-        outValues(i*valueDim + dim) = out[i];
-      }
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: readCache
+(
+  std::istream& stream)
+{
+  preciceTrace("readCache()");
+  if (_useSparse) {
+    return false;
+  }
+  int sizes[3] = { 0, 0, 0 };
+  stream.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+  bool isConsistent = getConstraint() == CONSISTENT;
+  int inputSize = (int)(isConsistent ? input() : output())->vertices().size();
+  int outputSize = (int)(isConsistent ? output() : input())->vertices().size();
+  // The polynomial adds at most one degree per dimension plus a constant
+  if ((not stream) || (sizes[0] != outputSize) || (sizes[1] != sizes[2])
+      || (sizes[1] <= inputSize) || (sizes[1] > inputSize + 1 + getDimensions()))
+  {
+    return false;
+  }
+  if (_singlePrecision) {
+    _matrixAFloat.resize(sizes[0], sizes[1]);
+    stream.read(reinterpret_cast<char*>(_matrixAFloat.data()), _matrixAFloat.size() * sizeof(float));
+  }
+  else {
+    _matrixA.resize(sizes[0], sizes[1]);
+    stream.read(reinterpret_cast<char*>(_matrixA.data()), _matrixA.size() * sizeof(double));
+  }
+  _matrixLU.resize(sizes[2], sizes[2]);
+  _permutation.resize(sizes[2]);
+  stream.read(reinterpret_cast<char*>(_matrixLU.data()), _matrixLU.size() * sizeof(double));
+  stream.read(reinterpret_cast<char*>(_permutation.indices().data()),
+              _permutation.size() * sizeof(int));
+  if (not stream) {
+    clear();
+    return false;
+  }
+  // The row permutation of the LU factors has to hold every row exactly once
+  std::vector<bool> isPermuted(sizes[2], false);
+  for (int i=0; i < sizes[2]; i++) {
+    int row = _permutation.indices()[i];
+    if ((row < 0) || (row >= sizes[2]) || isPermuted[row]) {
+      clear();
+      return false;
     }
+    isPermuted[row] = true;
   }
+  _coefficients.resize(sizes[1], getDimensions());
+  _values.resize(sizes[0], getDimensions());
+  _hasComputedMapping = true;
+  return true;
 }
 
-
 template<typename RADIAL_BASIS_FUNCTION_T>
 Eigen::VectorXd RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: reduceVector
 (
@@ -387,5 +593,205 @@ Eigen::VectorXd RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: reduceVector
   return reducedVector;
 }
 
+template<typename RADIAL_BASIS_FUNCTION_T>
+void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: computeSparseMapping
+(
+  const mesh::PtrMesh& inMesh,
+  const mesh::PtrMesh& outMesh,
+  int                  polyparams)
+{
+  preciceTrace1("computeSparseMapping()", _basisFunction.getSupportRadius());
+  typedef Eigen::Triplet<double> Triplet;
+  int inputSize = (int)inMesh->vertices().size();
+  int outputSize = (int)outMesh->vertices().size();
+  int n = inputSize + polyparams; // Add linear polynom degrees
+  double supportRadius = _basisFunction.getSupportRadius();
+  std::vector<bool> deadAxes(_deadAxis, _deadAxis + getDimensions());
+  query::KDTree tree(inMesh->vertices(), deadAxes);
+  std::vector<Triplet> triplets;
+
+  // Fill C with values, the neighbor search is symmetric
+# ifdef _OPENMP
+# pragma omp parallel num_threads(_threads)
+# endif
+  {
+    std::vector<Triplet> localTriplets;
+    std::vector<mesh::Vertex*> neighbors;
+    utils::DynVector difference(getDimensions());
+#   ifdef _OPENMP
+#   pragma omp for schedule(dynamic, 64) nowait
+#   endif
+    for (int i = 0; i < inputSize; i++) {
+      const mesh::Vertex& iVertex = inMesh->vertices()[i];
+      neighbors.clear();
+      tree.findVerticesInRadius(iVertex.getCoords(), supportRadius, neighbors);
+      for (const mesh::Vertex* jVertex : neighbors) {
+        difference = iVertex.getCoords();
+        difference -= jVertex->getCoords();
+        double value = _basisFunction.evaluate(reduceVector(difference).norm());
+        if (value != 0.0) {
+          localTriplets.push_back(Triplet(i, jVertex->getID(), value));
+        }
+      }
+      localTriplets.push_back(Triplet(i, inputSize, 1.0));
+      localTriplets.push_back(Triplet(inputSize, i, 1.0));
+      Eigen::VectorXd reducedCoords = reduceVector(iVertex.getCoords());
+      for (int dim=0; dim < polyparams-1; dim++) {
+        localTriplets.push_back(Triplet(i, inputSize+1+dim, reducedCoords[dim]));
+        localTriplets.push_back(Triplet(inputSize+1+dim, i, reducedCoords[dim]));
+      }
+    }
+#   ifdef _OPENMP
+#   pragma omp critical
+#   endif
+    triplets.insert(triplets.end(), localTriplets.begin(), localTriplets.end());
+  }
+  Eigen::SparseMatrix<double> matrixC(n, n);
+  matrixC.setFromTriplets(triplets.begin(), triplets.end());
+  matrixC.makeCompressed();
+  preciceDebug("C rows=" << n << " nonzeros=" << matrixC.nonZeros());
+
+  // Fill A with values
+  triplets.clear();
+# ifdef _OPENMP
+# pragma omp parallel num_threads(_threads)
+# endif
+  {
+    std::vector<Triplet> localTriplets;
+    std::vector<mesh::Vertex*> neighbors;
+    utils::DynVector difference(getDimensions());
+#   ifdef _OPENMP
+#   pragma omp for schedule(dynamic, 64) nowait
+#   endif
+    for (int i = 0; i < outputSize; i++) {
+      const mesh::Vertex& iVertex = outMesh->vertices()[i];
+      neighbors.clear();
+      tree.findVerticesInRadius(iVertex.getCoords(), supportRadius, neighbors);
+      for (const mesh::Vertex* jVertex : neighbors) {
+        difference = iVertex.getCoords();
+        difference -= jVertex->getCoords();
+        double value = _basisFunction.evaluate(reduceVector(difference).norm());
+        if (value != 0.0) {
+          localTriplets.push_back(Triplet(i, jVertex->getID(), value));
+        }
+      }
+      localTriplets.push_back(Triplet(i, inputSize, 1.0));
+      Eigen::VectorXd reducedCoords = reduceVector(iVertex.getCoords());
+      for (int dim=0; dim < polyparams-1; dim++) {
+        localTriplets.push_back(Triplet(i, inputSize+1+dim, reducedCoords[dim]));
+      }
+    }
+#   ifdef _OPENMP
+#   pragma omp critical
+#   endif
+    triplets.insert(triplets.end(), localTriplets.begin(), localTriplets.end());
+  }
+  _sparseMatrixA.resize(outputSize, n);
+  _sparseMatrixA.setFromTriplets(triplets.begin(), triplets.end());
+  _sparseMatrixA.makeCompressed();
+  preciceDebug("A rows=" << outputSize << " nonzeros=" << _sparseMatrixA.nonZeros());
+
+  _sparseLU.compute(matrixC);
+  preciceCheck(_sparseLU.info() == Eigen::Success, "computeMapping()",
+               "Sparse LU factorization of interpolation matrix C failed, "
+               << "e.g. C is not regular: " << _sparseLU.lastErrorMessage());
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: solveC
+(
+  Eigen::MatrixXd& rhs) const
+{
+  if (_useSparse) {
+    Eigen::MatrixXd solution = _sparseLU.solve(rhs);
+    rhs.swap(solution);
+    return;
+  }
+  // Same steps as Eigen::PartialPivLU::solve(), but in place and blocked for all columns
+  rhs = _permutation * rhs;
+  _matrixLU.triangularView<Eigen::UnitLower>().solveInPlace(rhs);
+  _matrixLU.triangularView<Eigen::Upper>().solveInPlace(rhs);
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: multiplyA
+(
+  const Eigen::MatrixXd& in,
+  Eigen::MatrixXd&       out) const
+{
+  if (_useSparse) {
+    out.resize(_sparseMatrixA.rows(), in.cols());
+#   ifdef _OPENMP
+#   pragma omp parallel for num_threads(_threads) schedule(static)
+#   endif
+    for (int i = 0; i < _sparseMatrixA.rows(); i++) {
+      out.row(i).noalias() = _sparseMatrixA.row(i) * in;
+    }
+    return;
+  }
+  int rows = _singlePrecision ? _matrixAFloat.rows() : _matrixA.rows();
+  out.resize(rows, in.cols());
+  int blockSize = (rows + _threads - 1) / _threads;
+# ifdef _OPENMP
+# pragma omp parallel for num_threads(_threads) schedule(static)
+# endif
+  for (int block = 0; block < _threads; block++) {
+    int begin = block * blockSize;
+    int size = std::min(blockSize, rows - begin);
+    if (size <= 0) {
+      continue;
+    }
+    if (_singlePrecision) {
+      // Columns of A are converted on the fly, out is accumulated in double
+      out.middleRows(begin, size).setZero();
+      for (int j = 0; j < _matrixAFloat.cols(); j++) {
+        for (int k = 0; k < in.cols(); k++) {
+          out.col(k).segment(begin, size) +=
+              _matrixAFloat.col(j).segment(begin, size).cast<double>() * in(j,k);
+        }
+      }
+    }
+    else {
+      out.middleRows(begin, size).noalias() = _matrixA.middleRows(begin, size) * in;
+    }
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void RadialBasisFctMapping<RADIAL_BASIS_FUNCTION_T>:: multiplyATransposed
+(
+  const Eigen::MatrixXd& in,
+  Eigen::MatrixXd&       out) const
+{
+  if (_useSparse) {
+    // Scattering into out does not parallelize with row major storage
+    out.resize(_sparseMatrixA.cols(), in.cols());
+    out.noalias() = _sparseMatrixA.transpose() * in;
+    return;
+  }
+  int cols = _singlePrecision ? _matrixAFloat.cols() : _matrixA.cols();
+  out.resize(cols, in.cols());
+  int blockSize = (cols + _threads - 1) / _threads;
+# ifdef _OPENMP
+# pragma omp parallel for num_threads(_threads) schedule(static)
+# endif
+  for (int block = 0; block < _threads; block++) {
+    int begin = block * blockSize;
+    int size = std::min(blockSize, cols - begin);
+    if (size <= 0) {
+      continue;
+    }
+    if (_singlePrecision) {
+      for (int j = begin; j < begin + size; j++) {
+        for (int k = 0; k < in.cols(); k++) {
+          out(j,k) = _matrixAFloat.col(j).cast<double>().dot(in.col(k));
+        }
+      }
+    }
+    else {
+      out.middleRows(begin, size).noalias() = _matrixA.middleCols(begin, size).transpose() * in;
+    }
+  }
+}
 
 }} // namespace precice, mapping
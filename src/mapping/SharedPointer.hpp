@@ -6,9 +6,11 @@ namespace precice {
 namespace mapping {
 
 class Mapping;
+class MappingCache;
 class MappingConfiguration;
 
 using PtrMapping              = std::shared_ptr<Mapping>;
+using PtrMappingCache         = std::shared_ptr<MappingCache>;
 using PtrMappingConfiguration = std::shared_ptr<MappingConfiguration>;
 
 }} // namespace precice, mapping
@@ -3,6 +3,9 @@
 #include "mapping/NearestProjectionMapping.hpp"
 #include "mapping/RadialBasisFctMapping.hpp"
 #include "mapping/PetRadialBasisFctMapping.hpp"
+#include "mapping/PartitionOfUnityMapping.hpp"
+#include "mapping/HierarchicalRadialBasisFctMapping.hpp"
+#include "mapping/MappingCache.hpp"
 #include "mapping/impl/BasisFunctions.hpp"
 #include "mesh/config/MeshConfiguration.hpp"
 #include "utils/Globals.hpp"
@@ -10,6 +13,8 @@
 #include "utils/xml/XMLAttribute.hpp"
 #include "utils/xml/ValidatorEquals.hpp"
 #include "utils/xml/ValidatorOr.hpp"
+#include <iomanip>
+#include <sstream>
 
 namespace precice {
 namespace mapping {
@@ -41,6 +46,13 @@ MappingConfiguration:: MappingConfiguration
   ATTR_X_DEAD("x-dead"),
   ATTR_Y_DEAD("y-dead"),
   ATTR_Z_DEAD("z-dead"),
+  ATTR_THREADS("threads"),
+  ATTR_CACHE_DIRECTORY("cache-directory"),
+  ATTR_VERTICES_PER_PATCH("vertices-per-patch"),
+  ATTR_RELATIVE_OVERLAP("relative-overlap"),
+  ATTR_TOLERANCE("tolerance"),
+  ATTR_UPDATE_TOLERANCE("update-tolerance"),
+  ATTR_SINGLE_PRECISION("single-precision"),
   VALUE_WRITE("write"),
   VALUE_READ("read"),
   VALUE_CONSISTENT("consistent"),
@@ -65,6 +77,18 @@ MappingConfiguration:: MappingConfiguration
   VALUE_PETRBF_CPOLYNOMIAL_C0("petrbf-compact-polynomial-c0"),
   VALUE_PETRBF_CPOLYNOMIAL_C6("petrbf-compact-polynomial-c6"),
 
+  VALUE_PU_RBF_TPS("pu-rbf-thin-plate-splines"),
+  VALUE_PU_RBF_MULTIQUADRICS("pu-rbf-multiquadrics"),
+  VALUE_PU_RBF_INV_MULTIQUADRICS("pu-rbf-inverse-multiquadrics"),
+  VALUE_PU_RBF_VOLUME_SPLINES("pu-rbf-volume-splines"),
+  VALUE_PU_RBF_GAUSSIAN("pu-rbf-gaussian"),
+
+  VALUE_HRBF_TPS("hrbf-thin-plate-splines"),
+  VALUE_HRBF_MULTIQUADRICS("hrbf-multiquadrics"),
+  VALUE_HRBF_INV_MULTIQUADRICS("hrbf-inverse-multiquadrics"),
+  VALUE_HRBF_VOLUME_SPLINES("hrbf-volume-splines"),
+  VALUE_HRBF_GAUSSIAN("hrbf-gaussian"),
+
   VALUE_TIMING_INITIAL("initial"),
   VALUE_TIMING_ON_ADVANCE("onadvance"),
   VALUE_TIMING_ON_DEMAND("ondemand"),
@@ -89,6 +113,30 @@ MappingConfiguration:: MappingConfiguration
   XMLAttribute<bool> attrZDead(ATTR_Z_DEAD);
   attrZDead.setDocumentation("If set to true, the z axis will be ignored for the mapping");
   attrZDead.setDefaultValue(false);
+  XMLAttribute<int> attrThreads(ATTR_THREADS);
+  attrThreads.setDocumentation("Number of threads used to assemble and evaluate the "
+                               "interpolation system, requires preCICE built with OpenMP");
+  attrThreads.setDefaultValue(1);
+  XMLAttribute<int> attrVerticesPerPatch(ATTR_VERTICES_PER_PATCH);
+  attrVerticesPerPatch.setDocumentation("Maximal number of input vertices a partition "
+                                        "of unity patch is created from");
+  attrVerticesPerPatch.setDefaultValue(50);
+  XMLAttribute<double> attrRelativeOverlap(ATTR_RELATIVE_OVERLAP);
+  attrRelativeOverlap.setDocumentation("Enlargement of partition of unity patch radii, "
+                                       "relative to the radius covering its vertices");
+  attrRelativeOverlap.setDefaultValue(0.3);
+  XMLAttribute<double> attrTolerance(ATTR_TOLERANCE);
+  attrTolerance.setDocumentation("Relative accuracy of the hierarchical matrix approximation "
+                                 "of the interpolation and evaluation matrices");
+  attrTolerance.setDefaultValue(1e-6);
+  XMLAttribute<double> attrUpdateTolerance(ATTR_UPDATE_TOLERANCE);
+  attrUpdateTolerance.setDocumentation("With timing onadvance, vertices moving less than this "
+                                       "distance keep their neighbor when the mapping is updated");
+  attrUpdateTolerance.setDefaultValue(0.0);
+  XMLAttribute<bool> attrSinglePrecision(ATTR_SINGLE_PRECISION);
+  attrSinglePrecision.setDocumentation("If set to true, the evaluation matrix is stored in "
+                                       "single precision, results are accumulated in double");
+  attrSinglePrecision.setDefaultValue(false);
 
 
 
@@ -96,6 +144,7 @@ MappingConfiguration:: MappingConfiguration
   std::list<XMLTag> tags;
   {
     XMLTag tag(*this, VALUE_NEAREST_NEIGHBOR, occ, TAG);
+    tag.addAttribute(attrUpdateTolerance);
     tags.push_back(tag);
   }
   {
@@ -107,6 +156,8 @@ MappingConfiguration:: MappingConfiguration
     tag.addAttribute(attrXDead);
     tag.addAttribute(attrYDead);
     tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tag.addAttribute(attrSinglePrecision);
     tags.push_back(tag);
   }
   {
@@ -115,6 +166,8 @@ MappingConfiguration:: MappingConfiguration
     tag.addAttribute(attrXDead);
     tag.addAttribute(attrYDead);
     tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tag.addAttribute(attrSinglePrecision);
     tags.push_back(tag);
   }
   {
@@ -123,6 +176,8 @@ MappingConfiguration:: MappingConfiguration
     tag.addAttribute(attrXDead);
     tag.addAttribute(attrYDead);
     tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tag.addAttribute(attrSinglePrecision);
     tags.push_back(tag);
   }
   {
@@ -130,6 +185,8 @@ MappingConfiguration:: MappingConfiguration
     tag.addAttribute(attrXDead);
     tag.addAttribute(attrYDead);
     tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tag.addAttribute(attrSinglePrecision);
     tags.push_back(tag);
   }
   {
@@ -138,11 +195,13 @@ MappingConfiguration:: MappingConfiguration
     tag.addAttribute(attrXDead);
     tag.addAttribute(attrYDead);
     tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
     tags.push_back(tag);
   }
   {
     XMLTag tag(*this, VALUE_RBF_CTPS_C2, occ, TAG);
     tag.addAttribute(attrSupportRadius);
+    tag.addAttribute(attrThreads);
     tags.push_back(tag);
   }
   {
@@ -151,6 +210,7 @@ MappingConfiguration:: MappingConfiguration
     tag.addAttribute(attrXDead);
     tag.addAttribute(attrYDead);
     tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
     tags.push_back(tag);
   }
   {
@@ -159,6 +219,7 @@ MappingConfiguration:: MappingConfiguration
     tag.addAttribute(attrXDead);
     tag.addAttribute(attrYDead);
     tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
     tags.push_back(tag);
   }
   // ---- Petsc RBF declarations ----
@@ -233,6 +294,101 @@ MappingConfiguration:: MappingConfiguration
     tags.push_back(tag);
   }
 
+  // ---- Partition of unity RBF declarations ----
+  {
+    XMLTag tag(*this, VALUE_PU_RBF_TPS, occ, TAG);
+    tag.addAttribute(attrVerticesPerPatch);
+    tag.addAttribute(attrRelativeOverlap);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_PU_RBF_MULTIQUADRICS, occ, TAG);
+    tag.addAttribute(attrShapeParam);
+    tag.addAttribute(attrVerticesPerPatch);
+    tag.addAttribute(attrRelativeOverlap);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_PU_RBF_INV_MULTIQUADRICS, occ, TAG);
+    tag.addAttribute(attrShapeParam);
+    tag.addAttribute(attrVerticesPerPatch);
+    tag.addAttribute(attrRelativeOverlap);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_PU_RBF_VOLUME_SPLINES, occ, TAG);
+    tag.addAttribute(attrVerticesPerPatch);
+    tag.addAttribute(attrRelativeOverlap);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_PU_RBF_GAUSSIAN, occ, TAG);
+    tag.addAttribute(attrShapeParam);
+    tag.addAttribute(attrVerticesPerPatch);
+    tag.addAttribute(attrRelativeOverlap);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+
+  // ---- Hierarchical matrix RBF declarations ----
+  {
+    XMLTag tag(*this, VALUE_HRBF_TPS, occ, TAG);
+    tag.addAttribute(attrTolerance);
+    tag.addAttribute(attrSolverRtol);
+    tag.addAttribute(attrXDead);
+    tag.addAttribute(attrYDead);
+    tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_HRBF_MULTIQUADRICS, occ, TAG);
+    tag.addAttribute(attrShapeParam);
+    tag.addAttribute(attrTolerance);
+    tag.addAttribute(attrSolverRtol);
+    tag.addAttribute(attrXDead);
+    tag.addAttribute(attrYDead);
+    tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_HRBF_INV_MULTIQUADRICS, occ, TAG);
+    tag.addAttribute(attrShapeParam);
+    tag.addAttribute(attrTolerance);
+    tag.addAttribute(attrSolverRtol);
+    tag.addAttribute(attrXDead);
+    tag.addAttribute(attrYDead);
+    tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_HRBF_VOLUME_SPLINES, occ, TAG);
+    tag.addAttribute(attrTolerance);
+    tag.addAttribute(attrSolverRtol);
+    tag.addAttribute(attrXDead);
+    tag.addAttribute(attrYDead);
+    tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+  {
+    XMLTag tag(*this, VALUE_HRBF_GAUSSIAN, occ, TAG);
+    tag.addAttribute(attrShapeParam);
+    tag.addAttribute(attrTolerance);
+    tag.addAttribute(attrSolverRtol);
+    tag.addAttribute(attrXDead);
+    tag.addAttribute(attrYDead);
+    tag.addAttribute(attrZDead);
+    tag.addAttribute(attrThreads);
+    tags.push_back(tag);
+  }
+
   XMLAttribute<std::string> attrDirection ( ATTR_DIRECTION );
   ValidatorEquals<std::string> validDirectionWrite ( VALUE_WRITE );
   ValidatorEquals<std::string> validDirectionRead ( VALUE_READ );
@@ -271,12 +427,19 @@ MappingConfiguration:: MappingConfiguration
   ValidString validOnDemand(VALUE_TIMING_ON_DEMAND);
   attrTiming.setValidator(validInitial || validOnAdvance || validOnDemand);
 
+  XMLAttribute<std::string> attrCacheDirectory(ATTR_CACHE_DIRECTORY);
+  attrCacheDirectory.setDocumentation("If set, the computed mapping is stored in this "
+      "directory and restored in later runs with identical meshes, instead of being "
+      "computed again. Applies to mappings with timing \"initial\" only.");
+  attrCacheDirectory.setDefaultValue("");
+
   for (XMLTag& tag : tags){
     tag.addAttribute(attrDirection);
     tag.addAttribute(attrFromMesh);
     tag.addAttribute(attrToMesh);
     tag.addAttribute(attrConstraint);
     tag.addAttribute(attrTiming);
+    tag.addAttribute(attrCacheDirectory);
     //tag.addAttribute(attrIncremental);
     parent.addSubtag(tag);
   }
@@ -360,6 +523,12 @@ void MappingConfiguration:: xmlTagCallback
     bool xDead = false;
     bool yDead = false;
     bool zDead = false;
+    int threads = 1;
+    int verticesPerPatch = 50;
+    double relativeOverlap = 0.3;
+    double tolerance = 1e-6;
+    double updateTolerance = 0.0;
+    bool singlePrecision = false;
     if (tag.hasAttribute(ATTR_SHAPE_PARAM)){
       shapeParameter = tag.getDoubleAttributeValue(ATTR_SHAPE_PARAM);
     }
@@ -378,10 +547,43 @@ void MappingConfiguration:: xmlTagCallback
     if (tag.hasAttribute(ATTR_Z_DEAD)){
       zDead = tag.getBooleanAttributeValue(ATTR_Z_DEAD);
     }
+    if (tag.hasAttribute(ATTR_THREADS)){
+      threads = tag.getIntAttributeValue(ATTR_THREADS);
+    }
+    if (tag.hasAttribute(ATTR_VERTICES_PER_PATCH)){
+      verticesPerPatch = tag.getIntAttributeValue(ATTR_VERTICES_PER_PATCH);
+    }
+    if (tag.hasAttribute(ATTR_RELATIVE_OVERLAP)){
+      relativeOverlap = tag.getDoubleAttributeValue(ATTR_RELATIVE_OVERLAP);
+    }
+    if (tag.hasAttribute(ATTR_TOLERANCE)){
+      tolerance = tag.getDoubleAttributeValue(ATTR_TOLERANCE);
+    }
+    if (tag.hasAttribute(ATTR_UPDATE_TOLERANCE)){
+      updateTolerance = tag.getDoubleAttributeValue(ATTR_UPDATE_TOLERANCE);
+    }
+    if (tag.hasAttribute(ATTR_SINGLE_PRECISION)){
+      singlePrecision = tag.getBooleanAttributeValue(ATTR_SINGLE_PRECISION);
+    }
         
     ConfiguredMapping configuredMapping = createMapping(dir, type, constraint,
       fromMesh, toMesh, timing, shapeParameter, supportRadius, solverRtol,
-      xDead, yDead, zDead);
+      xDead, yDead, zDead, threads, verticesPerPatch, relativeOverlap, tolerance,
+      updateTolerance, singlePrecision);
+    std::string cacheDirectory = tag.getStringAttributeValue(ATTR_CACHE_DIRECTORY);
+    if (not cacheDirectory.empty()){
+      preciceCheck(timing == INITIAL, "xmlTagCallback()", "Mapping from mesh \""
+                   << fromMesh << "\" to mesh \"" << toMesh << "\" can only be "
+                   << "cached with timing \"" << VALUE_TIMING_INITIAL << "\"!");
+      // Parameters, which change the computed mapping, identify the cache files
+      std::ostringstream configuration;
+      configuration << type << ':' << constraint << ':' << std::setprecision(17)
+                    << shapeParameter << ':' << supportRadius << ':' << solverRtol
+                    << ':' << xDead << yDead << zDead << ':' << verticesPerPatch
+                    << ':' << relativeOverlap << ':' << tolerance << ':' << singlePrecision;
+      configuredMapping.cache = PtrMappingCache(
+          new MappingCache(cacheDirectory, configuration.str()));
+    }
     checkDuplicates ( configuredMapping );
     _mappings.push_back ( configuredMapping );
   }
@@ -439,7 +641,13 @@ MappingConfiguration::ConfiguredMapping MappingConfiguration:: createMapping
   double             solverRtol,
   bool               xDead,
   bool               yDead,
-  bool               zDead) const
+  bool               zDead,
+  int                threads,
+  int                verticesPerPatch,
+  double             relativeOverlap,
+  double             tolerance,
+  double             updateTolerance,
+  bool               singlePrecision) const
 {
   preciceTrace5("createMapping()", direction, type, timing,
                 shapeParameter, supportRadius);
@@ -487,7 +695,7 @@ MappingConfiguration::ConfiguredMapping MappingConfiguration:: createMapping
   #endif
   if (type == VALUE_NEAREST_NEIGHBOR){
     configuredMapping.mapping = PtrMapping (
-        new NearestNeighborMapping(constraintValue, dimensions) );
+        new NearestNeighborMapping(constraintValue, dimensions, updateTolerance) );
   }
   else if (type == VALUE_NEAREST_PROJECTION){
 //    preciceCheck ( direction == VALUE_WRITE, "createMapping()",
@@ -508,48 +716,108 @@ MappingConfiguration::ConfiguredMapping MappingConfiguration:: createMapping
   else if (type == VALUE_RBF_TPS){
     configuredMapping.mapping = PtrMapping (
       new RadialBasisFctMapping<ThinPlateSplines>(constraintValue, dimensions, ThinPlateSplines(),
-            xDead, yDead, zDead));
+            xDead, yDead, zDead, threads, singlePrecision));
   }
   else if (type == VALUE_RBF_MULTIQUADRICS){
     configuredMapping.mapping = PtrMapping (
       new RadialBasisFctMapping<Multiquadrics>(
         constraintValue, dimensions, Multiquadrics(shapeParameter),
-        xDead, yDead, zDead ));
+        xDead, yDead, zDead, threads, singlePrecision));
   }
   else if (type == VALUE_RBF_INV_MULTIQUADRICS){
     configuredMapping.mapping = PtrMapping (
       new RadialBasisFctMapping<InverseMultiquadrics>(
         constraintValue, dimensions, InverseMultiquadrics(shapeParameter),
-        xDead, yDead, zDead ));
+        xDead, yDead, zDead, threads, singlePrecision));
   }
   else if (type == VALUE_RBF_VOLUME_SPLINES){
     configuredMapping.mapping = PtrMapping (
       new RadialBasisFctMapping<VolumeSplines>(constraintValue, dimensions, VolumeSplines(),
-      xDead, yDead, zDead ));
+      xDead, yDead, zDead, threads, singlePrecision));
   }
   else if (type == VALUE_RBF_GAUSSIAN){
     configuredMapping.mapping = PtrMapping(
         new RadialBasisFctMapping<Gaussian>(
           constraintValue, dimensions, Gaussian(shapeParameter),
-          xDead, yDead, zDead));
+          xDead, yDead, zDead, threads));
   }
   else if (type == VALUE_RBF_CTPS_C2){
     configuredMapping.mapping = PtrMapping (
       new RadialBasisFctMapping<CompactThinPlateSplinesC2>(
         constraintValue, dimensions, CompactThinPlateSplinesC2(supportRadius),
-        xDead, yDead, zDead ));
+        xDead, yDead, zDead, threads));
   }
   else if (type == VALUE_RBF_CPOLYNOMIAL_C0){
     configuredMapping.mapping = PtrMapping (
       new RadialBasisFctMapping<CompactPolynomialC0>(
         constraintValue, dimensions, CompactPolynomialC0(supportRadius),
-        xDead, yDead, zDead ));
+        xDead, yDead, zDead, threads));
   }
   else if (type == VALUE_RBF_CPOLYNOMIAL_C6){
     configuredMapping.mapping = PtrMapping (
       new RadialBasisFctMapping<CompactPolynomialC6>(
         constraintValue, dimensions, CompactPolynomialC6(supportRadius),
-        xDead, yDead, zDead ));
+        xDead, yDead, zDead, threads));
+  }
+  else if (type == VALUE_PU_RBF_TPS){
+    configuredMapping.mapping = PtrMapping (
+      new PartitionOfUnityMapping<ThinPlateSplines>(
+        constraintValue, dimensions, ThinPlateSplines(),
+        verticesPerPatch, relativeOverlap, threads));
+  }
+  else if (type == VALUE_PU_RBF_MULTIQUADRICS){
+    configuredMapping.mapping = PtrMapping (
+      new PartitionOfUnityMapping<Multiquadrics>(
+        constraintValue, dimensions, Multiquadrics(shapeParameter),
+        verticesPerPatch, relativeOverlap, threads));
+  }
+  else if (type == VALUE_PU_RBF_INV_MULTIQUADRICS){
+    configuredMapping.mapping = PtrMapping (
+      new PartitionOfUnityMapping<InverseMultiquadrics>(
+        constraintValue, dimensions, InverseMultiquadrics(shapeParameter),
+        verticesPerPatch, relativeOverlap, threads));
+  }
+  else if (type == VALUE_PU_RBF_VOLUME_SPLINES){
+    configuredMapping.mapping = PtrMapping (
+      new PartitionOfUnityMapping<VolumeSplines>(
+        constraintValue, dimensions, VolumeSplines(),
+        verticesPerPatch, relativeOverlap, threads));
+  }
+  else if (type == VALUE_PU_RBF_GAUSSIAN){
+    configuredMapping.mapping = PtrMapping (
+      new PartitionOfUnityMapping<Gaussian>(
+        constraintValue, dimensions, Gaussian(shapeParameter),
+        verticesPerPatch, relativeOverlap, threads));
+  }
+  else if (type == VALUE_HRBF_TPS){
+    configuredMapping.mapping = PtrMapping (
+      new HierarchicalRadialBasisFctMapping<ThinPlateSplines>(
+        constraintValue, dimensions, ThinPlateSplines(),
+        xDead, yDead, zDead, tolerance, solverRtol, threads));
+  }
+  else if (type == VALUE_HRBF_MULTIQUADRICS){
+    configuredMapping.mapping = PtrMapping (
+      new HierarchicalRadialBasisFctMapping<Multiquadrics>(
+        constraintValue, dimensions, Multiquadrics(shapeParameter),
+        xDead, yDead, zDead, tolerance, solverRtol, threads));
+  }
+  else if (type == VALUE_HRBF_INV_MULTIQUADRICS){
+    configuredMapping.mapping = PtrMapping (
+      new HierarchicalRadialBasisFctMapping<InverseMultiquadrics>(
+        constraintValue, dimensions, InverseMultiquadrics(shapeParameter),
+        xDead, yDead, zDead, tolerance, solverRtol, threads));
+  }
+  else if (type == VALUE_HRBF_VOLUME_SPLINES){
+    configuredMapping.mapping = PtrMapping (
+      new HierarchicalRadialBasisFctMapping<VolumeSplines>(
+        constraintValue, dimensions, VolumeSplines(),
+        xDead, yDead, zDead, tolerance, solverRtol, threads));
+  }
+  else if (type == VALUE_HRBF_GAUSSIAN){
+    configuredMapping.mapping = PtrMapping (
+      new HierarchicalRadialBasisFctMapping<Gaussian>(
+        constraintValue, dimensions, Gaussian(shapeParameter),
+        xDead, yDead, zDead, tolerance, solverRtol, threads));
   }
 # ifndef PRECICE_NO_PETSC
   else if (type == VALUE_PETRBF_TPS){
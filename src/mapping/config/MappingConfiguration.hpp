@@ -48,6 +48,8 @@ public:
     Direction direction;
     // @brief When the mapping should be executed.
     Timing timing;
+    // @brief Stores the computed mapping on disk, empty if not configured.
+    PtrMappingCache cache;
   };
 
   // @brief Name of xml tag for this class in configuration file
@@ -120,6 +122,13 @@ private:
   const std::string ATTR_X_DEAD;
   const std::string ATTR_Y_DEAD;
   const std::string ATTR_Z_DEAD;
+  const std::string ATTR_THREADS;
+  const std::string ATTR_CACHE_DIRECTORY;
+  const std::string ATTR_VERTICES_PER_PATCH;
+  const std::string ATTR_RELATIVE_OVERLAP;
+  const std::string ATTR_TOLERANCE;
+  const std::string ATTR_UPDATE_TOLERANCE;
+  const std::string ATTR_SINGLE_PRECISION;
 
   const std::string VALUE_WRITE;
   const std::string VALUE_READ;
@@ -144,6 +153,18 @@ private:
   const std::string VALUE_PETRBF_CTPS_C2;
   const std::string VALUE_PETRBF_CPOLYNOMIAL_C0;
   const std::string VALUE_PETRBF_CPOLYNOMIAL_C6;
+
+  const std::string VALUE_PU_RBF_TPS;
+  const std::string VALUE_PU_RBF_MULTIQUADRICS;
+  const std::string VALUE_PU_RBF_INV_MULTIQUADRICS;
+  const std::string VALUE_PU_RBF_VOLUME_SPLINES;
+  const std::string VALUE_PU_RBF_GAUSSIAN;
+
+  const std::string VALUE_HRBF_TPS;
+  const std::string VALUE_HRBF_MULTIQUADRICS;
+  const std::string VALUE_HRBF_INV_MULTIQUADRICS;
+  const std::string VALUE_HRBF_VOLUME_SPLINES;
+  const std::string VALUE_HRBF_GAUSSIAN;
   
   const std::string VALUE_TIMING_INITIAL;
   const std::string VALUE_TIMING_ON_ADVANCE;
@@ -167,7 +188,13 @@ private:
     double             solverRtol,
     bool               xDead,
     bool               yDead,
-    bool               zDead) const;
+    bool               zDead,
+    int                threads,
+    int                verticesPerPatch,
+    double             relativeOverlap,
+    double             tolerance,
+    double             updateTolerance,
+    bool               singlePrecision) const;
 
   void checkDuplicates ( const ConfiguredMapping& mapping );
 
@@ -0,0 +1,482 @@
+#pragma once
+
+#include "utils/Globals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Core"
+
+namespace precice {
+namespace mapping {
+
+/**
+ * @brief Hierarchical matrix approximation of a radial basis function kernel matrix.
+ *
+ * Represents K(i,j) = phi(|x_i - y_j|) for row points x_i and column points y_j.
+ * Both point sets are ordered into cluster trees by recursive bisection. Blocks
+ * of well separated clusters (min(diam(r), diam(c)) <= eta * dist(r, c)) are
+ * approximated by low-rank products U * V^T, computed by adaptive cross
+ * approximation with partial pivoting up to the given relative tolerance. All
+ * other blocks are split until leaf size and then stored densely.
+ *
+ * For smooth kernels, storage and matrix-vector products cost O(n log n)
+ * instead of O(n^2) for the dense matrix.
+ *
+ * To be used with the basis functions in BasisFunctions.hpp.
+ */
+template<typename RADIAL_BASIS_FUNCTION_T>
+class HMatrix
+{
+public:
+
+  /**
+   * @brief Constructor, builds the cluster trees and approximates all blocks.
+   *
+   * @param rowPoints [IN] Coordinates of the row points, one column per point.
+   * @param colPoints [IN] Coordinates of the column points, one column per point.
+   * @param tolerance [IN] Relative accuracy of the low-rank blocks.
+   * @param threads [IN] Number of threads used to approximate the blocks.
+   * @param leafSize [IN] Maximal number of points in a leaf cluster.
+   * @param eta [IN] Admissibility parameter, smaller values separate clusters further.
+   */
+  HMatrix (
+    const Eigen::MatrixXd&  rowPoints,
+    const Eigen::MatrixXd&  colPoints,
+    RADIAL_BASIS_FUNCTION_T function,
+    double                  tolerance,
+    int                     threads = 1,
+    int                     leafSize = 32,
+    double                  eta = 2.0 );
+
+  int rows() const
+  { return (int)_rowPermutation.size(); }
+
+  int cols() const
+  { return (int)_colPermutation.size(); }
+
+  /// Returns the number of stored matrix entries, rows() * cols() for a dense matrix.
+  size_t storageSize() const;
+
+  /// Computes out = K * in, for all columns of in.
+  void multiply (
+    const Eigen::MatrixXd& in,
+    Eigen::MatrixXd&       out ) const;
+
+  /// Computes out = K^T * in, for all columns of in.
+  void multiplyTransposed (
+    const Eigen::MatrixXd& in,
+    Eigen::MatrixXd&       out ) const;
+
+private:
+
+  /// Node of a cluster tree, holding the points at tree positions [begin, end).
+  struct Cluster
+  {
+    int begin;
+    int end;
+    Eigen::VectorXd lower;
+    Eigen::VectorXd upper;
+    /// Indices of the two child clusters, -1 for leaves.
+    int children[2];
+  };
+
+  /// Block of K, approximated by U * V^T if lowRank, stored densely in U otherwise.
+  struct Block
+  {
+    int rowCluster;
+    int colCluster;
+    bool lowRank;
+    Eigen::MatrixXd U;
+    Eigen::MatrixXd V;
+  };
+
+  RADIAL_BASIS_FUNCTION_T _basisFunction;
+
+  double _tolerance;
+
+  int _leafSize;
+
+  double _eta;
+
+  /// Row and column points, in tree order.
+  Eigen::MatrixXd _rowPoints;
+  Eigen::MatrixXd _colPoints;
+
+  /// Original index of the point at every tree position.
+  std::vector<int> _rowPermutation;
+  std::vector<int> _colPermutation;
+
+  std::vector<Cluster> _rowClusters;
+  std::vector<Cluster> _colClusters;
+
+  std::vector<Block> _blocks;
+
+  /// Orders points at tree positions [begin, end) into clusters, returns the cluster index.
+  int buildClusters (
+    Eigen::MatrixXd&      points,
+    std::vector<int>&     permutation,
+    int                   begin,
+    int                   end,
+    std::vector<Cluster>& clusters ) const;
+
+  /// Creates blocks for the product of a row and a column cluster.
+  void buildBlocks ( int rowCluster, int colCluster );
+
+  bool isAdmissible ( const Cluster& rowCluster, const Cluster& colCluster ) const;
+
+  double entry ( int row, int col ) const
+  { return _basisFunction.evaluate((_rowPoints.col(row) - _colPoints.col(col)).norm()); }
+
+  void computeDense ( Block& block ) const;
+
+  /// Approximates the block by adaptive cross approximation, returns false if not compressible.
+  bool computeLowRank ( Block& block ) const;
+
+  /// Computes out += (transposed ? K^T : K) * in, with in and out in tree order.
+  void multiplyBlocks (
+    const Eigen::MatrixXd& in,
+    Eigen::MatrixXd&       out,
+    bool                   transposed ) const;
+};
+
+// --------------------------------------------------- HEADER IMPLEMENTATIONS
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+HMatrix<RADIAL_BASIS_FUNCTION_T>:: HMatrix
+(
+  const Eigen::MatrixXd&  rowPoints,
+  const Eigen::MatrixXd&  colPoints,
+  RADIAL_BASIS_FUNCTION_T function,
+  double                  tolerance,
+  int                     threads,
+  int                     leafSize,
+  double                  eta )
+:
+  _basisFunction(function),
+  _tolerance(tolerance),
+  _leafSize(leafSize),
+  _eta(eta),
+  _rowPoints(rowPoints),
+  _colPoints(colPoints),
+  _rowPermutation(rowPoints.cols()),
+  _colPermutation(colPoints.cols()),
+  _rowClusters(),
+  _colClusters(),
+  _blocks()
+{
+  assertion(rowPoints.rows() == colPoints.rows(), rowPoints.rows(), colPoints.rows());
+  assertion(tolerance > 0.0, tolerance);
+  assertion(leafSize > 0, leafSize);
+  for (int i=0; i < rows(); i++){
+    _rowPermutation[i] = i;
+  }
+  for (int i=0; i < cols(); i++){
+    _colPermutation[i] = i;
+  }
+  if ((rows() == 0) || (cols() == 0)){
+    return;
+  }
+  buildClusters(_rowPoints, _rowPermutation, 0, rows(), _rowClusters);
+  buildClusters(_colPoints, _colPermutation, 0, cols(), _colClusters);
+  buildBlocks(0, 0);
+
+  // Blocks are independent, but differ largely in costs
+# ifdef _OPENMP
+# pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+# endif
+  for (int i=0; i < (int)_blocks.size(); i++){
+    Block& block = _blocks[i];
+    if ((not block.lowRank) || (not computeLowRank(block))){
+      computeDense(block);
+    }
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+size_t HMatrix<RADIAL_BASIS_FUNCTION_T>:: storageSize() const
+{
+  size_t size = 0;
+  for (const Block& block : _blocks){
+    size += block.U.size() + block.V.size();
+  }
+  return size;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HMatrix<RADIAL_BASIS_FUNCTION_T>:: multiply
+(
+  const Eigen::MatrixXd& in,
+  Eigen::MatrixXd&       out ) const
+{
+  assertion(in.rows() == cols(), in.rows(), cols());
+  Eigen::MatrixXd treeIn(cols(), in.cols());
+  for (int i=0; i < cols(); i++){
+    treeIn.row(i) = in.row(_colPermutation[i]);
+  }
+  Eigen::MatrixXd treeOut = Eigen::MatrixXd::Zero(rows(), in.cols());
+  multiplyBlocks(treeIn, treeOut, false);
+  out.resize(rows(), in.cols());
+  for (int i=0; i < rows(); i++){
+    out.row(_rowPermutation[i]) = treeOut.row(i);
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HMatrix<RADIAL_BASIS_FUNCTION_T>:: multiplyTransposed
+(
+  const Eigen::MatrixXd& in,
+  Eigen::MatrixXd&       out ) const
+{
+  assertion(in.rows() == rows(), in.rows(), rows());
+  Eigen::MatrixXd treeIn(rows(), in.cols());
+  for (int i=0; i < rows(); i++){
+    treeIn.row(i) = in.row(_rowPermutation[i]);
+  }
+  Eigen::MatrixXd treeOut = Eigen::MatrixXd::Zero(cols(), in.cols());
+  multiplyBlocks(treeIn, treeOut, true);
+  out.resize(cols(), in.cols());
+  for (int i=0; i < cols(); i++){
+    out.row(_colPermutation[i]) = treeOut.row(i);
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+int HMatrix<RADIAL_BASIS_FUNCTION_T>:: buildClusters
+(
+  Eigen::MatrixXd&      points,
+  std::vector<int>&     permutation,
+  int                   begin,
+  int                   end,
+  std::vector<Cluster>& clusters ) const
+{
+  int index = (int)clusters.size();
+  clusters.push_back(Cluster());
+  Eigen::VectorXd lower = points.col(begin);
+  Eigen::VectorXd upper = points.col(begin);
+  for (int i=begin+1; i < end; i++){
+    lower = lower.cwiseMin(points.col(i));
+    upper = upper.cwiseMax(points.col(i));
+  }
+  clusters[index].begin = begin;
+  clusters[index].end = end;
+  clusters[index].lower = lower;
+  clusters[index].upper = upper;
+  clusters[index].children[0] = -1;
+  clusters[index].children[1] = -1;
+  if (end - begin <= _leafSize){
+    return index;
+  }
+
+  // Split at the median along the axis of largest extent
+  int splitDimension = 0;
+  (upper - lower).maxCoeff(&splitDimension);
+  std::vector<int> order(end - begin);
+  for (int i=0; i < end - begin; i++){
+    order[i] = begin + i;
+  }
+  int middle = (end - begin) / 2;
+  std::nth_element(order.begin(), order.begin() + middle, order.end(),
+                   [&points, splitDimension] (int a, int b) {
+                     return points(splitDimension, a) < points(splitDimension, b); });
+  Eigen::MatrixXd sortedPoints(points.rows(), end - begin);
+  std::vector<int> sortedPermutation(end - begin);
+  for (int i=0; i < end - begin; i++){
+    sortedPoints.col(i) = points.col(order[i]);
+    sortedPermutation[i] = permutation[order[i]];
+  }
+  points.middleCols(begin, end - begin) = sortedPoints;
+  std::copy(sortedPermutation.begin(), sortedPermutation.end(), permutation.begin() + begin);
+
+  int left = buildClusters(points, permutation, begin, begin + middle, clusters);
+  int right = buildClusters(points, permutation, begin + middle, end, clusters);
+  clusters[index].children[0] = left;
+  clusters[index].children[1] = right;
+  return index;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HMatrix<RADIAL_BASIS_FUNCTION_T>:: buildBlocks
+(
+  int rowCluster,
+  int colCluster )
+{
+  const Cluster& row = _rowClusters[rowCluster];
+  const Cluster& col = _colClusters[colCluster];
+  bool rowIsLeaf = row.children[0] < 0;
+  bool colIsLeaf = col.children[0] < 0;
+  bool admissible = isAdmissible(row, col);
+  if (admissible || (rowIsLeaf && colIsLeaf)){
+    Block block;
+    block.rowCluster = rowCluster;
+    block.colCluster = colCluster;
+    block.lowRank = admissible;
+    _blocks.push_back(block);
+  }
+  else if (rowIsLeaf){
+    buildBlocks(rowCluster, col.children[0]);
+    buildBlocks(rowCluster, col.children[1]);
+  }
+  else if (colIsLeaf){
+    buildBlocks(row.children[0], colCluster);
+    buildBlocks(row.children[1], colCluster);
+  }
+  else {
+    for (int i=0; i < 2; i++){
+      for (int j=0; j < 2; j++){
+        buildBlocks(row.children[i], col.children[j]);
+      }
+    }
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool HMatrix<RADIAL_BASIS_FUNCTION_T>:: isAdmissible
+(
+  const Cluster& rowCluster,
+  const Cluster& colCluster ) const
+{
+  double rowDiameter = (rowCluster.upper - rowCluster.lower).norm();
+  double colDiameter = (colCluster.upper - colCluster.lower).norm();
+  Eigen::VectorXd gap = (rowCluster.lower - colCluster.upper).cwiseMax(
+                         colCluster.lower - rowCluster.upper).cwiseMax(0.0);
+  double distance = gap.norm();
+  return (distance > 0.0) && (std::min(rowDiameter, colDiameter) <= _eta * distance);
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HMatrix<RADIAL_BASIS_FUNCTION_T>:: computeDense
+(
+  Block& block ) const
+{
+  const Cluster& row = _rowClusters[block.rowCluster];
+  const Cluster& col = _colClusters[block.colCluster];
+  block.lowRank = false;
+  block.U.resize(row.end - row.begin, col.end - col.begin);
+  block.V.resize(0, 0);
+  for (int j=col.begin; j < col.end; j++){
+    for (int i=row.begin; i < row.end; i++){
+      block.U(i - row.begin, j - col.begin) = entry(i, j);
+    }
+  }
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+bool HMatrix<RADIAL_BASIS_FUNCTION_T>:: computeLowRank
+(
+  Block& block ) const
+{
+  const Cluster& row = _rowClusters[block.rowCluster];
+  const Cluster& col = _colClusters[block.colCluster];
+  int m = row.end - row.begin;
+  int n = col.end - col.begin;
+  // Low-rank storage pays off only below this rank
+  int maxRank = (m * n) / (m + n);
+  std::vector<Eigen::VectorXd> us;
+  std::vector<Eigen::VectorXd> vs;
+  std::vector<bool> usedRows(m, false);
+  double squaredNorm = 0.0; // Frobenius norm of the approximation, squared
+  int pivotRow = 0;
+  while ((int)us.size() < maxRank){
+    usedRows[pivotRow] = true;
+    // Residual of the pivot row
+    Eigen::VectorXd v(n);
+    for (int j=0; j < n; j++){
+      v(j) = entry(row.begin + pivotRow, col.begin + j);
+    }
+    for (size_t k=0; k < us.size(); k++){
+      v -= us[k](pivotRow) * vs[k];
+    }
+    int pivotCol = 0;
+    double pivot = v.cwiseAbs().maxCoeff(&pivotCol);
+    if (pivot > std::numeric_limits<double>::min()){
+      v /= v(pivotCol);
+      // Residual of the pivot column
+      Eigen::VectorXd u(m);
+      for (int i=0; i < m; i++){
+        u(i) = entry(row.begin + i, col.begin + pivotCol);
+      }
+      for (size_t k=0; k < us.size(); k++){
+        u -= vs[k](pivotCol) * us[k];
+      }
+      double crossNorm = 0.0;
+      for (size_t k=0; k < us.size(); k++){
+        crossNorm += us[k].dot(u) * vs[k].dot(v);
+      }
+      double updateNorm = u.norm() * v.norm();
+      squaredNorm += 2.0 * crossNorm + updateNorm * updateNorm;
+      us.push_back(u);
+      vs.push_back(v);
+      if (updateNorm <= _tolerance * std::sqrt(std::abs(squaredNorm))){
+        break;
+      }
+      // Next pivot row is the largest entry of u among the unused rows
+      pivotRow = -1;
+      double largest = -1.0;
+      for (int i=0; i < m; i++){
+        if ((not usedRows[i]) && (std::abs(u(i)) > largest)){
+          largest = std::abs(u(i));
+          pivotRow = i;
+        }
+      }
+    }
+    else {
+      // Row is approximated exactly, continue with the next unused row
+      pivotRow = std::find(usedRows.begin(), usedRows.end(), false) - usedRows.begin();
+      if (pivotRow == m){
+        pivotRow = -1;
+      }
+    }
+    if (pivotRow < 0){
+      break;
+    }
+  }
+  if ((int)us.size() >= maxRank){
+    return false;
+  }
+  block.U.resize(m, us.size());
+  block.V.resize(n, vs.size());
+  for (size_t k=0; k < us.size(); k++){
+    block.U.col(k) = us[k];
+    block.V.col(k) = vs[k];
+  }
+  return true;
+}
+
+template<typename RADIAL_BASIS_FUNCTION_T>
+void HMatrix<RADIAL_BASIS_FUNCTION_T>:: multiplyBlocks
+(
+  const Eigen::MatrixXd& in,
+  Eigen::MatrixXd&       out,
+  bool                   transposed ) const
+{
+  for (const Block& block : _blocks){
+    const Cluster& row = _rowClusters[block.rowCluster];
+    const Cluster& col = _colClusters[block.colCluster];
+    int rowCount = row.end - row.begin;
+    int colCount = col.end - col.begin;
+    if (transposed){
+      auto blockIn = in.middleRows(row.begin, rowCount);
+      auto blockOut = out.middleRows(col.begin, colCount);
+      if (block.lowRank){
+        blockOut.noalias() += block.V * (block.U.transpose() * blockIn);
+      }
+      else {
+        blockOut.noalias() += block.U.transpose() * blockIn;
+      }
+    }
+    else {
+      auto blockIn = in.middleRows(col.begin, colCount);
+      auto blockOut = out.middleRows(row.begin, rowCount);
+      if (block.lowRank){
+        blockOut.noalias() += block.U * (block.V.transpose() * blockIn);
+      }
+      else {
+        blockOut.noalias() += block.U * blockIn;
+      }
+    }
+  }
+}
+
+}} // namespace precice, mapping
@@ -0,0 +1,204 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#include "HierarchicalRadialBasisFctMappingTest.hpp"
+#include "mapping/HierarchicalRadialBasisFctMapping.hpp"
+#include "mapping/RadialBasisFctMapping.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Data.hpp"
+#include "mesh/Vertex.hpp"
+#include "utils/Globals.hpp"
+#include "utils/Parallel.hpp"
+#include "tarch/la/ScalarOperations.h"
+#include <cmath>
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(precice::mapping::tests::HierarchicalRadialBasisFctMappingTest)
+
+namespace precice {
+namespace mapping {
+namespace tests {
+
+tarch::logging::Log HierarchicalRadialBasisFctMappingTest::
+  _log ( "precice::mapping::tests::HierarchicalRadialBasisFctMappingTest" );
+
+HierarchicalRadialBasisFctMappingTest:: HierarchicalRadialBasisFctMappingTest()
+:
+  TestCase ( "precice::mapping::tests::HierarchicalRadialBasisFctMappingTest" )
+{}
+
+void HierarchicalRadialBasisFctMappingTest:: run()
+{
+  PRECICE_MASTER_ONLY {
+    testMethod(testHMatrix);
+    testMethod(testConsistent);
+    testMethod(testConservative);
+  }
+}
+
+void HierarchicalRadialBasisFctMappingTest:: testHMatrix()
+{
+  preciceTrace("testHMatrix()");
+  // Points on a wavy surface, columns are a subset shifted off the surface
+  int rows = 2000;
+  int cols = 1500;
+  Eigen::MatrixXd rowPoints(3, rows);
+  Eigen::MatrixXd colPoints(3, cols);
+  for (int i=0; i < rows; i++){
+    double x = std::fmod(0.618034 * i, 1.0);
+    double y = (double)i / rows;
+    rowPoints.col(i) << x, y, 0.1 * std::sin(6.0 * x) * std::cos(4.0 * y);
+  }
+  for (int i=0; i < cols; i++){
+    colPoints.col(i) = rowPoints.col(i) + Eigen::Vector3d(0.0, 0.0, 0.01);
+  }
+  Eigen::MatrixXd in(cols, 2);
+  for (int i=0; i < cols; i++){
+    in(i,0) = std::sin(0.1 * i);
+    in(i,1) = 1.0;
+  }
+  Eigen::MatrixXd inTransposed(rows, 1);
+  for (int i=0; i < rows; i++){
+    inTransposed(i,0) = std::cos(0.3 * i);
+  }
+
+  ThinPlateSplines function;
+  Eigen::MatrixXd dense(rows, cols);
+  for (int i=0; i < rows; i++){
+    for (int j=0; j < cols; j++){
+      dense(i,j) = function.evaluate((rowPoints.col(i) - colPoints.col(j)).norm());
+    }
+  }
+  Eigen::MatrixXd expected = dense * in;
+  Eigen::MatrixXd expectedTransposed = dense.transpose() * inTransposed;
+
+  for (int threads=1; threads <= 2; threads++){
+    HMatrix<ThinPlateSplines> matrix(rowPoints, colPoints, function, 1e-8, threads);
+    validateEquals(matrix.rows(), rows);
+    validateEquals(matrix.cols(), cols);
+    validate(matrix.storageSize() < (size_t)(3 * dense.size() / 4));
+
+    Eigen::MatrixXd out;
+    matrix.multiply(in, out);
+    double error = (out - expected).norm() / expected.norm();
+    validateWithParams1(error < 1e-6, error);
+
+    matrix.multiplyTransposed(inTransposed, out);
+    error = (out - expectedTransposed).norm() / expectedTransposed.norm();
+    validateWithParams1(error < 1e-6, error);
+  }
+}
+
+void HierarchicalRadialBasisFctMappingTest:: testConsistent()
+{
+  preciceTrace("testConsistent()");
+  using namespace mesh;
+  using utils::Vector2D;
+  int dimensions = 2;
+
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  PtrData inData = inMesh->createData("InData", 2);
+  for (int i=0; i < 25; i++){
+    for (int j=0; j < 25; j++){
+      inMesh->createVertex(Vector2D((i + 0.3 * std::sin(j)) / 24.0, (j + 0.3 * std::cos(i)) / 24.0));
+    }
+  }
+  inMesh->allocateDataValues();
+  for (const Vertex& vertex : inMesh->vertices()){
+    const utils::DynVector& coords = vertex.getCoords();
+    inData->values()(2*vertex.getID()) = std::sin(3.0 * coords[0]) + coords[1];
+    inData->values()(2*vertex.getID() + 1) = std::exp(coords[0] * coords[1]);
+  }
+
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  PtrData outData = outMesh->createData("OutData", 2);
+  PtrData expectedData = outMesh->createData("ExpectedData", 2);
+  for (int i=0; i < 17; i++){
+    for (int j=0; j < 13; j++){
+      outMesh->createVertex(Vector2D(0.02 + 0.96 * i / 16.0, 0.03 + 0.94 * j / 12.0));
+    }
+  }
+  outMesh->allocateDataValues();
+
+  RadialBasisFctMapping<ThinPlateSplines> denseMapping(Mapping::CONSISTENT, dimensions,
+      ThinPlateSplines(), false, false, false);
+  denseMapping.setMeshes(inMesh, outMesh);
+  denseMapping.computeMapping();
+  denseMapping.map(inData->getID(), expectedData->getID());
+
+  HierarchicalRadialBasisFctMapping<ThinPlateSplines> mapping(Mapping::CONSISTENT, dimensions,
+      ThinPlateSplines(), false, false, false, 1e-8, 1e-10);
+  mapping.setMeshes(inMesh, outMesh);
+  mapping.computeMapping();
+  validate(mapping.hasComputedMapping());
+  validate(mapping.storageSize() < (size_t)(625 * (625 + 221)));
+  // Second run starts from the solution of the first one
+  for (int run=0; run < 2; run++){
+    mapping.map(inData->getID(), outData->getID());
+    for (int i=0; i < outData->values().size(); i++){
+      validateWithParams3(tarch::la::equals(outData->values()(i), expectedData->values()(i), 1e-6),
+                          i, outData->values()(i), expectedData->values()(i));
+    }
+  }
+  mapping.clear();
+  validate(not mapping.hasComputedMapping());
+}
+
+void HierarchicalRadialBasisFctMappingTest:: testConservative()
+{
+  preciceTrace("testConservative()");
+  using namespace mesh;
+  using utils::Vector3D;
+  int dimensions = 3;
+
+  // Sphere surface like clouds of vertices, mapped to a coarser one
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  PtrData inData = inMesh->createData("InData", 1);
+  for (int i=0; i < 20; i++){
+    for (int j=0; j < 20; j++){
+      double theta = 0.15 + 2.8 * i / 19.0;
+      double phi = 6.0 * j / 20.0;
+      inMesh->createVertex(Vector3D(std::sin(theta) * std::cos(phi),
+                                    std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  inMesh->allocateDataValues();
+  for (int i=0; i < inData->values().size(); i++){
+    inData->values()(i) = 1.0 + 0.01 * i;
+  }
+
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  PtrData outData = outMesh->createData("OutData", 1);
+  PtrData expectedData = outMesh->createData("ExpectedData", 1);
+  for (int i=0; i < 12; i++){
+    for (int j=0; j < 15; j++){
+      double theta = 0.1 + 2.9 * i / 11.0;
+      double phi = 6.2 * j / 15.0;
+      outMesh->createVertex(Vector3D(std::sin(theta) * std::cos(phi),
+                                     std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  outMesh->allocateDataValues();
+
+  RadialBasisFctMapping<ThinPlateSplines> denseMapping(Mapping::CONSERVATIVE, dimensions,
+      ThinPlateSplines(), false, false, false);
+  denseMapping.setMeshes(inMesh, outMesh);
+  denseMapping.computeMapping();
+  denseMapping.map(inData->getID(), expectedData->getID());
+
+  HierarchicalRadialBasisFctMapping<ThinPlateSplines> mapping(Mapping::CONSERVATIVE, dimensions,
+      ThinPlateSplines(), false, false, false, 1e-8, 1e-12, 2);
+  mapping.setMeshes(inMesh, outMesh);
+  mapping.computeMapping();
+  mapping.map(inData->getID(), outData->getID());
+  // C is badly conditioned here, the iterative solution deviates more from the direct one
+  for (int i=0; i < outData->values().size(); i++){
+    validateWithParams3(tarch::la::equals(outData->values()(i), expectedData->values()(i), 1e-5),
+                        i, outData->values()(i), expectedData->values()(i));
+  }
+  double inSum = inData->values().sum();
+  double outSum = outData->values().sum();
+  validateWithParams2(tarch::la::equals(inSum, outSum, 1e-6), inSum, outSum);
+}
+
+}}} // namespace precice, mapping, tests
@@ -0,0 +1,64 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#ifndef PRECICE_MAPPING_HIERARCHICALRADIALBASISFCTMAPPINGTEST_HPP_
+#define PRECICE_MAPPING_HIERARCHICALRADIALBASISFCTMAPPINGTEST_HPP_
+
+#include "tarch/tests/TestCase.h"
+#include "tarch/logging/Log.h"
+
+namespace precice {
+namespace mapping {
+namespace tests {
+
+/**
+ * @brief Provides tests for class HierarchicalRadialBasisFctMapping.
+ */
+class HierarchicalRadialBasisFctMappingTest : public tarch::tests::TestCase
+{
+public:
+
+  /**
+   * @brief Constructor.
+   */
+  HierarchicalRadialBasisFctMappingTest();
+
+  /**
+   * @brief Destructor, empty.
+   */
+  virtual ~HierarchicalRadialBasisFctMappingTest() {}
+
+  /**
+   * @brief Prepares run of tests, empty.
+   */
+  virtual void setUp() {}
+
+  /**
+   * @brief Runs all tests.
+   */
+  virtual void run();
+
+private:
+
+  // @brief Logging device.
+  static tarch::logging::Log _log;
+
+  /**
+   * @brief Products with the hierarchical matrix match the dense kernel matrix.
+   */
+  void testHMatrix();
+
+  /**
+   * @brief Consistent mapping gives the same values as RadialBasisFctMapping.
+   */
+  void testConsistent();
+
+  /**
+   * @brief Conservative mapping gives the same values as RadialBasisFctMapping.
+   */
+  void testConservative();
+};
+
+}}} // namespace precice, mapping, tests
+
+#endif /* PRECICE_MAPPING_HIERARCHICALRADIALBASISFCTMAPPINGTEST_HPP_ */
@@ -3,11 +3,15 @@
 // use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
 #include "NearestNeighborMappingTest.hpp"
 #include "mapping/NearestNeighborMapping.hpp"
+#include "mapping/MappingCache.hpp"
 #include "mesh/Mesh.hpp"
 #include "mesh/Vertex.hpp"
 #include "mesh/Data.hpp"
 #include "utils/Parallel.hpp"
 #include "utils/Dimensions.hpp"
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <fstream>
 
 #include "tarch/tests/TestCaseFactory.h"
 registerTest(precice::mapping::tests::NearestNeighborMappingTest)
@@ -29,6 +33,10 @@ void NearestNeighborMappingTest:: run()
   PRECICE_MASTER_ONLY {
     testMethod(testConsistentNonIncremental);
     testMethod(testConservativeNonIncremental);
+    testMethod(testMultipleData);
+    testMethod(testCache);
+    testMethod(testCorruptedCache);
+    testMethod(testUpdateMapping);
   }
 }
 
@@ -192,4 +200,207 @@ void NearestNeighborMappingTest:: testConservativeNonIncremental()
   validateNumericalEquals(outValues(1), 0.0);
 }
 
+void NearestNeighborMappingTest:: testMultipleData()
+{
+  preciceTrace("testMultipleData()");
+  using namespace mesh;
+  using utils::Vector2D;
+  int dimensions = 2;
+
+  // Create mesh to map from
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  PtrData inDataScalar = inMesh->createData("InDataScalar", 1);
+  PtrData inDataVector = inMesh->createData("InDataVector", 2);
+  inMesh->createVertex(Vector2D(0.0));
+  inMesh->createVertex(Vector2D(0.9));
+  inMesh->createVertex(Vector2D(1.1));
+  inMesh->allocateDataValues();
+  inDataScalar->values() << 1.0, 2.0, 3.0;
+  inDataVector->values() << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+
+  // Create mesh to map to
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  PtrData outDataScalar = outMesh->createData("OutDataScalar", 1);
+  PtrData outDataVector = outMesh->createData("OutDataVector", 2);
+  outMesh->createVertex(Vector2D(0.0));
+  outMesh->createVertex(Vector2D(1.0));
+  outMesh->allocateDataValues();
+
+  // Map both data in one pass, the last two input vertices go to the second output vertex
+  NearestNeighborMapping mapping(Mapping::CONSERVATIVE, dimensions);
+  mapping.setMeshes(inMesh, outMesh);
+  mapping.computeMapping();
+  Mapping::DataPairs dataPairs;
+  dataPairs.push_back(std::make_pair(inDataScalar->getID(), outDataScalar->getID()));
+  dataPairs.push_back(std::make_pair(inDataVector->getID(), outDataVector->getID()));
+  mapping.map(dataPairs);
+  utils::DynVector expected(2);
+  expected = 1.0, 5.0;
+  validateWithParams2(tarch::la::equals(expected, utils::DynVector(outDataScalar->values())),
+                      expected, outDataScalar->values());
+  utils::DynVector expectedVector(4);
+  expectedVector = 1.0, 2.0, 8.0, 10.0;
+  validateWithParams2(tarch::la::equals(expectedVector, utils::DynVector(outDataVector->values())),
+                      expectedVector, outDataVector->values());
+}
+
+void NearestNeighborMappingTest:: testCache()
+{
+  preciceTrace("testCache()");
+  using namespace mesh;
+  using utils::Vector2D;
+  int dimensions = 2;
+  std::string directory("NearestNeighborMappingTest-cache");
+
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  PtrData inData = inMesh->createData("InData", 1);
+  inMesh->createVertex(Vector2D(0.0));
+  inMesh->createVertex(Vector2D(1.0));
+  inMesh->allocateDataValues();
+  inData->values() << 1.0, 2.0;
+
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  PtrData outData = outMesh->createData("OutData", 1);
+  Vertex& outVertex = outMesh->createVertex(Vector2D(0.8));
+  outMesh->createVertex(Vector2D(0.1));
+  outMesh->allocateDataValues();
+
+  MappingCache cache(directory, "nearest-neighbor");
+  {
+    NearestNeighborMapping mapping(Mapping::CONSISTENT, dimensions);
+    mapping.setMeshes(inMesh, outMesh);
+    validate(not cache.load(mapping));
+    mapping.computeMapping();
+    cache.store(mapping);
+    validate(boost::filesystem::exists(cache.getFileName(mapping)));
+  }
+
+  // Restore the mapping without computing it
+  NearestNeighborMapping mapping(Mapping::CONSISTENT, dimensions);
+  mapping.setMeshes(inMesh, outMesh);
+  validate(cache.load(mapping));
+  validate(mapping.hasComputedMapping());
+  mapping.map(inData->getID(), outData->getID());
+  validateNumericalEquals(outData->values()(0), 2.0);
+  validateNumericalEquals(outData->values()(1), 1.0);
+
+  // Moved vertices or another configuration do not match the cache file
+  MappingCache otherCache(directory, "nearest-neighbor-other");
+  NearestNeighborMapping otherMapping(Mapping::CONSISTENT, dimensions);
+  otherMapping.setMeshes(inMesh, outMesh);
+  validate(not otherCache.load(otherMapping));
+  outVertex.setCoords(Vector2D(0.2));
+  validate(not cache.load(otherMapping));
+  validate(not otherMapping.hasComputedMapping());
+
+  boost::filesystem::remove_all(directory);
+}
+
+void NearestNeighborMappingTest:: testCorruptedCache()
+{
+  preciceTrace("testCorruptedCache()");
+  using namespace mesh;
+  using utils::Vector2D;
+  int dimensions = 2;
+  std::string directory("NearestNeighborMappingTest-corrupted-cache");
+
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  inMesh->createVertex(Vector2D(0.0));
+  inMesh->createVertex(Vector2D(1.0));
+  inMesh->allocateDataValues();
+
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  outMesh->createVertex(Vector2D(0.8));
+  outMesh->createVertex(Vector2D(0.1));
+  outMesh->allocateDataValues();
+
+  MappingCache cache(directory, "nearest-neighbor");
+  NearestNeighborMapping mapping(Mapping::CONSISTENT, dimensions);
+  mapping.setMeshes(inMesh, outMesh);
+  mapping.computeMapping();
+  cache.store(mapping);
+  std::string fileName = cache.getFileName(mapping);
+  boost::uintmax_t fileSize = boost::filesystem::file_size(fileName);
+
+  // A column index out of range, the file ends with 2 indices and 2 values
+  {
+    std::fstream file(fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    int column = 2;
+    file.seekp(fileSize - 2 * sizeof(double) - 2 * sizeof(int));
+    file.write(reinterpret_cast<const char*>(&column), sizeof(column));
+  }
+  NearestNeighborMapping invalidMapping(Mapping::CONSISTENT, dimensions);
+  invalidMapping.setMeshes(inMesh, outMesh);
+  validate(not cache.load(invalidMapping));
+  validate(not invalidMapping.hasComputedMapping());
+
+  // A truncated file
+  cache.store(mapping);
+  boost::filesystem::resize_file(fileName, fileSize - sizeof(double));
+  NearestNeighborMapping truncatedMapping(Mapping::CONSISTENT, dimensions);
+  truncatedMapping.setMeshes(inMesh, outMesh);
+  validate(not cache.load(truncatedMapping));
+  validate(not truncatedMapping.hasComputedMapping());
+
+  boost::filesystem::remove_all(directory);
+}
+
+void NearestNeighborMappingTest:: testUpdateMapping()
+{
+  preciceTrace("testUpdateMapping()");
+  using namespace mesh;
+  using utils::Vector2D;
+  int dimensions = 2;
+
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  PtrData inData = inMesh->createData("InData", 1);
+  for (int i=0; i < 100; i++){
+    inMesh->createVertex(Vector2D(std::fmod(0.618034 * i, 1.0), i / 100.0));
+  }
+  inMesh->allocateDataValues();
+  for (int i=0; i < inData->values().size(); i++){
+    inData->values()(i) = i;
+  }
+
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  PtrData outData = outMesh->createData("OutData", 1);
+  PtrData expectedData = outMesh->createData("ExpectedData", 1);
+  for (int i=0; i < 60; i++){
+    outMesh->createVertex(Vector2D(std::fmod(0.414214 * i, 1.0), i / 60.0));
+  }
+  outMesh->allocateDataValues();
+
+  for (int constraint=0; constraint < 2; constraint++){
+    Mapping::Constraint type = constraint == 0 ? Mapping::CONSISTENT : Mapping::CONSERVATIVE;
+    NearestNeighborMapping mapping(type, dimensions);
+    mapping.setMeshes(inMesh, outMesh);
+    mapping.computeMapping();
+    for (int step=1; step <= 3; step++){
+      // Move some vertices of both meshes and compare against a full computation
+      for (int i=step; i < 100; i+=7){
+        Vertex& vertex = inMesh->vertices()[i];
+        vertex.setCoords(Vector2D(vertex.getCoords()[0] + 0.05 * std::sin(i + step),
+                                  vertex.getCoords()[1] + 0.05 * std::cos(i * step)));
+      }
+      for (int i=step; i < 60; i+=11){
+        Vertex& vertex = outMesh->vertices()[i];
+        vertex.setCoords(Vector2D(vertex.getCoords()[1], vertex.getCoords()[0]));
+      }
+      mapping.updateMapping();
+      validate(mapping.hasComputedMapping());
+      NearestNeighborMapping expectedMapping(type, dimensions);
+      expectedMapping.setMeshes(inMesh, outMesh);
+      expectedMapping.computeMapping();
+      outData->values().setZero();
+      expectedData->values().setZero();
+      mapping.map(inData->getID(), outData->getID());
+      expectedMapping.map(inData->getID(), expectedData->getID());
+      for (int i=0; i < outData->values().size(); i++){
+        validateWithParams3(tarch::la::equals(outData->values()(i), expectedData->values()(i)),
+                            i, outData->values()(i), expectedData->values()(i));
+      }
+    }
+  }
+}
+
 }}} // namespace precice, mapping, tests
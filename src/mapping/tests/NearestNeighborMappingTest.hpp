@@ -46,6 +46,14 @@ private:
   void testConsistentNonIncremental();
 
   void testConservativeNonIncremental();
+
+  void testMultipleData();
+
+  void testCache();
+
+  void testCorruptedCache();
+
+  void testUpdateMapping();
 };
 
 }}} // namespace precice, mapping, tests
@@ -0,0 +1,130 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#include "PartitionOfUnityMappingTest.hpp"
+#include "mapping/PartitionOfUnityMapping.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Data.hpp"
+#include "mesh/Vertex.hpp"
+#include "utils/Globals.hpp"
+#include "utils/Parallel.hpp"
+#include "tarch/la/ScalarOperations.h"
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(precice::mapping::tests::PartitionOfUnityMappingTest)
+
+namespace precice {
+namespace mapping {
+namespace tests {
+
+tarch::logging::Log PartitionOfUnityMappingTest::
+  _log ( "precice::mapping::tests::PartitionOfUnityMappingTest" );
+
+PartitionOfUnityMappingTest:: PartitionOfUnityMappingTest()
+:
+  TestCase ( "precice::mapping::tests::PartitionOfUnityMappingTest" )
+{}
+
+void PartitionOfUnityMappingTest:: run()
+{
+  PRECICE_MASTER_ONLY {
+    testMethod(testConsistentLinear);
+    testMethod(testConservative);
+  }
+}
+
+void PartitionOfUnityMappingTest:: testConsistentLinear()
+{
+  preciceTrace("testConsistentLinear()");
+  using namespace mesh;
+  using utils::Vector2D;
+  int dimensions = 2;
+
+  // Input grid with 144 vertices, split into several patches
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  PtrData inData = inMesh->createData("InData", 1);
+  for (int i=0; i < 12; i++){
+    for (int j=0; j < 12; j++){
+      inMesh->createVertex(Vector2D((double)i / 11.0, (double)j / 11.0));
+    }
+  }
+  inMesh->allocateDataValues();
+  for (const Vertex& vertex : inMesh->vertices()){
+    const utils::DynVector& coords = vertex.getCoords();
+    inData->values()(vertex.getID()) = 1.0 + 2.0 * coords[0] - 3.0 * coords[1];
+  }
+
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  PtrData outData = outMesh->createData("OutData", 1);
+  for (int i=0; i < 7; i++){
+    for (int j=0; j < 5; j++){
+      outMesh->createVertex(Vector2D(0.05 + 0.9 * i / 6.0, 0.1 + 0.8 * j / 4.0));
+    }
+  }
+  outMesh->allocateDataValues();
+
+  for (int threads=1; threads <= 2; threads++){
+    PartitionOfUnityMapping<ThinPlateSplines> mapping(Mapping::CONSISTENT, dimensions,
+        ThinPlateSplines(), 20, 0.3, threads);
+    mapping.setMeshes(inMesh, outMesh);
+    mapping.computeMapping();
+    validate(mapping.hasComputedMapping());
+    mapping.map(inData->getID(), outData->getID());
+    for (const Vertex& vertex : outMesh->vertices()){
+      const utils::DynVector& coords = vertex.getCoords();
+      double expected = 1.0 + 2.0 * coords[0] - 3.0 * coords[1];
+      validateWithParams2(tarch::la::equals(outData->values()(vertex.getID()), expected, 1e-8),
+                          outData->values()(vertex.getID()), expected);
+    }
+    mapping.clear();
+    validate(not mapping.hasComputedMapping());
+  }
+}
+
+void PartitionOfUnityMappingTest:: testConservative()
+{
+  preciceTrace("testConservative()");
+  using namespace mesh;
+  using utils::Vector3D;
+  int dimensions = 3;
+
+  // Sphere surface like cloud of vertices, mapped to a coarser one
+  PtrMesh inMesh(new Mesh("InMesh", dimensions, false));
+  PtrData inData = inMesh->createData("InData", 1);
+  for (int i=0; i < 10; i++){
+    for (int j=0; j < 10; j++){
+      double theta = 0.1 + 2.9 * i / 9.0;
+      double phi = 6.2 * j / 10.0;
+      inMesh->createVertex(Vector3D(std::sin(theta) * std::cos(phi),
+                                    std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  inMesh->allocateDataValues();
+  double inSum = 0.0;
+  for (int i=0; i < inData->values().size(); i++){
+    inData->values()(i) = 1.0 + 0.01 * i;
+    inSum += inData->values()(i);
+  }
+
+  PtrMesh outMesh(new Mesh("OutMesh", dimensions, false));
+  PtrData outData = outMesh->createData("OutData", 1);
+  for (int i=0; i < 8; i++){
+    for (int j=0; j < 8; j++){
+      double theta = 0.15 + 2.8 * i / 7.0;
+      double phi = 6.0 * j / 8.0;
+      outMesh->createVertex(Vector3D(std::sin(theta) * std::cos(phi),
+                                     std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  outMesh->allocateDataValues();
+
+  PartitionOfUnityMapping<Multiquadrics> mapping(Mapping::CONSERVATIVE, dimensions,
+      Multiquadrics(0.5), 16, 0.5);
+  mapping.setMeshes(inMesh, outMesh);
+  mapping.computeMapping();
+  mapping.map(inData->getID(), outData->getID());
+  double outSum = outData->values().sum();
+  validateWithParams2(tarch::la::equals(inSum, outSum, 1e-8), inSum, outSum);
+}
+
+}}} // namespace precice, mapping, tests
@@ -0,0 +1,59 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#ifndef PRECICE_MAPPING_PARTITIONOFUNITYMAPPINGTEST_HPP_
+#define PRECICE_MAPPING_PARTITIONOFUNITYMAPPINGTEST_HPP_
+
+#include "tarch/tests/TestCase.h"
+#include "tarch/logging/Log.h"
+
+namespace precice {
+namespace mapping {
+namespace tests {
+
+/**
+ * @brief Provides tests for class PartitionOfUnityMapping.
+ */
+class PartitionOfUnityMappingTest : public tarch::tests::TestCase
+{
+public:
+
+  /**
+   * @brief Constructor.
+   */
+  PartitionOfUnityMappingTest();
+
+  /**
+   * @brief Destructor, empty.
+   */
+  virtual ~PartitionOfUnityMappingTest() {}
+
+  /**
+   * @brief Prepares run of tests, empty.
+   */
+  virtual void setUp() {}
+
+  /**
+   * @brief Runs all tests.
+   */
+  virtual void run();
+
+private:
+
+  // @brief Logging device.
+  static tarch::logging::Log _log;
+
+  /**
+   * @brief Linear functions are reproduced exactly by the blended patches.
+   */
+  void testConsistentLinear();
+
+  /**
+   * @brief The sum of the mapped values is preserved.
+   */
+  void testConservative();
+};
+
+}}} // namespace precice, mapping, tests
+
+#endif /* PRECICE_MAPPING_PARTITIONOFUNITYMAPPINGTEST_HPP_ */
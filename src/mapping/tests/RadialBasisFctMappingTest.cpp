@@ -9,6 +9,7 @@
 #include "utils/Globals.hpp"
 #include "utils/Parallel.hpp"
 #include "tarch/la/ScalarOperations.h"
+#include <cmath>
 
 #include "tarch/tests/TestCaseFactory.h"
 registerTest(precice::mapping::tests::RadialBasisFctMappingTest)
@@ -37,6 +38,9 @@ void RadialBasisFctMappingTest:: run()
   testMethod(testCompactPolynomialC6);
   testMethod(testDeadAxis2D);
   testMethod(testDeadAxis3D);
+  testMethod(testMultithreaded);
+  testMethod(testMultipleData);
+  testMethod(testSinglePrecision);
 }
 
 void RadialBasisFctMappingTest:: testThinPlateSplines()
@@ -662,4 +666,132 @@ void RadialBasisFctMappingTest:: testDeadAxis3D
   validateNumericalEquals ( outData->values()[3], 4.3 );
 }
 
+void RadialBasisFctMappingTest:: testMultithreaded()
+{
+  preciceTrace ( "testMultithreaded" );
+  bool xDead = false;
+  bool yDead = false;
+  bool zDead = false;
+  int threads = 3;
+  ThinPlateSplines fct;
+  RadialBasisFctMapping<ThinPlateSplines> consistentMap2D(Mapping::CONSISTENT, 2, fct, xDead, yDead, zDead, threads);
+  perform2DTestConsistentMapping(consistentMap2D);
+  RadialBasisFctMapping<ThinPlateSplines> conservativeMap3D(Mapping::CONSERVATIVE, 3, fct, xDead, yDead, zDead, threads);
+  perform3DTestConservativeMapping(conservativeMap3D);
+  CompactPolynomialC6 compactFct(1.2);
+  RadialBasisFctMapping<CompactPolynomialC6> consistentMap3D(Mapping::CONSISTENT, 3, compactFct, xDead, yDead, zDead, threads);
+  perform3DTestConsistentMapping(consistentMap3D);
+  RadialBasisFctMapping<CompactPolynomialC6> conservativeMap2D(Mapping::CONSERVATIVE, 2, compactFct, xDead, yDead, zDead, threads);
+  perform2DTestConservativeMapping(conservativeMap2D);
+}
+
+void RadialBasisFctMappingTest:: testMultipleData()
+{
+  preciceTrace ( "testMultipleData" );
+  ThinPlateSplines fct;
+  RadialBasisFctMapping<ThinPlateSplines> denseMap(Mapping::CONSISTENT, 2, fct, false, false, false);
+  performTestMultipleData(denseMap);
+  CompactPolynomialC6 compactFct(1.5);
+  RadialBasisFctMapping<CompactPolynomialC6> sparseMap(Mapping::CONSISTENT, 2, compactFct, false, false, false);
+  performTestMultipleData(sparseMap);
+}
+
+void RadialBasisFctMappingTest:: performTestMultipleData
+(
+  Mapping& mapping )
+{
+  preciceTrace ( "performTestMultipleData()" );
+  int dimensions = 2;
+  using utils::Vector2D;
+
+  mesh::PtrMesh inMesh ( new mesh::Mesh("InMesh", dimensions, false) );
+  mesh::PtrData inDataScalar = inMesh->createData ( "InDataScalar", 1 );
+  mesh::PtrData inDataVector = inMesh->createData ( "InDataVector", 2 );
+  inMesh->createVertex ( Vector2D(0.0, 0.0) );
+  inMesh->createVertex ( Vector2D(1.0, 0.0) );
+  inMesh->createVertex ( Vector2D(1.0, 1.0) );
+  inMesh->createVertex ( Vector2D(0.0, 1.0) );
+  inMesh->allocateDataValues ();
+  inDataScalar->values() << 1.0, 2.0, 2.0, 1.0;
+  inDataVector->values() << 1.0, 10.0, 2.0, 20.0, 2.0, 20.0, 1.0, 10.0;
+
+  mesh::PtrMesh outMesh ( new mesh::Mesh("OutMesh", dimensions, false) );
+  mesh::PtrData outDataScalar = outMesh->createData ( "OutDataScalar", 1 );
+  mesh::PtrData outDataVector = outMesh->createData ( "OutDataVector", 2 );
+  outMesh->createVertex ( Vector2D(0.0, 0.5) );
+  outMesh->createVertex ( Vector2D(1.0, 0.5) );
+  outMesh->allocateDataValues();
+
+  mapping.setMeshes ( inMesh, outMesh );
+  mapping.computeMapping ();
+  Mapping::DataPairs dataPairs;
+  dataPairs.push_back ( std::make_pair(inDataScalar->getID(), outDataScalar->getID()) );
+  dataPairs.push_back ( std::make_pair(inDataVector->getID(), outDataVector->getID()) );
+  mapping.map ( dataPairs );
+  validateNumericalEquals ( outDataScalar->values()[0], 1.0 );
+  validateNumericalEquals ( outDataScalar->values()[1], 2.0 );
+  validateNumericalEquals ( outDataVector->values()[0], 1.0 );
+  validateNumericalEquals ( outDataVector->values()[1], 10.0 );
+  validateNumericalEquals ( outDataVector->values()[2], 2.0 );
+  validateNumericalEquals ( outDataVector->values()[3], 20.0 );
+}
+
+void RadialBasisFctMappingTest:: testSinglePrecision()
+{
+  preciceTrace ( "testSinglePrecision()" );
+  int dimensions = 3;
+  using utils::Vector3D;
+
+  mesh::PtrMesh inMesh ( new mesh::Mesh("InMesh", dimensions, false) );
+  mesh::PtrData inData = inMesh->createData ( "InData", 1 );
+  for (int i=0; i < 10; i++){
+    for (int j=0; j < 10; j++){
+      inMesh->createVertex ( Vector3D(i / 9.0, j / 9.0, 0.1 * std::sin(i + j)) );
+    }
+  }
+  inMesh->allocateDataValues ();
+  for (int i=0; i < inData->values().size(); i++){
+    inData->values()[i] = 1.0 + std::cos(0.3 * i);
+  }
+
+  mesh::PtrMesh outMesh ( new mesh::Mesh("OutMesh", dimensions, false) );
+  mesh::PtrData outData = outMesh->createData ( "OutData", 1 );
+  for (int i=0; i < 7; i++){
+    for (int j=0; j < 6; j++){
+      outMesh->createVertex ( Vector3D(0.05 + 0.9 * i / 6.0, 0.1 + 0.8 * j / 5.0, 0.0) );
+    }
+  }
+  outMesh->allocateDataValues ();
+
+  ThinPlateSplines fct;
+  for (Mapping::Constraint constraint : {Mapping::CONSISTENT, Mapping::CONSERVATIVE}){
+    mesh::PtrMesh from = constraint == Mapping::CONSISTENT ? inMesh : outMesh;
+    mesh::PtrMesh to = constraint == Mapping::CONSISTENT ? outMesh : inMesh;
+    mesh::PtrData fromData = constraint == Mapping::CONSISTENT ? inData : outData;
+    mesh::PtrData toData = constraint == Mapping::CONSISTENT ? outData : inData;
+    if (constraint == Mapping::CONSERVATIVE){
+      for (int i=0; i < outData->values().size(); i++){
+        outData->values()[i] = 1.0 + 0.1 * i;
+      }
+    }
+    RadialBasisFctMapping<ThinPlateSplines> doubleMap(constraint, dimensions, fct,
+                                                      false, false, false, 2);
+    doubleMap.setMeshes ( from, to );
+    doubleMap.computeMapping ();
+    doubleMap.map ( fromData->getID(), toData->getID() );
+    Eigen::VectorXd expected = toData->values();
+
+    RadialBasisFctMapping<ThinPlateSplines> floatMap(constraint, dimensions, fct,
+                                                     false, false, false, 2, true);
+    floatMap.setMeshes ( from, to );
+    floatMap.computeMapping ();
+    floatMap.map ( fromData->getID(), toData->getID() );
+    // Rounding errors of A are amplified by the cancellation of large coefficients
+    for (int i=0; i < expected.size(); i++){
+      validateWithParams3 ( tarch::la::equals(toData->values()[i], expected[i], 1e-4),
+                            i, toData->values()[i], expected[i] );
+    }
+  }
+}
+
 }}} // namespace precice, mapping, tests
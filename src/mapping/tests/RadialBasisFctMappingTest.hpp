@@ -96,6 +96,23 @@ private:
    * @brief
    */
   void testDeadAxis3D ();
+
+  /**
+   * @brief Runs dense and sparse mappings with more than one thread.
+   */
+  void testMultithreaded ();
+
+  /**
+   * @brief Maps scalar and vector data at once, with dense and sparse matrices.
+   */
+  void testMultipleData ();
+
+  void performTestMultipleData ( Mapping& mapping );
+
+  /**
+   * @brief Compares mappings with single and double precision evaluation matrices.
+   */
+  void testSinglePrecision ();
 };
 
 }}} // namespace precice, mapping, tests
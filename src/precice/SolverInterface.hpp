@@ -147,6 +147,34 @@ public:
    */
   double advance ( double computedTimestepLength );
 
+  /**
+   * @brief Starts to advance preCICE, completed by finishAdvance().
+   *
+   * Equivalent to advance(), if finishAdvance() is called right afterwards.
+   * Coupling schemes which support it post the data exchange, such that the
+   * solver can do independent work while the data is in flight.
+   *
+   * Preconditions:
+   * - Same as for advance().
+   *
+   * Postconditions:
+   * - Written data must not be changed and read data must not be accessed
+   *   before finishAdvance() is called.
+   *
+   * @param computedTimestepLength [IN] Length of timestep computed by solver.
+   */
+  void startAdvance ( double computedTimestepLength );
+
+  /**
+   * @brief Completes advancing preCICE started by startAdvance().
+   *
+   * Postconditions:
+   * - Same as for advance().
+   *
+   * @return Maximum length of next timestep to be computed by solver.
+   */
+  double finishAdvance();
+
   /**
    * @brief Finalizes preCICE.
    *
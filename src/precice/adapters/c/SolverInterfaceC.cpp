@@ -39,6 +39,18 @@ double precicec_advance( double computedTimestepLength )
   return impl->advance ( computedTimestepLength );
 }
 
+void precicec_startAdvance( double computedTimestepLength )
+{
+  assertion ( impl != nullptr );
+  impl->startAdvance ( computedTimestepLength );
+}
+
+double precicec_finishAdvance()
+{
+  assertion ( impl != nullptr );
+  return impl->finishAdvance ();
+}
+
 void precicec_finalize()
 {
   assertion ( impl != nullptr );
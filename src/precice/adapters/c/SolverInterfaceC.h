@@ -38,6 +38,20 @@ double precicec_initialize();
  */
 double precicec_advance ( double computedTimestepLength );
 
+/**
+ * @brief Starts to exchange data, completed by precicec_finishAdvance().
+ *
+ * @param computedTimestepLength [IN] Length of timestep computed by solver.
+ */
+void precicec_startAdvance ( double computedTimestepLength );
+
+/**
+ * @brief Completes the data exchange started by precicec_startAdvance().
+ *
+ * @return Maximal length of next timestep to be computed by solver.
+ */
+double precicec_finishAdvance();
+
 /**
  * @brief Finalizes the coupling to the coupling supervisor.
  */
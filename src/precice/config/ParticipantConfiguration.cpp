@@ -656,6 +656,7 @@ void ParticipantConfiguration:: finishParticipantConfiguration
     mappingContext->fromMeshID = fromMeshID;
     mappingContext->toMeshID = toMeshID;
     mappingContext->timing = confMapping.timing;
+    mappingContext->cache = confMapping.cache;
 
     mapping::PtrMapping& map = mappingContext->mapping;
     assertion(map.get() == nullptr);
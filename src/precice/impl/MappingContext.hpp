@@ -28,6 +28,9 @@ struct MappingContext
   // @brief Time of execution of mapping.
   mapping::MappingConfiguration::Timing timing;
 
+  // @brief Stores and restores the computed mapping, empty if not configured.
+  mapping::PtrMappingCache cache;
+
   // @brief True, if computation and mapping is done repeatedly for single values.
   //bool isIncremental;
 
@@ -42,6 +45,7 @@ struct MappingContext
     fromMeshID(-1),
     toMeshID(-1),
     timing(mapping::MappingConfiguration::INITIAL),
+    cache(),
     //isIncremental(false),
     hasMappedData(false)
   {}
@@ -41,6 +41,7 @@
 #include "m2n/PointToPointCommunication.hpp"
 #include "geometry/config/GeometryConfiguration.hpp"
 #include "geometry/Geometry.hpp"
+#include "mapping/MappingCache.hpp"
 #include "geometry/ImportGeometry.hpp"
 #include "geometry/CommunicatedGeometry.hpp"
 #include "geometry/impl/Decomposition.hpp"
@@ -101,6 +102,8 @@ SolverInterfaceImpl:: SolverInterfaceImpl
   _checkpointTimestepInterval(-1),
   _checkpointFileName("precice_checkpoint_" + _accessorName),
   _numberAdvanceCalls(0),
+  _isAdvanceStarted(false),
+  _advanceState(),
   _requestManager(nullptr)
 {
   preciceCheck(_accessorProcessRank >= 0, "SolverInterfaceImpl()",
@@ -462,21 +465,32 @@ double SolverInterfaceImpl:: advance
   double computedTimestepLength )
 {
   preciceTrace1("advance()", computedTimestepLength);
-
   Event e("advance");
+  startAdvance(computedTimestepLength);
+  return finishAdvance();
+}
+
+void SolverInterfaceImpl:: startAdvance
+(
+  double computedTimestepLength )
+{
+  preciceTrace1("startAdvance()", computedTimestepLength);
+
+  Event e("startAdvance");
 
   m2n::PointToPointCommunication::ScopedSetEventNamePrefix ssenp(
       "advance"
       "/");
 
-  preciceCheck(_couplingScheme->isInitialized(), "advance()",
+  preciceCheck(_couplingScheme->isInitialized(), "startAdvance()",
                "initialize() has to be called before advance()");
+  preciceCheck(not _isAdvanceStarted, "startAdvance()",
+               "finishAdvance() has to be called before advancing again");
+  _isAdvanceStarted = true;
+  _advanceState.computedTimestepLength = computedTimestepLength;
   _numberAdvanceCalls++;
   preciceInfo("advance()", "Iteration #" << _numberAdvanceCalls);
-  if (_clientMode){
-    _requestManager->requestAdvance(computedTimestepLength);
-  }
-  else {
+  if (not _clientMode){
 #   ifdef Debug
     if(utils::MasterSlave::_masterMode || utils::MasterSlave::_slaveMode){
       Event e("advance/syncTimestep", not precice::testMode);
@@ -508,6 +522,9 @@ double SolverInterfaceImpl:: advance
       timestepPart = timestepLength - _couplingScheme->getThisTimestepRemainder();
     }
     time = _couplingScheme->getTime();
+    _advanceState.timestepLength = timestepLength;
+    _advanceState.timestepPart = timestepPart;
+    _advanceState.time = time;
 
 
     mapWrittenData();
@@ -520,10 +537,32 @@ double SolverInterfaceImpl:: advance
     }
     performDataActions(timings, time, computedTimestepLength, timestepPart, timestepLength);
 
-    preciceDebug("Advancing coupling scheme");
-    _couplingScheme->advance();
+    preciceDebug("Start advancing coupling scheme");
+    _couplingScheme->startAdvance();
+  }
+}
+
+double SolverInterfaceImpl:: finishAdvance()
+{
+  preciceTrace("finishAdvance()");
+
+  Event e("finishAdvance");
+
+  m2n::PointToPointCommunication::ScopedSetEventNamePrefix ssenp(
+      "advance"
+      "/");
 
-    timings.clear();
+  preciceCheck(_isAdvanceStarted, "finishAdvance()",
+               "startAdvance() has to be called before finishAdvance()");
+  _isAdvanceStarted = false;
+  if (_clientMode){
+    _requestManager->requestAdvance(_advanceState.computedTimestepLength);
+  }
+  else {
+    preciceDebug("Finish advancing coupling scheme");
+    _couplingScheme->finishAdvance();
+
+    std::set<action::Action::Timing> timings;
     timings.insert(action::Action::ALWAYS_POST);
     if (_couplingScheme->hasDataBeenExchanged()){
       timings.insert(action::Action::ON_EXCHANGE_POST);
@@ -531,7 +570,8 @@ double SolverInterfaceImpl:: advance
     if (_couplingScheme->isCouplingTimestepComplete()){
       timings.insert(action::Action::ON_TIMESTEP_COMPLETE_POST);
     }
-    performDataActions(timings, time, computedTimestepLength, timestepPart, timestepLength);
+    performDataActions(timings, _advanceState.time, _advanceState.computedTimestepLength,
+                       _advanceState.timestepPart, _advanceState.timestepLength);
 
     mapReadData();
 
@@ -1498,10 +1538,11 @@ void SolverInterfaceImpl:: mapWriteDataFrom
                    << "\", there is no mapping defined");
     return;
   }
-  if (not mappingContext.mapping->hasComputedMapping()){
+  if ((not mappingContext.mapping->hasComputedMapping()) || mappingContext.mapping->isOutdated()){
     preciceDebug("Compute mapping from mesh \"" << context.mesh->getName() << "\"");
-    mappingContext.mapping->computeMapping();
+    computeMapping(mappingContext);
   }
+  mapping::Mapping::DataPairs dataPairs;
   for (impl::DataContext& context : _accessor->writeDataContexts()) {
     if (context.mesh->getID() == fromMeshID){
       int inDataID = context.fromData->getID();
@@ -1511,9 +1552,21 @@ void SolverInterfaceImpl:: mapWriteDataFrom
       preciceDebug("Map data \"" << context.fromData->getName()
                    << "\" from mesh \"" << context.mesh->getName() << "\"");
       assertion(mappingContext.mapping==context.mappingContext.mapping);
-      mappingContext.mapping->map(inDataID, outDataID);
+      dataPairs.push_back(std::make_pair(inDataID, outDataID));
+    }
+  }
+  mappingContext.mapping->map(dataPairs);
+#     ifdef Debug
+  for (const mapping::Mapping::DataPairs::value_type& pair : dataPairs){
+    const Eigen::VectorXd& values =
+        mappingContext.mapping->getOutputMesh()->data(pair.second)->values();
+    std::ostringstream stream;
+    for (int i=0; (i < values.size()) && (i < 10); i++){
+      stream << values[i] << " ";
     }
+    preciceDebug("First mapped values = " << stream.str());
   }
+#     endif
   mappingContext.hasMappedData = true;
 }
 
@@ -1534,10 +1587,11 @@ void SolverInterfaceImpl:: mapReadDataTo
                    << "\", there is no mapping defined!");
     return;
   }
-  if (not mappingContext.mapping->hasComputedMapping()){
+  if ((not mappingContext.mapping->hasComputedMapping()) || mappingContext.mapping->isOutdated()){
     preciceDebug("Compute mapping from mesh \"" << context.mesh->getName() << "\"");
-    mappingContext.mapping->computeMapping();
+    computeMapping(mappingContext);
   }
+  mapping::Mapping::DataPairs dataPairs;
   for (impl::DataContext& context : _accessor->readDataContexts()) {
     if (context.mesh->getID() == toMeshID){
       int inDataID = context.fromData->getID();
@@ -1547,17 +1601,21 @@ void SolverInterfaceImpl:: mapReadDataTo
       preciceDebug("Map data \"" << context.fromData->getName()
                    << "\" to mesh \"" << context.mesh->getName() << "\"");
       assertion(mappingContext.mapping==context.mappingContext.mapping);
-      mappingContext.mapping->map(inDataID, outDataID);
+      dataPairs.push_back(std::make_pair(inDataID, outDataID));
+    }
+  }
+  mappingContext.mapping->map(dataPairs);
 #     ifdef Debug
-      int max = context.toData->values().size();
-      std::ostringstream stream;
-      for (int i=0; (i < max) && (i < 10); i++){
-        stream << context.toData->values()[i] << " ";
-      }
-      preciceDebug("First mapped values = " << stream.str());
-#     endif
+  for (const mapping::Mapping::DataPairs::value_type& pair : dataPairs){
+    const Eigen::VectorXd& values =
+        mappingContext.mapping->getOutputMesh()->data(pair.second)->values();
+    std::ostringstream stream;
+    for (int i=0; (i < values.size()) && (i < 10); i++){
+      stream << values[i] << " ";
     }
+    preciceDebug("First mapped values = " << stream.str());
   }
+#     endif
   mappingContext.hasMappedData = true;
 }
 
@@ -2051,6 +2109,27 @@ void SolverInterfaceImpl:: createGeometry
   }
 }
 
+void SolverInterfaceImpl:: computeMapping
+(
+  impl::MappingContext& mappingContext )
+{
+  preciceTrace("computeMapping()");
+  if (mappingContext.mapping->isOutdated() && mappingContext.mapping->hasComputedMapping()){
+    mappingContext.mapping->updateMapping();
+    mappingContext.mapping->setIsOutdated(false);
+    return;
+  }
+  mappingContext.mapping->setIsOutdated(false);
+  const mapping::PtrMappingCache& cache = mappingContext.cache;
+  if ((cache.get() != nullptr) && cache->load(*mappingContext.mapping)){
+    return;
+  }
+  mappingContext.mapping->computeMapping();
+  if (cache.get() != nullptr){
+    cache->store(*mappingContext.mapping);
+  }
+}
+
 void SolverInterfaceImpl:: mapWrittenData()
 {
   preciceTrace("mapWrittenData()");
@@ -2062,50 +2141,62 @@ void SolverInterfaceImpl:: mapWrittenData()
     bool rightTime = timing == MappingConfiguration::ON_ADVANCE;
     rightTime |= timing == MappingConfiguration::INITIAL;
     bool hasComputed = context.mapping->hasComputedMapping();
-    if (rightTime && not hasComputed){
+    if (rightTime && ((not hasComputed) || context.mapping->isOutdated())){
       preciceInfo("mapWrittenData()","Compute write mapping from mesh \""
           << _accessor->meshContext(context.fromMeshID).mesh->getName()
           << "\" to mesh \""
           << _accessor->meshContext(context.toMeshID).mesh->getName()
           << "\".");
 
-      context.mapping->computeMapping();
+      computeMapping(context);
     }
   }
 
-  // Map data
-  for (impl::DataContext& context : _accessor->writeDataContexts()) {
-    timing = context.mappingContext.timing;
-    bool hasMapping = context.mappingContext.mapping.get() != nullptr;
-    bool rightTime = timing == MappingConfiguration::ON_ADVANCE;
-    rightTime |= timing == MappingConfiguration::INITIAL;
-    bool hasMapped = context.mappingContext.hasMappedData;
-    if (hasMapping && rightTime && (not hasMapped)){
-      int inDataID = context.fromData->getID();
-      int outDataID = context.toData->getID();
-      preciceDebug("Map data \"" << context.fromData->getName()
-                   << "\" from mesh \"" << context.mesh->getName() << "\"");
-      context.toData->values() = Eigen::VectorXd::Zero(context.toData->values().size());
-      //assign(context.toData->values()) = 0.0;
-      preciceDebug("Map from dataID " << inDataID << " to dataID: " << outDataID);
-      context.mappingContext.mapping->map(inDataID, outDataID);
+  // Map data, all data of one mapping at once
+  for (impl::MappingContext& mappingContext : _accessor->writeMappingContexts()) {
+    mapping::Mapping::DataPairs dataPairs;
+    for (impl::DataContext& context : _accessor->writeDataContexts()) {
+      if (context.mappingContext.mapping != mappingContext.mapping){
+        continue;
+      }
+      timing = context.mappingContext.timing;
+      bool rightTime = timing == MappingConfiguration::ON_ADVANCE;
+      rightTime |= timing == MappingConfiguration::INITIAL;
+      bool hasMapped = context.mappingContext.hasMappedData;
+      if (rightTime && (not hasMapped)){
+        int inDataID = context.fromData->getID();
+        int outDataID = context.toData->getID();
+        preciceDebug("Map data \"" << context.fromData->getName()
+                     << "\" from mesh \"" << context.mesh->getName() << "\"");
+        context.toData->values() = Eigen::VectorXd::Zero(context.toData->values().size());
+        //assign(context.toData->values()) = 0.0;
+        preciceDebug("Map from dataID " << inDataID << " to dataID: " << outDataID);
+        dataPairs.push_back(std::make_pair(inDataID, outDataID));
+      }
+    }
+    if (not dataPairs.empty()){
+      mappingContext.mapping->map(dataPairs);
 #     ifdef Debug
-      int max = context.toData->values().size();
-      std::ostringstream stream;
-      for (int i=0; (i < max) && (i < 10); i++){
-        stream << context.toData->values()[i] << " ";
+      for (const mapping::Mapping::DataPairs::value_type& pair : dataPairs){
+        const Eigen::VectorXd& values =
+            mappingContext.mapping->getOutputMesh()->data(pair.second)->values();
+        std::ostringstream stream;
+        for (int i=0; (i < values.size()) && (i < 10); i++){
+          stream << values[i] << " ";
+        }
+        preciceDebug("First mapped values = " << stream.str());
       }
-      preciceDebug("First mapped values = " << stream.str() );
 #     endif
     }
   }
 
-  // Clear non-stationary, non-incremental mappings
+  // Mappings computed on advance are updated incrementally, others cleared
   for (impl::MappingContext& context : _accessor->writeMappingContexts()) {
-    bool isStationary = context.timing
-                        == MappingConfiguration::INITIAL;
-    if (not isStationary){
-        context.mapping->clear();
+    if (context.timing == MappingConfiguration::ON_ADVANCE){
+      context.mapping->setIsOutdated(true);
+    }
+    else if (context.timing != MappingConfiguration::INITIAL){
+      context.mapping->clear();
     }
     context.hasMappedData = false;
   }
@@ -2121,48 +2212,60 @@ void SolverInterfaceImpl:: mapReadData()
     bool mapNow = timing == mapping::MappingConfiguration::ON_ADVANCE;
     mapNow |= timing == mapping::MappingConfiguration::INITIAL;
     bool hasComputed = context.mapping->hasComputedMapping();
-    if (mapNow && not hasComputed){
+    if (mapNow && ((not hasComputed) || context.mapping->isOutdated())){
       preciceInfo("mapReadData()","Compute read mapping from mesh \""
               << _accessor->meshContext(context.fromMeshID).mesh->getName()
               << "\" to mesh \""
               << _accessor->meshContext(context.toMeshID).mesh->getName()
               << "\".");
 
-      context.mapping->computeMapping();
+      computeMapping(context);
     }
   }
 
-  // Map data
-  for (impl::DataContext& context : _accessor->readDataContexts()) {
-    timing = context.mappingContext.timing;
-    bool mapNow = timing == mapping::MappingConfiguration::ON_ADVANCE;
-    mapNow |= timing == mapping::MappingConfiguration::INITIAL;
-    bool hasMapping = context.mappingContext.mapping.get() != nullptr;
-    bool hasMapped = context.mappingContext.hasMappedData;
-    if (mapNow && hasMapping && (not hasMapped)){
-      int inDataID = context.fromData->getID();
-      int outDataID = context.toData->getID();
-      context.toData->values() = Eigen::VectorXd::Zero(context.toData->values().size());
-      //assign(context.toData->values()) = 0.0;
-      preciceDebug("Map read data \"" << context.fromData->getName()
-                   << "\" to mesh \"" << context.mesh->getName() << "\"");
-      context.mappingContext.mapping->map(inDataID, outDataID);
+  // Map data, all data of one mapping at once
+  for (impl::MappingContext& mappingContext : _accessor->readMappingContexts()) {
+    mapping::Mapping::DataPairs dataPairs;
+    for (impl::DataContext& context : _accessor->readDataContexts()) {
+      if (context.mappingContext.mapping != mappingContext.mapping){
+        continue;
+      }
+      timing = context.mappingContext.timing;
+      bool mapNow = timing == mapping::MappingConfiguration::ON_ADVANCE;
+      mapNow |= timing == mapping::MappingConfiguration::INITIAL;
+      bool hasMapped = context.mappingContext.hasMappedData;
+      if (mapNow && (not hasMapped)){
+        int inDataID = context.fromData->getID();
+        int outDataID = context.toData->getID();
+        context.toData->values() = Eigen::VectorXd::Zero(context.toData->values().size());
+        //assign(context.toData->values()) = 0.0;
+        preciceDebug("Map read data \"" << context.fromData->getName()
+                     << "\" to mesh \"" << context.mesh->getName() << "\"");
+        dataPairs.push_back(std::make_pair(inDataID, outDataID));
+      }
+    }
+    if (not dataPairs.empty()){
+      mappingContext.mapping->map(dataPairs);
 #     ifdef Debug
-      int max = context.toData->values().size();
-      std::ostringstream stream;
-      for (int i=0; (i < max) && (i < 10); i++){
-        stream << context.toData->values()[i] << " ";
+      for (const mapping::Mapping::DataPairs::value_type& pair : dataPairs){
+        const Eigen::VectorXd& values =
+            mappingContext.mapping->getOutputMesh()->data(pair.second)->values();
+        std::ostringstream stream;
+        for (int i=0; (i < values.size()) && (i < 10); i++){
+          stream << values[i] << " ";
+        }
+        preciceDebug("First mapped values = " << stream.str());
       }
-      preciceDebug("First mapped values = " << stream.str());
 #     endif
     }
   }
 
-  // Clear non-initial, non-incremental mappings
+  // Mappings computed on advance are updated incrementally, others cleared
   for (impl::MappingContext& context : _accessor->readMappingContexts()) {
-    bool isStationary = context.timing
-              == mapping::MappingConfiguration::INITIAL;
-    if (not isStationary){
+    if (context.timing == mapping::MappingConfiguration::ON_ADVANCE){
+      context.mapping->setIsOutdated(true);
+    }
+    else if (context.timing != mapping::MappingConfiguration::INITIAL){
       context.mapping->clear();
     }
     context.hasMappedData = false;
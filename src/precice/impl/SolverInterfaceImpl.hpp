@@ -127,6 +127,24 @@ public:
    */
   double advance ( double computedTimestepLength );
 
+  /**
+   * @brief Starts to exchange coupling data, completed by finishAdvance().
+   *
+   * Does everything advance() does before the data exchange and lets the
+   * coupling scheme post its sends and receives. The solver can do work in
+   * between, which does not change written data or access read data.
+   *
+   * @param computedTimestepLength [IN] Length of timestep computed by solver.
+   */
+  void startAdvance ( double computedTimestepLength );
+
+  /**
+   * @brief Completes the data exchange started by startAdvance().
+   *
+   * @return Maximum length of next timestep to be computed by solver.
+   */
+  double finishAdvance();
+
   /**
    * @brief Finalizes the coupled simulation.
    *
@@ -615,6 +633,17 @@ private:
   // @brief Counts calls to advance for plotting.
   long int _numberAdvanceCalls;
 
+  // @brief True between startAdvance() and finishAdvance().
+  bool _isAdvanceStarted;
+
+  // @brief Time state computed in startAdvance(), used in finishAdvance().
+  struct AdvanceState {
+    double computedTimestepLength = 0.0;
+    double timestepLength = 0.0;
+    double timestepPart = 0.0;
+    double time = 0.0;
+  } _advanceState;
+
 //  // @brief Locks the next receive operation of the server to a specific client.
 //  int _lockServerToClient;
 
@@ -680,6 +709,11 @@ private:
    */
   void createGeometry ( impl::MeshContext& meshContext );
 
+  /**
+   * @brief Computes a mapping, or restores it from its cache, if configured.
+   */
+  void computeMapping ( impl::MappingContext& mappingContext );
+
   /**
    * @brief Computes, performs, and resets all suitable write mappings.
    */
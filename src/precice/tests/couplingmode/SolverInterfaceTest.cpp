@@ -89,7 +89,9 @@ void SolverInterfaceTest:: run()
     if (Par::getProcessRank() <= 3){
       Par::setGlobalCommunicator(comm);
       testMethod(testDistributedCommunications)
+      testMethod(testDistributedCommunicationsLargeData);
       testMethod(testMultiCoupling);
+      testMethod(testMultiCouplingTwoDataPerMesh);
       Par::setGlobalCommunicator(Par::getCommunicatorWorld());
     }
   }
@@ -1463,6 +1465,82 @@ void SolverInterfaceTest:: testDistributedCommunications()
   }
 }
 
+void SolverInterfaceTest:: testDistributedCommunicationsLargeData()
+{
+  preciceTrace("testDistributedCommunicationsLargeData()");
+  assertion(utils::Parallel::getCommunicatorSize() == 4);
+  mesh::Mesh::resetGeometryIDsGlobally();
+
+  // About 1.2 MB of forces per rank, the sockets have 64 KB buffers
+  int vertexCount = 100000;
+  std::string solverName;
+  std::string meshName;
+  int rank = utils::Parallel::getProcessRank() % 2;
+  int i1 = -1, i2 = -1;
+  if (utils::Parallel::getProcessRank() <= 1){
+    solverName = "Fluid";
+    meshName = "FluidMesh";
+    i1 = rank * vertexCount / 2;
+    i2 = (rank + 1) * vertexCount / 2;
+  }
+  else {
+    // Partitioned differently than the fluid mesh
+    solverName = "Structure";
+    meshName = "StructureMesh";
+    i1 = rank * vertexCount / 4;
+    i2 = rank == 0 ? vertexCount / 4 : vertexCount;
+  }
+
+  SolverInterface precice(solverName, rank, 2);
+  configureSolverInterface(_pathToTests + "point-to-point-sockets-large.xml", precice);
+  int meshID = precice.getMeshID(meshName);
+  int forcesID = precice.getDataID("Forces", meshID);
+  int velocID = precice.getDataID("Velocities", meshID);
+
+  std::vector<int> vertexIDs;
+  utils::DynVector position(3, 0.0);
+  for (int i=i1; i < i2; i++){
+    position[0] = i;
+    vertexIDs.push_back(precice.setMeshVertex(meshID, raw(position)));
+  }
+
+  precice.initialize();
+
+  utils::DynVector datum(3);
+  for (int timestep=0; timestep < 2; timestep++){
+    bool valid = true;
+    if (solverName == "Fluid"){
+      for (size_t i=0; i < vertexIDs.size(); i++){
+        datum[0] = i1 + i + timestep;
+        datum[1] = i1 + i;
+        datum[2] = 0.0;
+        precice.writeVectorData(forcesID, vertexIDs[i], raw(datum));
+      }
+      precice.advance(1.0);
+      for (size_t i=0; i < vertexIDs.size(); i++){
+        precice.readVectorData(velocID, vertexIDs[i], raw(datum));
+        valid &= tarch::la::equals(datum[0], 2.0 * (i1 + i + timestep) + 1.0);
+        valid &= tarch::la::equals(datum[1], 2.0 * (i1 + i) + 1.0);
+        valid &= tarch::la::equals(datum[2], 1.0);
+      }
+    }
+    else {
+      for (size_t i=0; i < vertexIDs.size(); i++){
+        precice.readVectorData(forcesID, vertexIDs[i], raw(datum));
+        valid &= tarch::la::equals(datum[0], (double)(i1 + i + timestep));
+        valid &= tarch::la::equals(datum[1], (double)(i1 + i));
+        valid &= tarch::la::equals(datum[2], 0.0);
+        datum = datum * 2 + 1.0;
+        precice.writeVectorData(velocID, vertexIDs[i], raw(datum));
+      }
+      precice.advance(1.0);
+    }
+    validate(valid);
+  }
+
+  precice.finalize();
+}
+
 void SolverInterfaceTest:: testBug()
 {
   preciceTrace("testBug()");
@@ -1830,6 +1908,129 @@ void SolverInterfaceTest:: testMultiCoupling()
 
 }
 
+void SolverInterfaceTest:: testMultiCouplingTwoDataPerMesh()
+{
+  preciceTrace("testMultiCouplingTwoDataPerMesh()");
+  assertion(utils::Parallel::getCommunicatorSize() == 4);
+
+  mesh::Mesh::resetGeometryIDsGlobally();
+
+  std::vector<utils::DynVector> positions;
+  utils::DynVector position(2);
+  assignList(position) = 0.0, 0.0;
+  positions.push_back(position);
+  assignList(position) = 1.0, 0.0;
+  positions.push_back(position);
+  assignList(position) = 1.0, 1.0;
+  positions.push_back(position);
+  assignList(position) = 0.0, 1.0;
+  positions.push_back(position);
+
+  std::string writeIterCheckpoint(constants::actionWriteIterationCheckpoint());
+  std::string readIterCheckpoint(constants::actionReadIterationCheckpoint());
+  utils::DynVector datum(2);
+
+  if (utils::Parallel::getProcessRank() < 3){
+    std::string index = std::to_string(utils::Parallel::getProcessRank() + 1);
+    SolverInterface precice("SOLIDZ" + index, 0, 1);
+    configureSolverInterface(_pathToTests + "/multi-two-data.xml", precice);
+    validateEquals(precice.getDimensions(),2);
+
+    int meshID = precice.getMeshID("SOLIDZ_Mesh" + index);
+    int displacementsID = precice.getDataID("Displacements" + index, meshID);
+    int deltasID = precice.getDataID("DisplacementDeltas" + index, meshID);
+    int forcesID = precice.getDataID("Forces" + index, meshID);
+    int velocitiesID = precice.getDataID("Velocities" + index, meshID);
+
+    std::vector<int> vertexIDs;
+    for (size_t i=0; i < 4; i++){
+      vertexIDs.push_back(precice.setMeshVertex(meshID, raw(positions[i])));
+    }
+
+    precice.initialize();
+
+    for (size_t i=0; i < 4; i++){
+      assignList(datum) = 1.0 + i, 2.0;
+      precice.writeVectorData(displacementsID, vertexIDs[i], raw(datum));
+      assignList(datum) = 3.0, 4.0 + i;
+      precice.writeVectorData(deltasID, vertexIDs[i], raw(datum));
+    }
+
+    if (precice.isActionRequired(writeIterCheckpoint)){
+      precice.fulfilledAction(writeIterCheckpoint);
+    }
+    precice.advance(0.0001);
+    if (precice.isActionRequired(readIterCheckpoint)){
+      precice.fulfilledAction(readIterCheckpoint);
+    }
+
+    for (size_t i=0; i < 4; i++){
+      precice.readVectorData(forcesID, vertexIDs[i], raw(datum));
+      validateNumericalEquals(datum[0], 5.0 + i);
+      validateNumericalEquals(datum[1], 6.0);
+      precice.readVectorData(velocitiesID, vertexIDs[i], raw(datum));
+      validateNumericalEquals(datum[0], 7.0);
+      validateNumericalEquals(datum[1], 8.0 + i);
+    }
+
+    precice.finalize();
+  }
+  else {
+    assertion(utils::Parallel::getProcessRank() == 3);
+    SolverInterface precice("NASTIN", 0, 1);
+    configureSolverInterface(_pathToTests + "/multi-two-data.xml", precice);
+    validateEquals(precice.getDimensions(),2);
+
+    std::vector<int> meshIDs;
+    std::vector<std::vector<int> > vertexIDs(3);
+    for (int mesh=0; mesh < 3; mesh++){
+      std::string index = std::to_string(mesh + 1);
+      meshIDs.push_back(precice.getMeshID("NASTIN_Mesh" + index));
+      for (size_t i=0; i < 4; i++){
+        vertexIDs[mesh].push_back(precice.setMeshVertex(meshIDs[mesh], raw(positions[i])));
+      }
+    }
+
+    precice.initialize();
+
+    for (int mesh=0; mesh < 3; mesh++){
+      std::string index = std::to_string(mesh + 1);
+      int forcesID = precice.getDataID("Forces" + index, meshIDs[mesh]);
+      int velocitiesID = precice.getDataID("Velocities" + index, meshIDs[mesh]);
+      for (size_t i=0; i < 4; i++){
+        assignList(datum) = 5.0 + i, 6.0;
+        precice.writeVectorData(forcesID, vertexIDs[mesh][i], raw(datum));
+        assignList(datum) = 7.0, 8.0 + i;
+        precice.writeVectorData(velocitiesID, vertexIDs[mesh][i], raw(datum));
+      }
+    }
+
+    if (precice.isActionRequired(writeIterCheckpoint)){
+      precice.fulfilledAction(writeIterCheckpoint);
+    }
+    precice.advance(0.0001);
+    if (precice.isActionRequired(readIterCheckpoint)){
+      precice.fulfilledAction(readIterCheckpoint);
+    }
+
+    for (int mesh=0; mesh < 3; mesh++){
+      std::string index = std::to_string(mesh + 1);
+      int displacementsID = precice.getDataID("Displacements" + index, meshIDs[mesh]);
+      int deltasID = precice.getDataID("DisplacementDeltas" + index, meshIDs[mesh]);
+      for (size_t i=0; i < 4; i++){
+        precice.readVectorData(displacementsID, vertexIDs[mesh][i], raw(datum));
+        validateNumericalEquals(datum[0], 1.0 + i);
+        validateNumericalEquals(datum[1], 2.0);
+        precice.readVectorData(deltasID, vertexIDs[mesh][i], raw(datum));
+        validateNumericalEquals(datum[0], 3.0);
+        validateNumericalEquals(datum[1], 4.0 + i);
+      }
+    }
+
+    precice.finalize();
+  }
+}
+
 void SolverInterfaceTest:: testNASTINMeshRestart()
 {
   preciceTrace("testNASTINMeshRestart()");
@@ -160,6 +160,14 @@ private:
    */
   void testDistributedCommunications();
 
+  /**
+   * @brief Serial coupling with point-to-point payloads exceeding the socket buffers.
+   *
+   * The time step length is sent to the remote master in the same package as
+   * the data, the package must not be held back while the data blocks.
+   */
+  void testDistributedCommunicationsLargeData();
+
 
   /**
    * @brief Tests stationary mapping with solver provided meshes.
@@ -192,6 +200,11 @@ private:
    */
   void testMultiCoupling();
 
+  /**
+   * @brief Four solvers are multi-coupled, two data are exchanged per mesh in both directions.
+   */
+  void testMultiCouplingTwoDataPerMesh();
+
   /**
    * @brief All NASTIN meshes are restarted. One provided as well as one "from"
    * are tested.
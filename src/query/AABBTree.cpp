@@ -0,0 +1,221 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#include "AABBTree.hpp"
+#include "query/FindClosest.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Group.hpp"
+#include "mesh/Vertex.hpp"
+#include "mesh/Edge.hpp"
+#include "mesh/Triangle.hpp"
+#include "mesh/Quad.hpp"
+#include "utils/Globals.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace precice {
+namespace query {
+
+tarch::logging::Log AABBTree:: _log ( "precice::query::AABBTree" );
+
+AABBTree:: AABBTree
+(
+  mesh::Mesh& mesh )
+:
+  _dimensions ( mesh.getDimensions() ),
+  _vertexTree ( mesh.vertices() ),
+  _edges (),
+  _triangles (),
+  _quads (),
+  _elements (),
+  _nodes ()
+{
+  preciceTrace3 ( "AABBTree()", mesh.edges().size(), mesh.triangles().size(),
+                  mesh.quads().size() );
+  assertion ( (_dimensions == 2) || (_dimensions == 3), _dimensions );
+  _elements.reserve ( mesh.edges().size() + mesh.triangles().size() + mesh.quads().size() );
+  for ( mesh::Edge& edge : mesh.edges() ) {
+    addElement ( edge, 2, EDGE, (int)_edges.size() );
+    _edges.push_back ( & edge );
+  }
+  for ( mesh::Triangle& triangle : mesh.triangles() ) {
+    addElement ( triangle, 3, TRIANGLE, (int)_triangles.size() );
+    _triangles.push_back ( & triangle );
+  }
+  for ( mesh::Quad& quad : mesh.quads() ) {
+    addElement ( quad, 4, QUAD, (int)_quads.size() );
+    _quads.push_back ( & quad );
+  }
+  if ( not _elements.empty() ) {
+    _nodes.reserve ( 2 * _elements.size() / _leafSize + 1 );
+    build ( 0, (int)_elements.size() );
+  }
+}
+
+size_t AABBTree:: size() const
+{
+  return _elements.size();
+}
+
+bool AABBTree:: searchDistance
+(
+  FindClosest& findClosest ) const
+{
+  preciceTrace1 ( "searchDistance()", findClosest.getSearchPoint() );
+  const utils::DynVector& searchPoint = findClosest.getSearchPoint();
+  double vertexDistance = 0.0;
+  mesh::Vertex* closestVertex = _vertexTree.findClosestVertex ( searchPoint, &vertexDistance );
+  if ( closestVertex == NULL ) {
+    return false;
+  }
+  // Any element closer than the closest vertex has its bounding box within
+  // the vertex distance. The tolerance accounts for roundoff in the bounds.
+  double radius = vertexDistance + tarch::la::NUMERICAL_ZERO_DIFFERENCE
+                  + vertexDistance * 1e-10;
+  mesh::Group candidates;
+  candidates.add ( closestVertex );
+  findElementsInRadius ( searchPoint, radius, candidates );
+  return findClosest ( candidates );
+}
+
+void AABBTree:: findElementsInRadius
+(
+  const utils::DynVector& searchPoint,
+  double                  radius,
+  mesh::Group&            result ) const
+{
+  preciceTrace2 ( "findElementsInRadius()", searchPoint, radius );
+  if ( _nodes.empty() ) {
+    return;
+  }
+  assertion ( searchPoint.size() == _dimensions, searchPoint.size(), _dimensions );
+  double squaredRadius = radius * radius;
+  std::vector<const Element*> found;
+  std::vector<int> stack ( 1, 0 );
+  while ( not stack.empty() ) {
+    const Node& node = _nodes[stack.back()];
+    stack.pop_back();
+    if ( squaredDistance(searchPoint, node.lower, node.upper) > squaredRadius ) {
+      continue;
+    }
+    if ( node.left < 0 ) {
+      for ( int i=node.begin; i < node.end; i++ ) {
+        const Element& element = _elements[i];
+        if ( squaredDistance(searchPoint, element.lower, element.upper) <= squaredRadius ) {
+          found.push_back ( & element );
+        }
+      }
+    }
+    else {
+      stack.push_back ( node.right );
+      stack.push_back ( node.left );
+    }
+  }
+  // Restore mesh order, such that ties are resolved as without the tree
+  std::sort ( found.begin(), found.end(),
+              [] ( const Element* a, const Element* b ) {
+                return (a->type < b->type)
+                       || ((a->type == b->type) && (a->position < b->position)); } );
+  for ( const Element* element : found ) {
+    if ( element->type == EDGE ) {
+      result.add ( _edges[element->position] );
+    }
+    else if ( element->type == TRIANGLE ) {
+      result.add ( _triangles[element->position] );
+    }
+    else {
+      assertion ( element->type == QUAD );
+      result.add ( _quads[element->position] );
+    }
+  }
+}
+
+template<typename ELEMENT_T>
+void AABBTree:: addElement
+(
+  ELEMENT_T&  element,
+  int         vertexCount,
+  ElementType type,
+  int         position )
+{
+  Element newElement;
+  newElement.type = type;
+  newElement.position = position;
+  for ( int dim=0; dim < _dimensions; dim++ ) {
+    newElement.lower[dim] = std::numeric_limits<double>::max();
+    newElement.upper[dim] = - std::numeric_limits<double>::max();
+  }
+  for ( int i=0; i < vertexCount; i++ ) {
+    const utils::DynVector& coords = element.vertex(i).getCoords();
+    for ( int dim=0; dim < _dimensions; dim++ ) {
+      newElement.lower[dim] = std::min ( newElement.lower[dim], coords[dim] );
+      newElement.upper[dim] = std::max ( newElement.upper[dim], coords[dim] );
+    }
+  }
+  _elements.push_back ( newElement );
+}
+
+int AABBTree:: build
+(
+  int begin,
+  int end )
+{
+  int index = (int)_nodes.size();
+  _nodes.push_back ( Node() );
+  Node node;
+  node.begin = begin;
+  node.end = end;
+  node.left = -1;
+  node.right = -1;
+  for ( int dim=0; dim < _dimensions; dim++ ) {
+    node.lower[dim] = std::numeric_limits<double>::max();
+    node.upper[dim] = - std::numeric_limits<double>::max();
+    for ( int i=begin; i < end; i++ ) {
+      node.lower[dim] = std::min ( node.lower[dim], _elements[i].lower[dim] );
+      node.upper[dim] = std::max ( node.upper[dim], _elements[i].upper[dim] );
+    }
+  }
+  if ( end - begin > _leafSize ) {
+    // Split at the median of the element centers along the longest node side
+    int splitDimension = 0;
+    for ( int dim=1; dim < _dimensions; dim++ ) {
+      if ( node.upper[dim] - node.lower[dim]
+           > node.upper[splitDimension] - node.lower[splitDimension] )
+      {
+        splitDimension = dim;
+      }
+    }
+    int middle = begin + (end - begin) / 2;
+    std::nth_element ( _elements.begin() + begin, _elements.begin() + middle,
+                       _elements.begin() + end,
+                       [splitDimension] ( const Element& a, const Element& b ) {
+                         return a.lower[splitDimension] + a.upper[splitDimension]
+                                < b.lower[splitDimension] + b.upper[splitDimension]; } );
+    node.left = build ( begin, middle );
+    node.right = build ( middle, end );
+  }
+  _nodes[index] = node;
+  return index;
+}
+
+double AABBTree:: squaredDistance
+(
+  const utils::DynVector& searchPoint,
+  const double*           lower,
+  const double*           upper ) const
+{
+  double distance = 0.0;
+  for ( int dim=0; dim < _dimensions; dim++ ) {
+    double difference = 0.0;
+    if ( searchPoint[dim] < lower[dim] ) {
+      difference = lower[dim] - searchPoint[dim];
+    }
+    else if ( searchPoint[dim] > upper[dim] ) {
+      difference = searchPoint[dim] - upper[dim];
+    }
+    distance += difference * difference;
+  }
+  return distance;
+}
+
+}} // namespace precice, query
@@ -0,0 +1,145 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#ifndef PRECICE_QUERY_AABBTREE_HPP_
+#define PRECICE_QUERY_AABBTREE_HPP_
+
+#include "query/KDTree.hpp"
+#include "utils/Dimensions.hpp"
+#include "tarch/logging/Log.h"
+#include <vector>
+
+namespace precice {
+  namespace mesh {
+    class Mesh;
+    class Group;
+    class Edge;
+    class Triangle;
+    class Quad;
+  }
+  namespace query {
+    class FindClosest;
+  }
+}
+
+// ---------------------------------------------------------- CLASS DEFINITION
+
+namespace precice {
+namespace query {
+
+/**
+ * @brief Bounding volume hierarchy over the elements of a mesh.
+ *
+ * Holds an axis aligned bounding box (AABB) for every Edge, Triangle, and Quad
+ * object of a mesh and organizes them in a binary tree. The vertices of the
+ * mesh are indexed by a KDTree.
+ *
+ * The tree is used to restrict FindClosest to those mesh elements, which
+ * can be closer to the search point than the closest vertex: the distance to
+ * the projection point on an element is never smaller than the distance to the
+ * bounding box of the element. The result of searchDistance() is hence the
+ * same as running FindClosest on the whole mesh, while only O(log N) elements
+ * are visited for usual meshes.
+ *
+ * The tree has to be rebuilt when the mesh changes.
+ */
+class AABBTree
+{
+public:
+
+  /**
+   * @brief Constructor, builds the tree for all elements of the given mesh.
+   */
+  explicit AABBTree ( mesh::Mesh& mesh );
+
+  /**
+   * @brief Returns the number of indexed edges, triangles, and quads.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Runs findClosest on all elements which can be closest.
+   *
+   * @return True, if a closest element has been found.
+   */
+  bool searchDistance ( FindClosest& findClosest ) const;
+
+  /**
+   * @brief Adds all elements having a bounding box within radius to point.
+   *
+   * The elements are added to result in the order they are held by the mesh.
+   * Vertices are not added.
+   */
+  void findElementsInRadius (
+    const utils::DynVector& searchPoint,
+    double                  radius,
+    mesh::Group&            result ) const;
+
+private:
+
+  static tarch::logging::Log _log;
+
+  // @brief Number of elements below which a node is not split further.
+  static const int _leafSize = 4;
+
+  enum ElementType {
+    EDGE,
+    TRIANGLE,
+    QUAD
+  };
+
+  struct Element
+  {
+    ElementType type;
+    // @brief Position of the element in the mesh container of its type.
+    int position;
+    double lower[3];
+    double upper[3];
+  };
+
+  struct Node
+  {
+    // @brief Range of elements in _elements contained in this node.
+    int begin;
+    int end;
+    // @brief Indices of the child nodes, -1 for leaf nodes.
+    int left;
+    int right;
+    double lower[3];
+    double upper[3];
+  };
+
+  int _dimensions;
+
+  // @brief Index over the mesh vertices, bounds the search radius.
+  KDTree _vertexTree;
+
+  std::vector<mesh::Edge*> _edges;
+
+  std::vector<mesh::Triangle*> _triangles;
+
+  std::vector<mesh::Quad*> _quads;
+
+  // @brief Indexed elements, ordered such that every node is a range.
+  std::vector<Element> _elements;
+
+  std::vector<Node> _nodes;
+
+  template<typename ELEMENT_T>
+  void addElement (
+    ELEMENT_T&  element,
+    int         vertexCount,
+    ElementType type,
+    int         position );
+
+  int build ( int begin, int end );
+
+  double squaredDistance (
+    const utils::DynVector& searchPoint,
+    const double*           lower,
+    const double*           upper ) const;
+};
+
+}} // namespace precice, query
+
+#endif /* PRECICE_QUERY_AABBTREE_HPP_ */
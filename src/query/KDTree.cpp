@@ -0,0 +1,314 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#include "KDTree.hpp"
+#include "mesh/Vertex.hpp"
+#include "utils/Globals.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace precice {
+namespace query {
+
+tarch::logging::Log KDTree:: _log ( "precice::query::KDTree" );
+
+KDTree:: KDTree
+(
+  const VertexContainer&   vertices,
+  const std::vector<bool>& deadAxes )
+:
+  _dimensions ( 0 ),
+  _axes (),
+  _vertices (),
+  _positions (),
+  _coords (),
+  _splitDimensions (),
+  _lowerMax (),
+  _upperMin ()
+{
+  preciceTrace1 ( "KDTree()", vertices.size() );
+  int size = (int) vertices.size();
+  if ( size == 0 ) {
+    return;
+  }
+  _dimensions = vertices[0].getDimensions();
+  assertion ( deadAxes.empty() || ((int)deadAxes.size() == _dimensions),
+              deadAxes.size(), _dimensions );
+  for ( int dim=0; dim < _dimensions; dim++ ) {
+    if ( deadAxes.empty() || not deadAxes[dim] ) {
+      _axes.push_back ( dim );
+    }
+  }
+  assertion ( not _axes.empty() );
+  int axesCount = (int)_axes.size();
+
+  // Fill coordinates in container order, the build works on _positions only
+  std::vector<mesh::Vertex*> containerVertices;
+  containerVertices.reserve ( size );
+  _coords.resize ( size * axesCount );
+  _positions.resize ( size );
+  _splitDimensions.resize ( size, -1 );
+  int i = 0;
+  for ( mesh::Vertex& vertex : vertices ) {
+    const utils::DynVector& coords = vertex.getCoords();
+    assertion ( coords.size() == _dimensions, coords.size(), _dimensions );
+    for ( int axis=0; axis < axesCount; axis++ ) {
+      _coords[i*axesCount + axis] = coords[_axes[axis]];
+    }
+    containerVertices.push_back ( & vertex );
+    _positions[i] = i;
+    i++;
+  }
+  build ( 0, size );
+
+  // Reorder vertices and coordinates into tree order for cache friendly queries
+  std::vector<double> treeCoords ( size * axesCount );
+  _vertices.resize ( size );
+  for ( i=0; i < size; i++ ) {
+    int position = _positions[i];
+    _vertices[i] = containerVertices[position];
+    for ( int axis=0; axis < axesCount; axis++ ) {
+      treeCoords[i*axesCount + axis] = _coords[position*axesCount + axis];
+    }
+  }
+  _coords.swap ( treeCoords );
+
+  // Both subtrees of a node are bounded by its median at first
+  _lowerMax.resize ( size );
+  _upperMin.resize ( size );
+  for ( i=0; i < size; i++ ) {
+    if ( _splitDimensions[i] >= 0 ) {
+      _lowerMax[i] = _coords[i*axesCount + _splitDimensions[i]];
+      _upperMin[i] = _lowerMax[i];
+    }
+  }
+}
+
+size_t KDTree:: size() const
+{
+  return _vertices.size();
+}
+
+bool KDTree:: empty() const
+{
+  return _vertices.empty();
+}
+
+int KDTree:: getDimensions() const
+{
+  return _dimensions;
+}
+
+mesh::Vertex* KDTree:: findClosestVertex
+(
+  const utils::DynVector& searchPoint,
+  double*                 distance ) const
+{
+  preciceTrace1 ( "findClosestVertex()", searchPoint );
+  if ( empty() ) {
+    return NULL;
+  }
+  assertion ( searchPoint.size() == _dimensions, searchPoint.size(), _dimensions );
+  int closest = -1;
+  double closestDistance = std::numeric_limits<double>::max();
+  searchClosest ( searchPoint, 0, (int)size(), closest, closestDistance );
+  assertion ( closest >= 0 );
+  if ( distance != NULL ) {
+    *distance = std::sqrt ( closestDistance );
+  }
+  return _vertices[closest];
+}
+
+void KDTree:: findVerticesInRadius
+(
+  const utils::DynVector&     searchPoint,
+  double                      radius,
+  std::vector<mesh::Vertex*>& result ) const
+{
+  preciceTrace2 ( "findVerticesInRadius()", searchPoint, radius );
+  if ( empty() ) {
+    return;
+  }
+  assertion ( searchPoint.size() == _dimensions, searchPoint.size(), _dimensions );
+  std::vector<int> found;
+  searchRadius ( searchPoint, radius * radius, 0, (int)size(), found );
+  std::sort ( found.begin(), found.end(),
+              [this] ( int a, int b ) { return _positions[a] < _positions[b]; } );
+  result.reserve ( result.size() + found.size() );
+  for ( int index : found ) {
+    result.push_back ( _vertices[index] );
+  }
+}
+
+int KDTree:: update()
+{
+  preciceTrace1 ( "update()", size() );
+  int axesCount = (int)_axes.size();
+  int size = (int)_vertices.size();
+  int moved = 0;
+  for ( int index=0; index < size; index++ ) {
+    const utils::DynVector& coords = _vertices[index]->getCoords();
+    double* treeCoords = & _coords[index*axesCount];
+    bool isMoved = false;
+    for ( int axis=0; axis < axesCount; axis++ ) {
+      if ( treeCoords[axis] != coords[_axes[axis]] ) {
+        treeCoords[axis] = coords[_axes[axis]];
+        isMoved = true;
+      }
+    }
+    if ( not isMoved ) {
+      continue;
+    }
+    moved++;
+    // Widen the bounds of all nodes having the vertex in a subtree
+    int begin = 0;
+    int end = size;
+    while ( end - begin > _leafSize ) {
+      int middle = begin + (end - begin) / 2;
+      if ( index == middle ) {
+        break;
+      }
+      double value = treeCoords[_splitDimensions[middle]];
+      if ( index < middle ) {
+        _lowerMax[middle] = std::max ( _lowerMax[middle], value );
+        end = middle;
+      }
+      else {
+        _upperMin[middle] = std::min ( _upperMin[middle], value );
+        begin = middle + 1;
+      }
+    }
+  }
+  preciceDebug ( "Updated " << moved << " moved vertices" );
+  return moved;
+}
+
+void KDTree:: build
+(
+  int begin,
+  int end )
+{
+  if ( end - begin <= _leafSize ) {
+    return;
+  }
+  // Split along the axis of largest extent
+  int axesCount = (int)_axes.size();
+  int splitDimension = 0;
+  double maxExtent = -1.0;
+  for ( int dim=0; dim < axesCount; dim++ ) {
+    double lower = std::numeric_limits<double>::max();
+    double upper = - std::numeric_limits<double>::max();
+    for ( int i=begin; i < end; i++ ) {
+      double value = _coords[_positions[i]*axesCount + dim];
+      lower = std::min ( lower, value );
+      upper = std::max ( upper, value );
+    }
+    if ( upper - lower > maxExtent ) {
+      maxExtent = upper - lower;
+      splitDimension = dim;
+    }
+  }
+  int middle = begin + (end - begin) / 2;
+  std::nth_element ( _positions.begin() + begin, _positions.begin() + middle,
+                     _positions.begin() + end,
+                     [this, axesCount, splitDimension] ( int a, int b ) {
+                       return _coords[a*axesCount + splitDimension]
+                              < _coords[b*axesCount + splitDimension]; } );
+  _splitDimensions[middle] = splitDimension;
+  build ( begin, middle );
+  build ( middle + 1, end );
+}
+
+double KDTree:: squaredDistance
+(
+  const utils::DynVector& searchPoint,
+  int                     index ) const
+{
+  int axesCount = (int)_axes.size();
+  double distance = 0.0;
+  const double* coords = & _coords[index*axesCount];
+  for ( int axis=0; axis < axesCount; axis++ ) {
+    double difference = coords[axis] - searchPoint[_axes[axis]];
+    distance += difference * difference;
+  }
+  return distance;
+}
+
+void KDTree:: searchClosest
+(
+  const utils::DynVector& searchPoint,
+  int                     begin,
+  int                     end,
+  int&                    closest,
+  double&                 closestDistance ) const
+{
+  if ( end - begin <= _leafSize ) {
+    for ( int i=begin; i < end; i++ ) {
+      double distance = squaredDistance ( searchPoint, i );
+      if ( (closest < 0) || (distance < closestDistance) || ((distance == closestDistance)
+           && (_positions[i] < _positions[closest])) )
+      {
+        closestDistance = distance;
+        closest = i;
+      }
+    }
+    return;
+  }
+  int middle = begin + (end - begin) / 2;
+  int splitDimension = _splitDimensions[middle];
+  double distance = squaredDistance ( searchPoint, middle );
+  if ( (closest < 0) || (distance < closestDistance) || ((distance == closestDistance)
+       && (_positions[middle] < _positions[closest])) )
+  {
+    closestDistance = distance;
+    closest = middle;
+  }
+  double lowerGap = searchPoint[_axes[splitDimension]] - _lowerMax[middle];
+  double upperGap = _upperMin[middle] - searchPoint[_axes[splitDimension]];
+  if ( lowerGap <= upperGap ) {
+    searchClosest ( searchPoint, begin, middle, closest, closestDistance );
+    if ( (upperGap <= 0.0) || (upperGap * upperGap <= closestDistance) ) {
+      searchClosest ( searchPoint, middle + 1, end, closest, closestDistance );
+    }
+  }
+  else {
+    searchClosest ( searchPoint, middle + 1, end, closest, closestDistance );
+    if ( (lowerGap <= 0.0) || (lowerGap * lowerGap <= closestDistance) ) {
+      searchClosest ( searchPoint, begin, middle, closest, closestDistance );
+    }
+  }
+}
+
+void KDTree:: searchRadius
+(
+  const utils::DynVector& searchPoint,
+  double                  squaredRadius,
+  int                     begin,
+  int                     end,
+  std::vector<int>&       found ) const
+{
+  if ( end - begin <= _leafSize ) {
+    for ( int i=begin; i < end; i++ ) {
+      if ( squaredDistance(searchPoint, i) <= squaredRadius ) {
+        found.push_back ( i );
+      }
+    }
+    return;
+  }
+  int middle = begin + (end - begin) / 2;
+  int splitDimension = _splitDimensions[middle];
+  if ( squaredDistance(searchPoint, middle) <= squaredRadius ) {
+    found.push_back ( middle );
+  }
+  double lowerGap = searchPoint[_axes[splitDimension]] - _lowerMax[middle];
+  double upperGap = _upperMin[middle] - searchPoint[_axes[splitDimension]];
+  if ( (lowerGap <= 0.0) || (lowerGap * lowerGap <= squaredRadius) ) {
+    searchRadius ( searchPoint, squaredRadius, begin, middle, found );
+  }
+  if ( (upperGap <= 0.0) || (upperGap * upperGap <= squaredRadius) ) {
+    searchRadius ( searchPoint, squaredRadius, middle + 1, end, found );
+  }
+}
+
+}} // namespace precice, query
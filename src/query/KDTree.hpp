@@ -0,0 +1,156 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#ifndef PRECICE_QUERY_KDTREE_HPP_
+#define PRECICE_QUERY_KDTREE_HPP_
+
+#include "utils/Dimensions.hpp"
+#include "utils/PointerVector.hpp"
+#include "tarch/logging/Log.h"
+#include <vector>
+
+namespace precice {
+  namespace mesh {
+    class Vertex;
+  }
+}
+
+// ---------------------------------------------------------- CLASS DEFINITION
+
+namespace precice {
+namespace query {
+
+/**
+ * @brief Spatial index over the vertices of a mesh (or group).
+ *
+ * The tree is built once from a vertex container and can then be queried
+ * repeatedly for the closest vertex to a point, or for all vertices within a
+ * given radius. Building costs O(N log N), a closest vertex query O(log N) on
+ * average, compared to O(N) for FindClosestVertex.
+ *
+ * The tree stores pointers to the vertices and a copy of their coordinates.
+ * Moved vertices are taken over by update(), which widens the bounds of the
+ * affected nodes instead of rebuilding. The tree has to be rebuilt when
+ * vertices are added or removed.
+ *
+ * On ties in the distance, the vertex appearing first in the container is
+ * returned, which is the same behavior as for FindClosestVertex.
+ */
+class KDTree
+{
+public:
+
+  typedef utils::ptr_vector<mesh::Vertex> VertexContainer;
+
+  /**
+   * @brief Constructor, builds the tree.
+   *
+   * @param vertices [IN] Vertices to be indexed, usually mesh.vertices().
+   * @param deadAxes [IN] Optional flag per dimension, coordinates along dead
+   *        axes are ignored in all distance computations.
+   */
+  explicit KDTree (
+    const VertexContainer&   vertices,
+    const std::vector<bool>& deadAxes = std::vector<bool>() );
+
+  /**
+   * @brief Returns the number of indexed vertices.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns true, if no vertices are indexed.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Returns the spatial dimensionality of the indexed vertices.
+   */
+  int getDimensions() const;
+
+  /**
+   * @brief Returns the vertex closest to searchPoint, NULL if tree is empty.
+   *
+   * @param searchPoint [IN] Point to search closest vertex for.
+   * @param distance [OUT] Euclidian distance to closest vertex, if not NULL.
+   */
+  mesh::Vertex* findClosestVertex (
+    const utils::DynVector& searchPoint,
+    double*                 distance = NULL ) const;
+
+  /**
+   * @brief Collects all vertices with euclidian distance <= radius to point.
+   *
+   * The found vertices are appended to result, ordered by their position in
+   * the indexed container.
+   */
+  void findVerticesInRadius (
+    const utils::DynVector&     searchPoint,
+    double                      radius,
+    std::vector<mesh::Vertex*>& result ) const;
+
+  /**
+   * @brief Takes over the current coordinates of all moved vertices.
+   *
+   * Costs O(N) for the comparison and O(log N) per moved vertex. Queries stay
+   * exact, but become slower when vertices have moved far from their
+   * position at the build.
+   *
+   * @return Number of moved vertices.
+   */
+  int update();
+
+private:
+
+  static tarch::logging::Log _log;
+
+  // @brief Number of vertices below which a subtree is searched brute force.
+  static const int _leafSize = 8;
+
+  int _dimensions;
+
+  // @brief Dimensions (not dead axes) taken into account for distances.
+  std::vector<int> _axes;
+
+  // @brief Indexed vertices, in tree order.
+  std::vector<mesh::Vertex*> _vertices;
+
+  // @brief Position of every vertex (in tree order) in the indexed container.
+  std::vector<int> _positions;
+
+  // @brief Coordinates along _axes of all vertices (in tree order), contiguous.
+  std::vector<double> _coords;
+
+  // @brief Splitting axis (index into _axes) of the node having its median at an index.
+  std::vector<int> _splitDimensions;
+
+  // @brief Largest coordinate along the splitting axis in the lower subtree of a node.
+  std::vector<double> _lowerMax;
+
+  // @brief Smallest coordinate along the splitting axis in the upper subtree of a node.
+  std::vector<double> _upperMin;
+
+  void build ( int begin, int end );
+
+  double squaredDistance (
+    const utils::DynVector& searchPoint,
+    int                     index ) const;
+
+  void searchClosest (
+    const utils::DynVector& searchPoint,
+    int                     begin,
+    int                     end,
+    int&                    closest,
+    double&                 closestDistance ) const;
+
+  void searchRadius (
+    const utils::DynVector& searchPoint,
+    double                  squaredRadius,
+    int                     begin,
+    int                     end,
+    std::vector<int>&       found ) const;
+};
+
+}} // namespace precice, query
+
+#endif /* PRECICE_QUERY_KDTREE_HPP_ */
@@ -0,0 +1,134 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#include "AABBTreeTest.hpp"
+#include "query/AABBTree.hpp"
+#include "query/FindClosest.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Vertex.hpp"
+#include "mesh/Edge.hpp"
+#include "mesh/Triangle.hpp"
+#include "utils/Parallel.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(precice::query::tests::AABBTreeTest)
+
+namespace precice {
+namespace query {
+namespace tests {
+
+tarch::logging::Log AABBTreeTest:: _log ( "precice::query::tests::AABBTreeTest" );
+
+AABBTreeTest:: AABBTreeTest ()
+:
+  TestCase ("query::AABBTreeTest")
+{}
+
+void AABBTreeTest:: run ()
+{
+  PRECICE_MASTER_ONLY {
+    testMethod ( testSearchDistance2D );
+    testMethod ( testSearchDistance3D );
+  }
+}
+
+void AABBTreeTest:: testSearchDistance2D ()
+{
+  preciceTrace ( "testSearchDistance2D()" );
+  std::srand ( 42 );
+  int dim = 2;
+  mesh::Mesh mesh ( "Mesh", dim, false );
+  // Closed polygon approximating a wiggly circle
+  int vertexCount = 200;
+  utils::DynVector coords ( dim );
+  for ( int i=0; i < vertexCount; i++ ){
+    double angle = 2.0 * M_PI * i / vertexCount;
+    double radius = 1.0 + 0.1 * (double) std::rand() / RAND_MAX;
+    coords[0] = radius * std::cos(angle);
+    coords[1] = radius * std::sin(angle);
+    mesh.createVertex ( coords );
+  }
+  for ( int i=0; i < vertexCount; i++ ){
+    mesh.createEdge ( mesh.vertices()[i], mesh.vertices()[(i+1) % vertexCount] );
+  }
+  mesh.computeState();
+
+  AABBTree tree ( mesh );
+  validateEquals ( tree.size(), (size_t)vertexCount );
+  for ( int i=0; i < 200; i++ ){
+    for ( int d=0; d < dim; d++ ){
+      coords[d] = 3.0 * (double) std::rand() / RAND_MAX - 1.5;
+    }
+    FindClosest find ( coords );
+    find ( mesh );
+    FindClosest findTree ( coords );
+    validate ( tree.searchDistance(findTree) );
+    validateNumericalEquals ( findTree.getClosest().distance, find.getClosest().distance );
+    const std::vector<InterpolationElement>& elems = find.getClosest().interpolationElements;
+    const std::vector<InterpolationElement>& elemsTree = findTree.getClosest().interpolationElements;
+    validateEquals ( elemsTree.size(), elems.size() );
+    for ( size_t j=0; j < std::min(elems.size(), elemsTree.size()); j++ ){
+      validateEquals ( elemsTree[j].element->getID(), elems[j].element->getID() );
+      validateNumericalEquals ( elemsTree[j].weight, elems[j].weight );
+    }
+  }
+}
+
+void AABBTreeTest:: testSearchDistance3D ()
+{
+  preciceTrace ( "testSearchDistance3D()" );
+  std::srand ( 42 );
+  int dim = 3;
+  mesh::Mesh mesh ( "Mesh", dim, false );
+  // Triangulated, randomly perturbed height field
+  int n = 12;
+  utils::DynVector coords ( dim );
+  for ( int i=0; i < n; i++ ){
+    for ( int j=0; j < n; j++ ){
+      coords[0] = (double) i / (n-1);
+      coords[1] = (double) j / (n-1);
+      coords[2] = 0.2 * (double) std::rand() / RAND_MAX;
+      mesh.createVertex ( coords );
+    }
+  }
+  for ( int i=0; i < n-1; i++ ){
+    for ( int j=0; j < n-1; j++ ){
+      mesh::Vertex& v00 = mesh.vertices()[i*n + j];
+      mesh::Vertex& v10 = mesh.vertices()[(i+1)*n + j];
+      mesh::Vertex& v01 = mesh.vertices()[i*n + j + 1];
+      mesh::Vertex& v11 = mesh.vertices()[(i+1)*n + j + 1];
+      mesh::Edge& e0 = mesh.createEdge ( v00, v10 );
+      mesh::Edge& e1 = mesh.createEdge ( v10, v11 );
+      mesh::Edge& e2 = mesh.createEdge ( v11, v00 );
+      mesh::Edge& e3 = mesh.createEdge ( v11, v01 );
+      mesh::Edge& e4 = mesh.createEdge ( v01, v00 );
+      mesh.createTriangle ( e0, e1, e2 );
+      mesh.createTriangle ( e2, e3, e4 );
+    }
+  }
+  mesh.computeState();
+
+  AABBTree tree ( mesh );
+  for ( int i=0; i < 300; i++ ){
+    for ( int d=0; d < dim; d++ ){
+      coords[d] = 1.4 * (double) std::rand() / RAND_MAX - 0.2;
+    }
+    FindClosest find ( coords );
+    find ( mesh );
+    FindClosest findTree ( coords );
+    validate ( tree.searchDistance(findTree) );
+    validateNumericalEquals ( findTree.getClosest().distance, find.getClosest().distance );
+    const std::vector<InterpolationElement>& elems = find.getClosest().interpolationElements;
+    const std::vector<InterpolationElement>& elemsTree = findTree.getClosest().interpolationElements;
+    validateEquals ( elemsTree.size(), elems.size() );
+    for ( size_t j=0; j < std::min(elems.size(), elemsTree.size()); j++ ){
+      validateEquals ( elemsTree[j].element->getID(), elems[j].element->getID() );
+      validateNumericalEquals ( elemsTree[j].weight, elems[j].weight );
+    }
+  }
+}
+
+}}} // namespace precice, query, tests
@@ -0,0 +1,42 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#ifndef PRECICE_QUERY_AABBTREETEST_HPP_
+#define PRECICE_QUERY_AABBTREETEST_HPP_
+
+#include "tarch/tests/TestCase.h"
+#include "tarch/logging/Log.h"
+
+namespace precice {
+namespace query {
+namespace tests {
+
+/**
+ * @brief Provides tests for class AABBTree.
+ */
+class AABBTreeTest : public tarch::tests::TestCase
+{
+public:
+
+  AABBTreeTest();
+
+  virtual ~AABBTreeTest() {}
+
+  virtual void setUp() {}
+
+  virtual void run();
+
+private:
+
+  static tarch::logging::Log _log;
+
+  /// Compares closest elements found with and without AABBTree on edges in 2D.
+  void testSearchDistance2D();
+
+  /// Compares closest elements found with and without AABBTree on triangles.
+  void testSearchDistance3D();
+};
+
+}}} // namespace precice, query, tests
+
+#endif /* PRECICE_QUERY_AABBTREETEST_HPP_ */
@@ -0,0 +1,202 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#include "KDTreeTest.hpp"
+#include "query/KDTree.hpp"
+#include "query/FindClosestVertex.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Vertex.hpp"
+#include "utils/Parallel.hpp"
+#include <cstdlib>
+#include <vector>
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(precice::query::tests::KDTreeTest)
+
+namespace precice {
+namespace query {
+namespace tests {
+
+tarch::logging::Log KDTreeTest:: _log ( "precice::query::tests::KDTreeTest" );
+
+KDTreeTest:: KDTreeTest ()
+:
+  TestCase ("query::KDTreeTest")
+{}
+
+void KDTreeTest:: run ()
+{
+  PRECICE_MASTER_ONLY {
+    testMethod ( testEmptyTree );
+    testMethod ( testFindClosestVertex );
+    testMethod ( testFindVerticesInRadius );
+    testMethod ( testDeadAxes );
+    testMethod ( testUpdate );
+  }
+}
+
+void KDTreeTest:: testEmptyTree ()
+{
+  preciceTrace ( "testEmptyTree()" );
+  mesh::Mesh mesh ( "Mesh", 2, false );
+  KDTree tree ( mesh.vertices() );
+  validate ( tree.empty() );
+  validateEquals ( tree.size(), 0 );
+  validate ( tree.findClosestVertex(utils::DynVector(2, 0.0)) == NULL );
+  std::vector<mesh::Vertex*> found;
+  tree.findVerticesInRadius ( utils::DynVector(2, 0.0), 1.0, found );
+  validate ( found.empty() );
+}
+
+void KDTreeTest:: testFindClosestVertex ()
+{
+  preciceTrace ( "testFindClosestVertex()" );
+  std::srand ( 42 );
+  for ( int dim=2; dim <= 3; dim++ ){
+    mesh::Mesh mesh ( "Mesh", dim, false );
+    utils::DynVector coords ( dim );
+    for ( int i=0; i < 500; i++ ){
+      for ( int d=0; d < dim; d++ ){
+        coords[d] = (double) std::rand() / RAND_MAX;
+      }
+      mesh.createVertex ( coords );
+    }
+    // Duplicated vertex, the first one has to be found on ties
+    mesh.createVertex ( mesh.vertices()[0].getCoords() );
+
+    KDTree tree ( mesh.vertices() );
+    validateEquals ( tree.size(), 501 );
+    validateEquals ( tree.getDimensions(), dim );
+
+    for ( int i=0; i < 200; i++ ){
+      for ( int d=0; d < dim; d++ ){
+        coords[d] = 1.2 * (double) std::rand() / RAND_MAX - 0.1;
+      }
+      FindClosestVertex find ( coords );
+      find ( mesh );
+      double distance = -1.0;
+      mesh::Vertex* closest = tree.findClosestVertex ( coords, &distance );
+      validate ( closest != NULL );
+      validateEquals ( closest->getID(), find.getClosestVertex().getID() );
+      validateNumericalEquals ( distance, find.getEuclidianDistance() );
+    }
+
+    mesh::Vertex* closest = tree.findClosestVertex ( mesh.vertices()[0].getCoords() );
+    validateEquals ( closest->getID(), 0 );
+  }
+}
+
+void KDTreeTest:: testFindVerticesInRadius ()
+{
+  preciceTrace ( "testFindVerticesInRadius()" );
+  std::srand ( 42 );
+  for ( int dim=2; dim <= 3; dim++ ){
+    mesh::Mesh mesh ( "Mesh", dim, false );
+    utils::DynVector coords ( dim );
+    for ( int i=0; i < 500; i++ ){
+      for ( int d=0; d < dim; d++ ){
+        coords[d] = (double) std::rand() / RAND_MAX;
+      }
+      mesh.createVertex ( coords );
+    }
+    KDTree tree ( mesh.vertices() );
+    double radius = 0.2;
+    for ( int i=0; i < 50; i++ ){
+      for ( int d=0; d < dim; d++ ){
+        coords[d] = (double) std::rand() / RAND_MAX;
+      }
+      std::vector<mesh::Vertex*> found;
+      tree.findVerticesInRadius ( coords, radius, found );
+      std::vector<int> expected;
+      for ( mesh::Vertex& vertex : mesh.vertices() ){
+        if ( tarch::la::norm2(vertex.getCoords() - coords) <= radius ){
+          expected.push_back ( vertex.getID() );
+        }
+      }
+      validateEquals ( found.size(), expected.size() );
+      for ( size_t j=0; j < std::min(found.size(), expected.size()); j++ ){
+        validateEquals ( found[j]->getID(), expected[j] );
+      }
+    }
+  }
+}
+
+void KDTreeTest:: testDeadAxes ()
+{
+  preciceTrace ( "testDeadAxes()" );
+  using utils::Vector3D;
+  mesh::Mesh mesh ( "Mesh", 3, false );
+  mesh.createVertex ( Vector3D(0.0, 5.0, 0.0) );
+  mesh.createVertex ( Vector3D(1.0, 0.0, 0.0) );
+  mesh.createVertex ( Vector3D(0.0, 0.0, 2.0) );
+  std::vector<bool> deadAxes ( 3, false );
+  deadAxes[1] = true;
+  KDTree tree ( mesh.vertices(), deadAxes );
+
+  double distance = -1.0;
+  mesh::Vertex* closest = tree.findClosestVertex ( utils::DynVector(Vector3D(0.0)), &distance );
+  validateEquals ( closest->getID(), 0 );
+  validateNumericalEquals ( distance, 0.0 );
+
+  std::vector<mesh::Vertex*> found;
+  tree.findVerticesInRadius ( utils::DynVector(Vector3D(0.0, -3.0, 0.0)), 1.5, found );
+  validateEquals ( found.size(), 2 );
+  if ( found.size() == 2 ){
+    validateEquals ( found[0]->getID(), 0 );
+    validateEquals ( found[1]->getID(), 1 );
+  }
+}
+
+void KDTreeTest:: testUpdate ()
+{
+  preciceTrace ( "testUpdate()" );
+  std::srand ( 42 );
+  for ( int dim=2; dim <= 3; dim++ ){
+    mesh::Mesh mesh ( "Mesh", dim, false );
+    utils::DynVector coords ( dim );
+    for ( int i=0; i < 500; i++ ){
+      for ( int d=0; d < dim; d++ ){
+        coords[d] = (double) std::rand() / RAND_MAX;
+      }
+      mesh.createVertex ( coords );
+    }
+    KDTree tree ( mesh.vertices() );
+    validateEquals ( tree.update(), 0 );
+
+    // Move every fifth vertex anywhere into the domain
+    for ( int i=0; i < 500; i += 5 ){
+      for ( int d=0; d < dim; d++ ){
+        coords[d] = (double) std::rand() / RAND_MAX;
+      }
+      mesh.vertices()[i].setCoords ( coords );
+    }
+    validateEquals ( tree.update(), 100 );
+
+    double radius = 0.2;
+    for ( int i=0; i < 100; i++ ){
+      for ( int d=0; d < dim; d++ ){
+        coords[d] = 1.2 * (double) std::rand() / RAND_MAX - 0.1;
+      }
+      FindClosestVertex find ( coords );
+      find ( mesh );
+      mesh::Vertex* closest = tree.findClosestVertex ( coords );
+      validate ( closest != NULL );
+      validateEquals ( closest->getID(), find.getClosestVertex().getID() );
+
+      std::vector<mesh::Vertex*> found;
+      tree.findVerticesInRadius ( coords, radius, found );
+      std::vector<int> expected;
+      for ( mesh::Vertex& vertex : mesh.vertices() ){
+        if ( tarch::la::norm2(vertex.getCoords() - coords) <= radius ){
+          expected.push_back ( vertex.getID() );
+        }
+      }
+      validateEquals ( found.size(), expected.size() );
+      for ( size_t j=0; j < std::min(found.size(), expected.size()); j++ ){
+        validateEquals ( found[j]->getID(), expected[j] );
+      }
+    }
+  }
+}
+
+}}} // namespace precice, query, tests
@@ -0,0 +1,48 @@
+// Copyright (C) 2011 Technische Universitaet Muenchen
+// This file is part of the preCICE project. For conditions of distribution and
+// use, please see the license notice at http://www5.in.tum.de/wiki/index.php/PreCICE_License
+#ifndef PRECICE_QUERY_KDTREETEST_HPP_
+#define PRECICE_QUERY_KDTREETEST_HPP_
+
+#include "tarch/tests/TestCase.h"
+#include "tarch/logging/Log.h"
+
+namespace precice {
+namespace query {
+namespace tests {
+
+/**
+ * @brief Provides tests for class KDTree.
+ */
+class KDTreeTest : public tarch::tests::TestCase
+{
+public:
+
+  KDTreeTest();
+
+  virtual ~KDTreeTest() {}
+
+  virtual void setUp() {}
+
+  virtual void run();
+
+private:
+
+  static tarch::logging::Log _log;
+
+  void testEmptyTree();
+
+  /// Compares closest vertices found by KDTree and FindClosestVertex.
+  void testFindClosestVertex();
+
+  void testFindVerticesInRadius();
+
+  void testDeadAxes();
+
+  /// Moves vertices and compares queries of the updated tree to brute force.
+  void testUpdate();
+};
+
+}}} // namespace precice, query, tests
+
+#endif /* PRECICE_QUERY_KDTREETEST_HPP_ */
@@ -327,6 +327,18 @@ MasterSlave::allreduceSum(int& sendData, int& rcvData, int size) {
   }
 }
 
+void
+MasterSlave::allreduceSum(std::vector<double>& values) {
+  preciceTrace1("allreduceSum(std::vector<double>)", values.size());
+
+  if (not _masterMode && not _slaveMode) {
+    return;
+  }
+
+  std::vector<double> localValues(values);
+  allreduceSum(localValues.data(), values.data(), values.size());
+}
+
 void
 MasterSlave::broadcast(bool& value) {
   preciceTrace("broadcast(bool&)");
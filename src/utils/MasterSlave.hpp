@@ -6,6 +6,8 @@
 
 #include "tarch/logging/Log.h"
 
+#include <vector>
+
 namespace precice {
 namespace utils {
 
@@ -68,6 +70,14 @@ public:
 
   static void allreduceSum(int& sendData, int& rcvData, int size);
 
+  /**
+   * @brief Sums up several local values over all ranks, in place.
+   *
+   * One collective operation replaces the round trips of reducing each value
+   * separately, e.g. for several dot products or norms at once.
+   */
+  static void allreduceSum(std::vector<double>& values);
+
   static void broadcast(bool& value);
 
   static void broadcast(double& value);
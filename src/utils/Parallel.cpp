@@ -252,6 +252,12 @@ const Parallel::Communicator& Parallel:: getLocalCommunicator()
   return _localCommunicator;
 }
 
+const Parallel::Communicator& Parallel:: getGroupCommunicator()
+{
+  preciceTrace ( "getGroupCommunicator()" );
+  return _isSplit ? _localCommunicator : _globalCommunicator;
+}
+
 Parallel::Communicator Parallel:: getRestrictedCommunicator
 (
   const std::vector<int>& ranks )
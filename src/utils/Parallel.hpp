@@ -111,6 +111,12 @@ public:
    */
   static const Communicator& getLocalCommunicator();
 
+  /**
+   * @brief Returns the local communicator, if groups have been split, else the
+   *        global one.
+   */
+  static const Communicator& getGroupCommunicator();
+
   /**
    * @brief Returns a communicator with a subset of processes.
    *
@@ -111,6 +111,14 @@ public:
      return *_content.back();
    }
 
+   /**
+    * @brief Reserves storage for at least capacity pointers.
+    */
+   void reserve ( size_t capacity )
+   {
+      _content.reserve ( capacity );
+   }
+
    /**
     * @brief Adds element to the end of the vector.
     */
@@ -4,12 +4,23 @@
 
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <sstream>
+#include <thread>
 
 namespace precice {
 namespace utils {
 
+namespace {
+
+/// Bounds of the wait between two attempts to open a file not yet published.
+const std::chrono::milliseconds MIN_READ_WAIT(1);
+const std::chrono::milliseconds MAX_READ_WAIT(100);
+
+}
+
 std::string Publisher::_pdp;
 
 Stack<std::string> Publisher::_dps;
@@ -118,11 +129,17 @@ Publisher::Publisher(std::string const& fp) : _fp(buildFilePath(fp)) {
 
 void Publisher::read(std::string& data) const
 {
-  std::ifstream ifs;
+  std::ifstream ifs(filePath(), std::ifstream::in);
+
+  // The wait grows, such that many readers do not flood a shared file system
+  std::chrono::milliseconds wait = MIN_READ_WAIT;
 
-  do {
+  while (not ifs) {
+    std::this_thread::sleep_for(wait);
+    wait = std::min(2 * wait, MAX_READ_WAIT);
+    ifs.clear();
     ifs.open(filePath(), std::ifstream::in);
-  } while (not ifs);
+  }
 
   std::chrono::milliseconds::rep writeTimeStampCount;
 
@@ -73,6 +73,9 @@ public:
 public:
   Publisher(std::string const& fp);
 
+  /**
+   * @brief Reads the published data, waits until the file exists.
+   */
   void read(std::string& data) const;
 
   void write(std::string const& data) const;